@@ -6,6 +6,7 @@ i3_project(PROPOSAL
 # file(GLOB_RECURSE PROPOSAL_SRC_FILES ${PROJECT_SOURCE_DIR}/private/PROPOSAL/*)
 set (PROPOSAL_SRC_FILES
     ${PROJECT_SOURCE_DIR}/private/PROPOSAL/Constants.cxx
+    ${PROJECT_SOURCE_DIR}/private/PROPOSAL/EarthModel.cxx
     ${PROJECT_SOURCE_DIR}/private/PROPOSAL/EnergyCutSettings.cxx
     ${PROJECT_SOURCE_DIR}/private/PROPOSAL/Output.cxx
     ${PROJECT_SOURCE_DIR}/private/PROPOSAL/Propagator.cxx
@@ -55,11 +56,16 @@ set (PROPOSAL_SRC_FILES
     ${PROJECT_SOURCE_DIR}/private/PROPOSAL/decay/ManyBodyPhaseSpace.cxx
     ${PROJECT_SOURCE_DIR}/private/PROPOSAL/decay/StableChannel.cxx
     ${PROJECT_SOURCE_DIR}/private/PROPOSAL/decay/TwoBodyPhaseSpace.cxx
+    ${PROJECT_SOURCE_DIR}/private/PROPOSAL/geometry/BoundingVolumeHierarchy.cxx
     ${PROJECT_SOURCE_DIR}/private/PROPOSAL/geometry/Box.cxx
     ${PROJECT_SOURCE_DIR}/private/PROPOSAL/geometry/Cylinder.cxx
     ${PROJECT_SOURCE_DIR}/private/PROPOSAL/geometry/Geometry.cxx
     ${PROJECT_SOURCE_DIR}/private/PROPOSAL/geometry/GeometryFactory.cxx
+    ${PROJECT_SOURCE_DIR}/private/PROPOSAL/geometry/Mesh.cxx
     ${PROJECT_SOURCE_DIR}/private/PROPOSAL/geometry/Sphere.cxx
+    ${PROJECT_SOURCE_DIR}/private/PROPOSAL/geometry/TraversalPlan.cxx
+    ${PROJECT_SOURCE_DIR}/private/PROPOSAL/math/Cubature.cxx
+    ${PROJECT_SOURCE_DIR}/private/PROPOSAL/math/FastMath.cxx
     ${PROJECT_SOURCE_DIR}/private/PROPOSAL/math/Integral.cxx
     ${PROJECT_SOURCE_DIR}/private/PROPOSAL/math/Interpolant.cxx
     ${PROJECT_SOURCE_DIR}/private/PROPOSAL/math/MathMethods.cxx
@@ -53,6 +53,9 @@ target_include_directories(
     $<INSTALL_INTERFACE:include>
 )
 target_compile_options(PROPOSAL PRIVATE -Wall -Wextra -Wnarrowing -Wpedantic -fdiagnostics-show-option -Wno-format-security)
+# background table building (InterpolationDef::do_async_build)
+find_package(Threads REQUIRED)
+target_link_libraries(PROPOSAL PUBLIC Threads::Threads)
 install(
     TARGETS PROPOSAL
     EXPORT PROPOSALTargets
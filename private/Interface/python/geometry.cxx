@@ -2,6 +2,7 @@
 #include "PROPOSAL/geometry/GeometryFactory.h"
 #include "PROPOSAL/geometry/Box.h"
 #include "PROPOSAL/geometry/Cylinder.h"
+#include "PROPOSAL/geometry/Mesh.h"
 #include "PROPOSAL/geometry/Sphere.h"
 #include "pyBindings.h"
 
@@ -25,7 +26,8 @@ void init_geometry(py::module& m) {
     py::enum_<Geometry_Type>(m_sub, "Shape")
         .value("Sphere", Geometry_Type::SPHERE)
         .value("Box", Geometry_Type::BOX)
-        .value("Cylinder", Geometry_Type::CYLINDER);
+        .value("Cylinder", Geometry_Type::CYLINDER)
+        .value("Mesh", Geometry_Type::MESH);
 
     py::class_<Geometry, std::shared_ptr<Geometry>>(m_sub, "Geometry")
         .def("__str__", &py_print<Geometry>)
@@ -161,4 +163,19 @@ void init_geometry(py::module& m) {
                       R"pbdoc(
                 height of the cylinder
             )pbdoc");
+
+    py::class_<Mesh, std::shared_ptr<Mesh>, Geometry>(m_sub, "Mesh",
+                                                      R"pbdoc(
+                A closed triangle mesh read from an OBJ or STL file.
+                The vertices are given in meter relative to the
+                position of the mesh.
+            )pbdoc")
+        .def(py::init<>())
+        .def(py::init<Vector3D, const std::string&>(),
+             py::arg("position"), py::arg("path"))
+        .def(py::init<const Mesh&>())
+        .def_property_readonly("number_of_triangles", &Mesh::GetNumberOfTriangles,
+                      R"pbdoc(
+                number of triangles of the mesh
+            )pbdoc");
 }
@@ -5,6 +5,7 @@
 #include "PROPOSAL/medium/density_distr/density_homogeneous.h"
 #include "PROPOSAL/medium/density_distr/density_polynomial.h"
 #include "PROPOSAL/medium/density_distr/density_splines.h"
+#include "PROPOSAL/medium/density_distr/density_voxel.h"
 #include "pyBindings.h"
 
 #define MEDIUM_DEF(module, cls)                                 \
@@ -41,9 +42,9 @@ void init_medium(py::module& m) {
             Split densities are faster than multiple sectors and are therefore
             recommended when using different density profiles.
 
-            +---------------------+--------------------+-----------------+
-            | Density_exponential | Density_polynomial | Density_splines |
-            +---------------------+--------------------+-----------------+
+            +---------------------+--------------------+-----------------+---------------+
+            | Density_exponential | Density_polynomial | Density_splines | Density_voxel |
+            +---------------------+--------------------+-----------------+---------------+
 
             There is currently an issue in the calculation of the LPM effect.
             The calculation of the LPM effect depends on the
@@ -227,13 +228,35 @@ void init_medium(py::module& m) {
     py::class_<Density_polynomial, Density_distr,
                std::shared_ptr<Density_polynomial>>(m_sub, "density_polynomial")
         .def(py::init<const Axis&, const Polynom&>(), py::arg("density_axis"),
-             py::arg("polynom"));
+             py::arg("polynom"))
+        .def(py::init<const Axis&, const Polynom&, double, double>(),
+             py::arg("density_axis"), py::arg("polynom"), py::arg("depth_min"),
+             py::arg("depth_max"));
 
     py::class_<Density_splines, Density_distr,
                std::shared_ptr<Density_splines>>(m_sub, "density_splines")
         .def(py::init<const Axis&, const Spline&>(), py::arg("density_axis"),
              py::arg("splines"));
 
+    py::class_<Density_voxel, Density_distr,
+               std::shared_ptr<Density_voxel>>(m_sub, "density_voxel")
+        .def(py::init<const Vector3D&, const Vector3D&,
+                      const std::array<unsigned int, 3>&,
+                      const std::vector<double>&, double>(),
+             py::arg("origin"), py::arg("voxel_size"), py::arg("voxel_number"),
+             py::arg("densities"), py::arg("outside") = 1.0,
+             R"pbdoc(
+                Density correction factors on a regular voxel grid, the x
+                index of the densities runs fastest.
+
+                Parameters:
+                    origin (Vector3D): corner of the grid in cm
+                    voxel_size (Vector3D): edge lengths of a voxel in cm
+                    voxel_number (list): number of voxels along x, y and z
+                    densities (list): density correction of each voxel
+                    outside (float): density correction outside of the grid
+            )pbdoc");
+
     py::class_<Axis, std::shared_ptr<Axis>>(m_sub, "Density_axis")
         .def_property_readonly("fAxis", &Axis::GetAxis)
         .def_property_readonly("refernce_point", &Axis::GetFp0)
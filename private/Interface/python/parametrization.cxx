@@ -85,6 +85,11 @@ using namespace PROPOSAL;
 void init_parametrization(py::module& m) {
     py::module m_sub = m.def_submodule("parametrization");
 
+    py::enum_<Integral::Quadrature>(m_sub, "Quadrature")
+        .value("Romberg", Integral::Romberg)
+        .value("GaussKronrod", Integral::GaussKronrod)
+        .value("Cubature", Integral::Cubature);
+
     // py::class_<Parametrization::IntegralLimits,
     // std::shared_ptr<Parametrization::IntegralLimits>>("IntegralLimits")
     py::class_<Parametrization::IntegralLimits,
@@ -117,7 +122,9 @@ void init_parametrization(py::module& m) {
             )pbdoc")
         .def("__str__", &py_print<Parametrization>)
         .def("differential_crosssection",
-             &Parametrization::DifferentialCrossSection, py::arg("energy"),
+             static_cast<double (Parametrization::*)(double, double)>(
+                 &Parametrization::DifferentialCrossSection),
+             py::arg("energy"),
              py::arg("v"),
              R"pbdoc(
             Calculate the value 
@@ -137,7 +144,8 @@ void init_parametrization(py::module& m) {
                 differential_crosssection (float): returns the differential crosssection in v
 
                 )pbdoc")
-        .def("dEdx_integrand", &Parametrization::FunctionToDEdxIntegral,
+        .def("dEdx_integrand", static_cast<double (Parametrization::*)(double, double)>(
+                 &Parametrization::FunctionToDEdxIntegral),
              py::arg("energy"), py::arg("v"),
              R"pbdoc(
             Calculate the value 
@@ -159,7 +167,8 @@ void init_parametrization(py::module& m) {
             PROPOSAL uses this function internally, for example to calcuate :math:`\langle\frac{dE}{dx}\rangle`
 
                 )pbdoc")
-        .def("dE2dx_integrand", &Parametrization::FunctionToDE2dxIntegral,
+        .def("dE2dx_integrand", static_cast<double (Parametrization::*)(double, double)>(
+                 &Parametrization::FunctionToDE2dxIntegral),
              py::arg("energy"), py::arg("v"),
              R"pbdoc(
             Calculate the value 
@@ -181,7 +190,8 @@ void init_parametrization(py::module& m) {
             PROPOSAL uses this function internally, for example in the calculation of the countinous randomization. 
 
                 )pbdoc")
-        .def("dNdx_integrand", &Parametrization::FunctionToDNdxIntegral,
+        .def("dNdx_integrand", static_cast<double (Parametrization::*)(double, double)>(
+                 &Parametrization::FunctionToDNdxIntegral),
              py::arg("energy"), py::arg("v"),
              R"pbdoc(
             Calculate the value 
@@ -239,6 +249,12 @@ void init_parametrization(py::module& m) {
 
             Get multiplier used for the parametrization
 
+                )pbdoc")
+        .def_property_readonly("quadrature", &Parametrization::GetQuadrature,
+                               R"pbdoc(
+
+            Get the quadrature used for the integrals of the parametrization
+
                 )pbdoc")
         .def_property_readonly("hash", &Parametrization::GetHash,
                                R"pbdoc( 
@@ -344,7 +360,9 @@ void init_parametrization(py::module& m) {
         .def_readwrite("lpm_effect",
                        &BremsstrahlungFactory::Definition::lpm_effect)
         .def_readwrite("multiplier",
-                       &BremsstrahlungFactory::Definition::multiplier);
+                       &BremsstrahlungFactory::Definition::multiplier)
+        .def_readwrite("quadrature",
+                       &BremsstrahlungFactory::Definition::quadrature);
 
     // ---------------------------------------------------------------------
     // // Epair
@@ -392,7 +410,8 @@ void init_parametrization(py::module& m) {
                std::shared_ptr<EpairProductionRhoIntegral>, EpairProduction>(
         m_sub_epair, "EpairProductionRhoIntegral")
         .def("function_to_integral",
-             &EpairProductionRhoIntegral::FunctionToIntegral);
+             static_cast<double (EpairProductionRhoIntegral::*)(double, double, double)>(
+                 &EpairProductionRhoIntegral::FunctionToIntegral));
 
     EPAIR_DEF(m_sub_epair, KelnerKokoulinPetrukhin)
     EPAIR_DEF(m_sub_epair, SandrockSoedingreksoRhode)
@@ -444,7 +463,9 @@ void init_parametrization(py::module& m) {
         .def_readwrite("lpm_effect",
                        &EpairProductionFactory::Definition::lpm_effect)
         .def_readwrite("multiplier",
-                       &EpairProductionFactory::Definition::multiplier);
+                       &EpairProductionFactory::Definition::multiplier)
+        .def_readwrite("quadrature",
+                       &EpairProductionFactory::Definition::quadrature);
 
     // --------------------------------------------------------------------- //
     // Annihilation
@@ -499,7 +520,8 @@ void init_parametrization(py::module& m) {
     py::class_<AnnihilationFactory::Definition, std::shared_ptr<AnnihilationFactory::Definition> >(m_sub_annihilation, "AnnihilationDefinition")
             .def(py::init<>())
             .def_readwrite("parametrization", &AnnihilationFactory::Definition::parametrization)
-            .def_readwrite("multiplier", &AnnihilationFactory::Definition::multiplier);
+            .def_readwrite("multiplier", &AnnihilationFactory::Definition::multiplier)
+            .def_readwrite("quadrature", &AnnihilationFactory::Definition::quadrature);
 
 
     // ---------------------------------------------------------------------
@@ -599,6 +621,8 @@ void init_parametrization(py::module& m) {
                        &MupairProductionFactory::Definition::parametrization)
         .def_readwrite("multiplier",
                        &MupairProductionFactory::Definition::multiplier)
+        .def_readwrite("quadrature",
+                       &MupairProductionFactory::Definition::quadrature)
         .def_readwrite("particle_output",
                        &MupairProductionFactory::Definition::particle_output);
 
@@ -661,7 +685,9 @@ void init_parametrization(py::module& m) {
         .def_readwrite("parametrization",
                        &WeakInteractionFactory::Definition::parametrization)
         .def_readwrite("multiplier",
-                       &WeakInteractionFactory::Definition::multiplier);
+                       &WeakInteractionFactory::Definition::multiplier)
+        .def_readwrite("quadrature",
+                       &WeakInteractionFactory::Definition::quadrature);
 
     // ---------------------------------------------------------------------
     // // Photo
@@ -879,7 +905,9 @@ void init_parametrization(py::module& m) {
         .def_readwrite("hard_component",
                        &PhotonuclearFactory::Definition::hard_component)
         .def_readwrite("multiplier",
-                       &PhotonuclearFactory::Definition::multiplier);
+                       &PhotonuclearFactory::Definition::multiplier)
+        .def_readwrite("quadrature",
+                       &PhotonuclearFactory::Definition::quadrature);
 
     // --------------------------------------------------------------------- //
     // Ionization
@@ -955,7 +983,8 @@ void init_parametrization(py::module& m) {
     py::class_<IonizationFactory::Definition, std::shared_ptr<IonizationFactory::Definition> >(m_sub_ioniz, "IonizationDefinition")
         .def(py::init<>())
         .def_readwrite("parametrization", &IonizationFactory::Definition::parametrization)
-        .def_readwrite("multiplier", &IonizationFactory::Definition::multiplier);
+        .def_readwrite("multiplier", &IonizationFactory::Definition::multiplier)
+        .def_readwrite("quadrature", &IonizationFactory::Definition::quadrature);
 
     // Photon interactions
 
@@ -1013,7 +1042,8 @@ void init_parametrization(py::module& m) {
     py::class_<ComptonFactory::Definition, std::shared_ptr<ComptonFactory::Definition> >(m_sub_compton, "ComptonDefinition")
             .def(py::init<>())
             .def_readwrite("parametrization", &ComptonFactory::Definition::parametrization)
-            .def_readwrite("multiplier", &ComptonFactory::Definition::multiplier);
+            .def_readwrite("multiplier", &ComptonFactory::Definition::multiplier)
+            .def_readwrite("quadrature", &ComptonFactory::Definition::quadrature);
 
     // --------------------------------------------------------------------- //
     // PhotoPairProduction
@@ -1065,7 +1095,8 @@ void init_parametrization(py::module& m) {
             .def(py::init<>())
             .def_readwrite("parametrization", &PhotoPairFactory::Definition::parametrization)
             .def_readwrite("photoangle", &PhotoPairFactory::Definition::photoangle)
-            .def_readwrite("multiplier", &PhotoPairFactory::Definition::multiplier);
+            .def_readwrite("multiplier", &PhotoPairFactory::Definition::multiplier)
+            .def_readwrite("quadrature", &PhotoPairFactory::Definition::quadrature);
 
     // PhotoAngleDistribution
 
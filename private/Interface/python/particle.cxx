@@ -276,7 +276,8 @@ void init_particle(py::module& m) {
         .def_property_readonly("propagated_distance", &Secondaries::GetPropagatedDistance)
         .def_property_readonly("entry_point", &Secondaries::GetEntryPoint)
         .def_property_readonly("exit_point", &Secondaries::GetExitPoint)
-        .def_property_readonly("closest_approach_point", &Secondaries::GetClosestApproachPoint);
+        .def_property_readonly("closest_approach_point", &Secondaries::GetClosestApproachPoint)
+        .def_property_readonly("ranged_out", &Secondaries::IsRangedOut);
 
     py::enum_<InteractionType>(m_sub, "Interaction_Type")
         .value("Particle", InteractionType::Particle)
@@ -160,6 +160,13 @@ PYBIND11_MODULE(proposal, m)
                 maximum energy that will be interpolated. Energies greater
                 than the value are extrapolated. Default: 1e14 MeV
             )pbdoc")
+        .def_readwrite("extended_max_node_energy",
+            &InterpolationDef::extended_max_node_energy,
+            R"pbdoc(
+                extends the tables built up to max_node_energy to this
+                energy. Only the additional nodes are calculated and stored
+                next to the existing tables. Default: 0 (no extension)
+            )pbdoc")
         .def_readwrite("nodes_cross_section",
             &InterpolationDef::nodes_cross_section,
             R"pbdoc(
@@ -190,6 +197,36 @@ PYBIND11_MODULE(proposal, m)
                 This will stop the program, if the required table is not
                 in the readonly path. The (writable) path_to_tables will be
                 ignored. Default: xxx
+            )pbdoc")
+        .def_readwrite("do_async_build",
+            &InterpolationDef::do_async_build,
+            R"pbdoc(
+                Build the tables in the background. Until they are ready,
+                the sectors propagate with integrals and switch to the
+                interpolants afterwards. Default: False
+            )pbdoc")
+        .def_readwrite("do_cut_independent_dndx",
+            &InterpolationDef::do_cut_independent_dndx,
+            R"pbdoc(
+                Build the dNdx tables independent of the energy cuts, so
+                they are shared between different cut settings.
+                Default: False
+            )pbdoc")
+        .def_readwrite("interpolation_precision",
+            &InterpolationDef::interpolation_precision,
+            R"pbdoc(
+                Relative interpolation error the nodes of the tables are
+                adapted to. The nodes_* values are the maximal numbers of
+                nodes then. Zero uses equidistant nodes. Default: 0
+            )pbdoc")
+        .def_readwrite("storage_precision",
+            &InterpolationDef::storage_precision,
+            R"pbdoc(
+                Relative error the values of the 2d tables may get when they
+                are stored in memory. The rows of the tables are kept in one
+                contiguous array, in single precision if its rounding error
+                stays below this value. Zero keeps the tables as built.
+                Default: 0
             )pbdoc");
 
     // ---------------------------------------------------------------------
@@ -224,7 +261,9 @@ PYBIND11_MODULE(proposal, m)
         .def_readwrite("mupair_def", &Utility::Definition::mupair_def)
         .def_readwrite("weak_def", &Utility::Definition::weak_def)
         .def_readwrite("compton_def", &Utility::Definition::compton_def)
-        .def_readwrite("photopair_def", &Utility::Definition::photopair_def);
+        .def_readwrite("photopair_def", &Utility::Definition::photopair_def)
+        .def_readwrite("integral_cache_size", &Utility::Definition::integral_cache_size)
+        .def_readwrite("integral_cache_tolerance", &Utility::Definition::integral_cache_tolerance);
 
     // --------------------------------------------------------------------- //
     // ContinousRandomization
@@ -572,6 +611,15 @@ PYBIND11_MODULE(proposal, m)
 
                     Returns:
                         Geometry: the geometry of the detector.
+                )pbdoc")
+        .def_property("range_culling", &Propagator::GetRangeCulling, &Propagator::SetRangeCulling,
+            R"pbdoc(
+                    Stop particles, which can not reach the detector any more.
+
+                    The propagation stops, if even the range with continuous
+                    losses only is shorter than the column depth to the
+                    detector or to the end of the current sector. The
+                    secondaries are flagged with ranged_out then.
                 )pbdoc");
 
     // ---------------------------------------------------------------------
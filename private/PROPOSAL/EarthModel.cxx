@@ -0,0 +1,167 @@
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+#include "PROPOSAL/EarthModel.h"
+#include "PROPOSAL/geometry/Sphere.h"
+#include "PROPOSAL/math/Function.h"
+#include "PROPOSAL/medium/Medium.h"
+#include "PROPOSAL/medium/MediumFactory.h"
+#include "PROPOSAL/medium/density_distr/density_polynomial.h"
+
+using namespace PROPOSAL;
+
+bool EarthModel::Layer::operator==(const Layer& layer) const
+{
+    return inner_radius == layer.inner_radius && outer_radius == layer.outer_radius
+        && medium == layer.medium && density == layer.density;
+}
+
+// ------------------------------------------------------------------------- //
+EarthModel::EarthModel(const Vector3D& center, const std::vector<Layer>& layers)
+    : center_(100. * center)
+    , layers_(layers)
+    , hierarchy_(0)
+    , outer_radii_()
+{
+    Init();
+}
+
+EarthModel::EarthModel(const nlohmann::json& config)
+    : center_()
+    , layers_()
+    , hierarchy_(0)
+    , outer_radii_()
+{
+    if(not config.is_object()) throw std::invalid_argument("No json object found.");
+
+    if(not config.contains("origin"))
+        throw std::invalid_argument("No earth model origin found.");
+    center_ = Vector3D(config.at("origin"));
+    hierarchy_ = config.value("hierarchy", 0);
+
+    if (config.contains("layers")) {
+        if(not config.at("layers").is_array())
+            throw std::invalid_argument("Earth model layers are not an array.");
+
+        for (const auto& json_layer : config.at("layers")) {
+            Layer layer;
+            layer.inner_radius = json_layer.value("inner_radius", 0.);
+            if(not json_layer.contains("outer_radius"))
+                throw std::invalid_argument("No outer radius of the earth model layer found.");
+            layer.outer_radius = json_layer.at("outer_radius").get<double>();
+            layer.medium = json_layer.value("medium", "standardrock");
+            if(not json_layer.contains("density"))
+                throw std::invalid_argument("No density of the earth model layer found.");
+            layer.density = json_layer.at("density").get<std::vector<double>>();
+            layers_.push_back(layer);
+        }
+    } else {
+        std::string model = config.value("model", "PREM");
+        std::transform(model.begin(), model.end(), model.begin(),
+            [](unsigned char c){ return std::tolower(c); });
+        if (model != "prem")
+            throw std::invalid_argument("Earth model " + model + " not found.");
+        layers_ = PREM();
+    }
+
+    Init();
+}
+
+// ------------------------------------------------------------------------- //
+void EarthModel::Init()
+{
+    if (layers_.empty())
+        throw std::invalid_argument("Earth model has no layers.");
+
+    // the shells have to cover the model from the inside out without gaps,
+    // so that every point of the model lies in exactly one of the sectors
+    for (unsigned int i = 0; i < layers_.size(); ++i) {
+        if (!(layers_[i].inner_radius >= 0 && layers_[i].inner_radius < layers_[i].outer_radius))
+            throw std::invalid_argument("Earth model layer radii are invalid.");
+        if (i > 0 && layers_[i].inner_radius != layers_[i - 1].outer_radius)
+            throw std::invalid_argument("Earth model layers must be adjacent and ascending.");
+        if (layers_[i].density.empty())
+            throw std::invalid_argument("Earth model layer has no density.");
+
+        outer_radii_.push_back(100. * layers_[i].outer_radius);
+    }
+
+    center_.CalculateSphericalCoordinates();
+}
+
+// ------------------------------------------------------------------------- //
+bool EarthModel::operator==(const EarthModel& earth_model) const
+{
+    return center_ == earth_model.center_ && layers_ == earth_model.layers_
+        && hierarchy_ == earth_model.hierarchy_;
+}
+
+bool EarthModel::operator!=(const EarthModel& earth_model) const
+{
+    return !(*this == earth_model);
+}
+
+// ------------------------------------------------------------------------- //
+std::vector<EarthModel::Layer> EarthModel::PREM()
+{
+    // radii in km, density polynomials in x = r / 6371 km
+    std::vector<Layer> layers = {
+        { 0., 1221.5, "iron", { 13.0885, 0., -8.8381 } },
+        { 1221.5, 3480., "iron", { 12.5815, -1.2638, -3.6426, -5.5281 } },
+        { 3480., 5701., "standardrock", { 7.9565, -6.4761, 5.5283, -3.0807 } },
+        { 5701., 5771., "standardrock", { 5.3197, -1.4836 } },
+        { 5771., 5971., "standardrock", { 11.2494, -8.0298 } },
+        { 5971., 6151., "standardrock", { 7.1089, -3.8045 } },
+        { 6151., 6346.6, "standardrock", { 2.6910, 0.6924 } },
+        { 6346.6, 6356., "standardrock", { 2.900 } },
+        { 6356., 6368., "standardrock", { 2.600 } },
+        { 6368., 6371., "water", { 1.020 } },
+    };
+
+    for (auto& layer : layers) {
+        layer.inner_radius *= 1e3;
+        layer.outer_radius *= 1e3;
+    }
+
+    return layers;
+}
+
+// ------------------------------------------------------------------------- //
+std::vector<Sector::Definition> EarthModel::CreateSectorDefinitions(const Sector::Definition& sector_def) const
+{
+    std::vector<Sector::Definition> definitions;
+
+    for (unsigned int i = 0; i < layers_.size(); ++i) {
+        nlohmann::json geometry_config = {
+            { "shape", "sphere" },
+            { "origin", { 1e-2 * center_.GetX(), 1e-2 * center_.GetY(), 1e-2 * center_.GetZ() } },
+            { "outer_radius", layers_[i].outer_radius },
+            { "inner_radius", layers_[i].inner_radius },
+            { "hierarchy", hierarchy_ },
+        };
+
+        std::shared_ptr<Medium> medium = CreateMedium(layers_[i].medium, 1.0);
+
+        // the density distribution scales the density of the medium, the
+        // polynomial is converted from r / R to r in cm
+        std::vector<double> coefficients;
+        double scale = 1. / medium->GetMassDensity();
+        for (auto coefficient : layers_[i].density) {
+            coefficients.push_back(coefficient * scale);
+            scale /= outer_radii_.back();
+        }
+
+        Density_polynomial density(RadialAxis(Vector3D(0, 0, 1), center_), Polynom(coefficients),
+            100. * layers_[i].inner_radius, outer_radii_[i]);
+        medium->SetDensityDistribution(density);
+
+        Sector::Definition definition(sector_def);
+        definition.SetMedium(medium);
+        definition.SetGeometry(std::make_shared<const Sphere>(geometry_config));
+        definitions.push_back(definition);
+    }
+
+    return definitions;
+}
@@ -4,18 +4,22 @@
  * Author: koehne
  */
 
-// #include <cmath>
-
+#include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <limits>
 #include <memory>
 
+#include "PROPOSAL/EarthModel.h"
 #include "PROPOSAL/Propagator.h"
 #include "PROPOSAL/medium/Medium.h"
 #include "PROPOSAL/medium/MediumFactory.h"
+#include "PROPOSAL/medium/density_distr/density_distr.h"
 
 #include "PROPOSAL/geometry/Box.h"
 #include "PROPOSAL/geometry/Cylinder.h"
 #include "PROPOSAL/geometry/GeometryFactory.h"
+#include "PROPOSAL/geometry/Mesh.h"
 #include "PROPOSAL/geometry/Sphere.h"
 
 #include "PROPOSAL/particle/Particle.h"
@@ -69,6 +73,8 @@ Propagator::Propagator(
     }
 
     current_sector_ = sectors_.at(0);
+
+    BuildTraversalPlan();
 } catch (const std::out_of_range& ex) {
     log_fatal("No Sectors are provided for the Propagator!");
 }
@@ -89,6 +95,8 @@ Propagator::Propagator(const ParticleDef& particle_def,
     } catch (const std::out_of_range& ex) {
         log_fatal("No Sectors are provided for the Propagator!");
     }
+
+    BuildTraversalPlan();
 }
 
 // ------------------------------------------------------------------------- //
@@ -97,6 +105,7 @@ Propagator::Propagator(const ParticleDef& particle_def,
     std::shared_ptr<const Geometry> geometry, const InterpolationDef& interpolation_def)
     : particle_def_(particle_def)
     , detector_(geometry)
+    , interpolation_def_(interpolation_def)
 {
     for (auto def : sector_defs) {
         sectors_.push_back(new Sector(particle_def, def, interpolation_def));
@@ -107,14 +116,18 @@ Propagator::Propagator(const ParticleDef& particle_def,
     } catch (const std::out_of_range& ex) {
         log_fatal("No Sectors are provided for the Propagator!");
     }
+
+    BuildTraversalPlan();
 }
 
 // ------------------------------------------------------------------------- //
 Propagator::Propagator(const Propagator& propagator)
     : sectors_(propagator.sectors_.size(), NULL)
     , current_sector_(NULL)
+    , traversal_plan_()
     , particle_def_(propagator.particle_def_)
     , detector_(propagator.detector_)
+    , interpolation_def_(propagator.interpolation_def_)
 {
     for (unsigned int i = 0; i < propagator.sectors_.size(); ++i) {
         sectors_[i] = new Sector(*propagator.sectors_[i]);
@@ -123,6 +136,12 @@ Propagator::Propagator(const Propagator& propagator)
             current_sector_ = sectors_[i];
         }
     }
+
+    BuildTraversalPlan();
+
+    range_tables_ = propagator.range_tables_;
+    range_log_energy_min_ = propagator.range_log_energy_min_;
+    range_log_energy_step_ = propagator.range_log_energy_step_;
 }
 
 // ------------------------------------------------------------------------- //
@@ -177,6 +196,8 @@ Propagator::Propagator(
             detector_ = std::make_shared<const Box>(json_config["detector"]);
         } else if (shape == "cylinder") {
             detector_ = std::make_shared<const Cylinder>(json_config["detector"]);
+        } else if (shape == "mesh") {
+            detector_ = std::make_shared<const Mesh>(json_config["detector"]);
         } else {
             throw std::invalid_argument("You need to specify a detector for each sector");
         }
@@ -198,43 +219,63 @@ Propagator::Propagator(
         if (json_config.contains("sectors")) {
             assert(json_config["sectors"].is_array());
             for (const auto& json_sector : json_config.at("sectors")) {
-                double density_correction = json_sector.value("density_correction", 1.0);
-                std::string medium_name = json_sector.value("medium","water");
-                med = CreateMedium(medium_name, density_correction);
-                if (json_sector.contains("geometry"))
+                Sector::Definition sec_def = *sec_def_global;
+
+                if(json_sector.contains(cut.first))
                 {
-                    std::string shape = json_sector["geometry"]["shape"];
-                    if (shape == "sphere") {
-                        geo = std::make_shared<const Sphere>(json_sector["geometry"]);
-                    } else if (shape == "box") {
-                        geo = std::make_shared<const Box>(json_sector["geometry"]);
-                    } else if (shape == "cylinder") {
-                        geo = std::make_shared<const Cylinder>(json_sector["geometry"]);
-                    } else {
-                        throw std::invalid_argument("You need to specify a detector for each sector");
+                    nlohmann::json local_cuts = json_sector[cut.first];
+                    sec_def.cut_settings = EnergyCutSettings(local_cuts);
+                    if(local_cuts.contains("cont_rand")) {
+                        sec_def.do_continuous_randomization = local_cuts.value("cont_rand", true);
                     }
                 }
 
-                    Sector::Definition sec_def = *sec_def_global;
-                    sec_def.SetMedium(med);
-                    sec_def.SetGeometry(geo);
-
-                    if(json_sector.contains(cut.first))
+                // a layered earth model expands into one sector per shell
+                std::vector<Sector::Definition> sec_defs;
+                if (json_sector.contains("earth_model")) {
+                    sec_defs = EarthModel(json_sector["earth_model"]).CreateSectorDefinitions(sec_def);
+                } else {
+                    double density_correction = json_sector.value("density_correction", 1.0);
+                    std::string medium_name = json_sector.value("medium","water");
+                    med = CreateMedium(medium_name, density_correction);
+                    if (json_sector.contains("geometry"))
                     {
-                        nlohmann::json local_cuts = json_sector[cut.first];
-                        sec_def.cut_settings = EnergyCutSettings(local_cuts);
-                        if(local_cuts.contains("cont_rand")) {
-                            sec_def.do_continuous_randomization = local_cuts.value("cont_rand", true);
+                        std::string shape = json_sector["geometry"]["shape"];
+                        if (shape == "sphere") {
+                            geo = std::make_shared<const Sphere>(json_sector["geometry"]);
+                        } else if (shape == "box") {
+                            geo = std::make_shared<const Box>(json_sector["geometry"]);
+                        } else if (shape == "cylinder") {
+                            geo = std::make_shared<const Cylinder>(json_sector["geometry"]);
+                        } else if (shape == "mesh") {
+                            geo = std::make_shared<const Mesh>(json_sector["geometry"]);
+                        } else {
+                            throw std::invalid_argument("You need to specify a detector for each sector");
                         }
                     }
 
+                    sec_def.SetMedium(med);
+                    sec_def.SetGeometry(geo);
+                    sec_defs.push_back(sec_def);
+                }
+
+                for (const auto& def : sec_defs) {
                     if (do_interpolation) {
-                        sectors_.push_back(new Sector(particle_def_, sec_def, interpolation_def));
+                        sectors_.push_back(new Sector(particle_def_, def, interpolation_def));
                     } else {
-                        sectors_.push_back(new Sector(particle_def_, sec_def));
+                        sectors_.push_back(new Sector(particle_def_, def));
                     }
                 }
             }
+        }
+    }
+
+    BuildTraversalPlan();
+
+    interpolation_def_ = interpolation_def;
+
+    if (json_global.value("range_culling", false)) {
+        BuildRangeTables();
     }
 }
 
@@ -309,12 +350,18 @@ Secondaries Propagator::Propagate(
     Vector3D position(initial_condition.GetPosition());
     Vector3D direction(initial_condition.GetDirection());
 
+    // The detector is the last geometry of the traversal plan. The plan
+    // follows the particle along its track, ChooseCurrentSector moves it to
+    // the current position.
+    const unsigned int detector_index = sectors_.size();
+
+    traversal_plan_.Update(position, direction);
+
     /* bool starts_in_detector = detector_->IsInside( initial_condition.GetPosition(), initial_condition.GetDirection()); */
-    bool starts_in_detector = detector_->IsInside( position, direction);
+    bool starts_in_detector = traversal_plan_.IsInside(detector_index);
     if (starts_in_detector) {
         secondaries_.SetEntryPoint(initial_condition);
-        distance_to_closest_approach = detector_->DistanceToClosestApproach(
-            initial_condition.GetPosition(), initial_condition.GetDirection());
+        distance_to_closest_approach = traversal_plan_.DistanceToClosestApproach(detector_index);
         if (distance_to_closest_approach < 0) {
             secondaries_.SetClosestApproachPoint(initial_condition);
         }
@@ -341,8 +388,7 @@ Secondaries Propagator::Propagate(
             p_condition->GetPosition(), p_condition->GetDirection());
 
         if (already_reached_closest_approach == false) {
-            distance_to_closest_approach = detector_->DistanceToClosestApproach(
-                p_condition->GetPosition(), p_condition->GetDirection());
+            distance_to_closest_approach = traversal_plan_.DistanceToClosestApproach(detector_index);
             if (distance_to_closest_approach > 0) {
                 if (distance_to_closest_approach < distance) {
                     already_reached_closest_approach = true;
@@ -358,8 +404,7 @@ Secondaries Propagator::Propagate(
             }
         }
 
-        is_in_detector = detector_->IsInside(
-            p_condition->GetPosition(), p_condition->GetDirection());
+        is_in_detector = traversal_plan_.IsInside(detector_index);
         // entry point of the detector
         if (!starts_in_detector && !was_in_detector && is_in_detector) {
             secondaries_.SetEntryPoint(*p_condition);
@@ -384,6 +429,22 @@ Secondaries Propagator::Propagate(
             // starts_in_detector to false
             starts_in_detector = false;
         }
+
+        // The particle has to pass at least the column depth up to the
+        // detector or the end of the current sector to reach the detector.
+        if (!range_tables_.empty() && !is_in_detector
+            && traversal_plan_.DistanceToBorder(detector_index).first > 0) {
+            unsigned int current_index = std::find(sectors_.begin(), sectors_.end(), current_sector_) - sectors_.begin();
+            double column_depth = current_sector_->GetSectorDef().GetMedium()->GetDensityDistribution().Calculate(
+                p_condition->GetPosition(), p_condition->GetDirection(), distance);
+
+            if (MaximalRange(current_index, p_condition->GetEnergy()) < column_depth) {
+                log_debug("particle can not reach the detector any more");
+                secondaries_.SetRangedOut(true);
+                break;
+            }
+        }
+
         if (max_distance <= p_condition->GetPropagatedDistance() + distance) {
             distance = max_distance - p_condition->GetPropagatedDistance();
         }
@@ -407,8 +468,8 @@ Secondaries Propagator::Propagate(
             || p_condition->GetType() == static_cast<int>(InteractionType::Decay))
             break;
     }
-    if (detector_->IsInside(
-            p_condition->GetPosition(), p_condition->GetDirection())) {
+    traversal_plan_.Update(p_condition->GetPosition(), p_condition->GetDirection());
+    if (traversal_plan_.IsInside(detector_index)) {
         secondaries_.SetExitPoint(*p_condition);
     }
 
@@ -430,11 +491,14 @@ void Propagator::ChooseCurrentSector(
 {
     std::vector<int> crossed_sector;
 
+    traversal_plan_.Update(particle_position, particle_direction);
+
     // Get Location of the detector (Inside/Infront/Behind)
     Geometry::ParticleLocation::Enum detector_location
-        = detector_->GetLocation(particle_position, particle_direction);
+        = traversal_plan_.GetLocation(sectors_.size());
+
     for (unsigned int i = 0; i < sectors_.size(); ++i) {
-        if (sectors_[i]->GetSectorDef().GetGeometry()->IsInside(particle_position, particle_direction)) {
+        if (traversal_plan_.IsInside(i)) {
             if (static_cast<int>(sectors_[i]->GetLocation()) == static_cast<int>(detector_location))
                 crossed_sector.push_back(i);
         }
@@ -485,42 +549,40 @@ void Propagator::ChooseCurrentSector(
 double Propagator::CalculateEffectiveDistance(
     const Vector3D& particle_position, const Vector3D& particle_direction)
 {
-    double distance_to_sector_border = 0;
-    double distance_to_detector = 0;
+    traversal_plan_.Update(particle_position, particle_direction);
 
-    distance_to_sector_border
-        = current_sector_->GetSectorDef().GetGeometry()
-              ->DistanceToBorder(particle_position, particle_direction)
-              .first;
-    double tmp_distance_to_border;
+    unsigned int current_index = std::find(sectors_.begin(), sectors_.end(), current_sector_) - sectors_.begin();
+
+    double distance_to_sector_border = traversal_plan_.DistanceToBorder(current_index).first;
+    double distance_to_detector = 0;
 
     Geometry::ParticleLocation::Enum detector_location
-        = detector_->GetLocation(particle_position, particle_direction);
-
-    for (std::vector<Sector*>::iterator iter = sectors_.begin();
-         iter != sectors_.end(); ++iter) {
-
-        if (static_cast<int>((*iter)->GetLocation())
-            == static_cast<int>(detector_location)) {
-            if ((*iter)->GetSectorDef().GetGeometry()->GetHierarchy()
-                >= current_sector_->GetSectorDef().GetGeometry()->GetHierarchy()) {
-                tmp_distance_to_border
-                    = (*iter)
-                          ->GetSectorDef().GetGeometry()
-                          ->DistanceToBorder(
-                              particle_position, particle_direction)
-                          .first;
-                if (tmp_distance_to_border <= 0)
-                    continue;
-                distance_to_sector_border = std::min(
-                    tmp_distance_to_border, distance_to_sector_border);
+        = traversal_plan_.GetLocation(sectors_.size());
+
+    // The upcoming borders are sorted, so the first one of a sector which
+    // can take over is the closest.
+    if (distance_to_sector_border > 0) {
+        for (auto i : traversal_plan_.GetUpcomingBorders()) {
+            double tmp_distance_to_border = traversal_plan_.DistanceToBorder(i).first;
+
+            if (tmp_distance_to_border >= distance_to_sector_border)
+                break;
+
+            if (i == sectors_.size())
+                continue;
+
+            if (static_cast<int>(sectors_[i]->GetLocation())
+                == static_cast<int>(detector_location)) {
+                if (sectors_[i]->GetSectorDef().GetGeometry()->GetHierarchy()
+                    >= current_sector_->GetSectorDef().GetGeometry()->GetHierarchy()) {
+                    distance_to_sector_border = tmp_distance_to_border;
+                    break;
+                }
             }
         }
     }
 
-    distance_to_detector
-        = detector_->DistanceToBorder(particle_position, particle_direction)
-              .first;
+    distance_to_detector = traversal_plan_.DistanceToBorder(sectors_.size()).first;
 
     if (distance_to_detector > 0) {
         return std::min(distance_to_detector, distance_to_sector_border);
@@ -528,3 +590,76 @@ double Propagator::CalculateEffectiveDistance(
         return distance_to_sector_border;
     }
 }
+
+// ------------------------------------------------------------------------- //
+void Propagator::SetRangeCulling(bool range_culling)
+{
+    if (range_culling) {
+        BuildRangeTables();
+    } else {
+        range_tables_.clear();
+    }
+}
+
+// ------------------------------------------------------------------------- //
+void Propagator::BuildTraversalPlan()
+{
+    std::vector<std::shared_ptr<const Geometry>> geometries;
+
+    for (auto sector : sectors_) {
+        geometries.push_back(sector->GetSectorDef().GetGeometry());
+    }
+    geometries.push_back(detector_);
+
+    traversal_plan_ = TraversalPlan(geometries);
+}
+
+// ------------------------------------------------------------------------- //
+void Propagator::BuildRangeTables()
+{
+    const unsigned int number_of_nodes = interpolation_def_.nodes_propagate;
+    const double energy_min = std::max(particle_def_.low, particle_def_.mass);
+    const double energy_max = interpolation_def_.max_node_energy;
+
+    range_log_energy_min_ = std::log(energy_min);
+    range_log_energy_step_ = (std::log(energy_max) - range_log_energy_min_) / (number_of_nodes - 1);
+
+    range_tables_.clear();
+    for (auto sector : sectors_) {
+        // the randomized continuous losses can be smaller than their mean,
+        // so the mean range is no upper bound there
+        if (sector->GetSectorDef().do_continuous_randomization) {
+            range_tables_.push_back(std::vector<double>());
+            continue;
+        }
+
+        // the ranges are summed up from node to node, so that every integral
+        // only covers a small energy interval
+        std::vector<double> ranges(number_of_nodes, 0.);
+        double energy = energy_min;
+
+        for (unsigned int i = 1; i < number_of_nodes; ++i) {
+            double next_energy = std::exp(range_log_energy_min_ + i * range_log_energy_step_);
+            ranges[i] = ranges[i - 1] + sector->ContinuousDisplacement(next_energy, energy);
+            energy = next_energy;
+        }
+
+        range_tables_.push_back(ranges);
+    }
+}
+
+// ------------------------------------------------------------------------- //
+double Propagator::MaximalRange(unsigned int sector, double energy) const
+{
+    if (range_tables_[sector].empty())
+        return std::numeric_limits<double>::infinity();
+
+    double node = std::ceil((std::log(energy) - range_log_energy_min_) / range_log_energy_step_);
+
+    if (node <= 0)
+        return 0;
+    if (node >= range_tables_[sector].size())
+        return std::numeric_limits<double>::infinity();
+
+    return range_tables_[sector][static_cast<unsigned int>(node)];
+}
@@ -11,10 +11,12 @@ using namespace PROPOSAL;
 
 Secondaries::Secondaries()
     : primary_def_(nullptr)
+    , ranged_out_(false)
 {
 }
 
 Secondaries::Secondaries(std::shared_ptr<ParticleDef> p_def)
+    : ranged_out_(false)
 {
     primary_def_ = p_def;
 }
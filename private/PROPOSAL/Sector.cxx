@@ -7,6 +7,7 @@
 #include "PROPOSAL/decay/DecayChannel.h"
 
 #include "PROPOSAL/medium/density_distr/density_distr.h"
+#include "PROPOSAL/medium/density_distr/density_homogeneous.h"
 
 #include "PROPOSAL/particle/Particle.h"
 
@@ -225,8 +226,8 @@ std::ostream& operator<<(std::ostream& os, Sector const& sector)
 
     os << "Sector Definition:\n" << sector.sector_def_ << std::endl;
     os << "Particle Definition:\n" << sector.particle_def_ << std::endl;
-    os << "Propagation Utility:\n" << sector.utility_ << std::endl;
-    os << "Scattering:\n" << *sector.scattering_ << std::endl;
+    os << "Propagation Utility:\n" << sector.GetUtility() << std::endl;
+    os << "Scattering:\n" << *sector.GetScattering() << std::endl;
 
     os << Helper::Centered(60, "");
     return os;
@@ -238,26 +239,39 @@ std::ostream& operator<<(std::ostream& os, Sector const& sector)
 // Constructors
 // ------------------------------------------------------------------------- //
 
+namespace {
+double HomogeneousDensity(const Sector::Definition& sector_def)
+{
+    const Density_homogeneous* density = dynamic_cast<const Density_homogeneous*>(
+        &sector_def.GetMedium()->GetDensityDistribution());
+    return density ? density->GetCorrectionfactor() : 0.;
+}
+} // namespace
+
+
 Sector::Sector(const ParticleDef& particle_def, const Definition& sector_def)
     : sector_def_(sector_def)
     , particle_def_(particle_def)
-    , utility_(particle_def, sector_def.GetMedium(), sector_def.cut_settings,
-          sector_def.utility_def)
-    , displacement_calculator_(new UtilityIntegralDisplacement(utility_))
-    , interaction_calculator_(new UtilityIntegralInteraction(utility_))
-    , decay_calculator_(new UtilityIntegralDecay(utility_))
+    , homogeneous_density_(HomogeneousDensity(sector_def))
+    , utility_(std::make_shared<Utility>(particle_def, sector_def.GetMedium(),
+          sector_def.cut_settings, sector_def.utility_def))
+    , displacement_calculator_(new UtilityIntegralDisplacement(*utility_))
+    , interaction_calculator_(new UtilityIntegralInteraction(*utility_))
+    , decay_calculator_(new UtilityIntegralDecay(*utility_))
     , exact_time_calculator_(NULL)
     , cont_rand_(NULL)
     , scattering_(ScatteringFactory::Get().CreateScattering(
-          sector_def_.scattering_model, particle_def, utility_))
+          sector_def_.scattering_model, particle_def, *utility_))
+    , tables_ready_(true)
+    , abort_table_build_(false)
 {
     // These are optional, therfore check NULL
     if (sector_def_.do_exact_time_calculation) {
-        exact_time_calculator_ = std::make_shared<UtilityIntegralTime>(utility_);
+        exact_time_calculator_ = std::make_shared<UtilityIntegralTime>(*utility_);
     }
 
     if (sector_def_.do_continuous_randomization) {
-        cont_rand_ = std::make_shared<ContinuousRandomizer>(utility_);
+        cont_rand_ = std::make_shared<ContinuousRandomizer>(*utility_);
     }
 }
 
@@ -265,46 +279,99 @@ Sector::Sector(const ParticleDef& particle_def, const Definition& sector_def,
     const InterpolationDef& interpolation_def)
     : sector_def_(sector_def)
     , particle_def_(particle_def)
-    , utility_(particle_def, sector_def.GetMedium(), sector_def.cut_settings,
-          sector_def.utility_def, interpolation_def)
-    , displacement_calculator_(
-          new UtilityInterpolantDisplacement(utility_, interpolation_def))
-    , interaction_calculator_(
-          new UtilityInterpolantInteraction(utility_, interpolation_def))
-    , decay_calculator_(
-          new UtilityInterpolantDecay(utility_, interpolation_def))
+    , homogeneous_density_(HomogeneousDensity(sector_def))
+    , utility_(NULL)
+    , displacement_calculator_(NULL)
+    , interaction_calculator_(NULL)
+    , decay_calculator_(NULL)
     , exact_time_calculator_(NULL)
     , cont_rand_(NULL)
-    , scattering_(ScatteringFactory::Get().CreateScattering(
-          sector_def_.scattering_model, particle_def, utility_,
-          interpolation_def))
+    , scattering_(NULL)
+    , tables_ready_(false)
+    , abort_table_build_(false)
 {
+    if (interpolation_def.do_async_build) {
+        // Start with the integral classes, the builder replaces them
+        // one by one while the sector is already in use.
+        utility_ = std::make_shared<Utility>(particle_def,
+            sector_def.GetMedium(), sector_def.cut_settings,
+            sector_def.utility_def);
+        fallback_utilities_.push_back(utility_);
+        displacement_calculator_ = std::make_shared<UtilityIntegralDisplacement>(*utility_);
+        interaction_calculator_ = std::make_shared<UtilityIntegralInteraction>(*utility_);
+        decay_calculator_ = std::make_shared<UtilityIntegralDecay>(*utility_);
+        scattering_.reset(ScatteringFactory::Get().CreateScattering(
+            sector_def_.scattering_model, particle_def, *utility_));
+
+        if (sector_def_.do_exact_time_calculation) {
+            exact_time_calculator_ = std::make_shared<UtilityIntegralTime>(*utility_);
+        }
+        if (sector_def_.do_continuous_randomization) {
+            cont_rand_ = std::make_shared<ContinuousRandomizer>(*utility_);
+        }
+
+        table_build_ = std::async(std::launch::async, &Sector::BuildTables,
+            this, interpolation_def).share();
+        return;
+    }
+
+    utility_ = std::make_shared<Utility>(particle_def, sector_def.GetMedium(),
+        sector_def.cut_settings, sector_def.utility_def, interpolation_def);
+    displacement_calculator_ = std::make_shared<UtilityInterpolantDisplacement>(*utility_, interpolation_def);
+    interaction_calculator_ = std::make_shared<UtilityInterpolantInteraction>(*utility_, interpolation_def);
+    decay_calculator_ = std::make_shared<UtilityInterpolantDecay>(*utility_, interpolation_def);
+    scattering_.reset(ScatteringFactory::Get().CreateScattering(
+        sector_def_.scattering_model, particle_def, *utility_,
+        interpolation_def));
+
     // These are optional, therfore check NULL
     if (sector_def_.do_exact_time_calculation) {
-        exact_time_calculator_ = std::make_shared<UtilityInterpolantTime>(utility_, interpolation_def);
+        exact_time_calculator_ = std::make_shared<UtilityInterpolantTime>(*utility_, interpolation_def);
     }
 
     if (sector_def_.do_continuous_randomization) {
-        cont_rand_ = std::make_shared<ContinuousRandomizer>(utility_, interpolation_def);
+        cont_rand_ = std::make_shared<ContinuousRandomizer>(*utility_, interpolation_def);
     }
+
+    tables_ready_ = true;
 }
 
 Sector::Sector(const Sector& sector)
     : sector_def_(sector.sector_def_)
     , particle_def_(sector.particle_def_)
-    , utility_(sector.utility_)
-    , displacement_calculator_(sector.displacement_calculator_->clone(utility_))
-    , interaction_calculator_(sector.interaction_calculator_->clone(utility_))
-    , decay_calculator_(sector.decay_calculator_->clone(utility_))
+    , homogeneous_density_(sector.homogeneous_density_)
+    , utility_(NULL)
+    , displacement_calculator_(NULL)
+    , interaction_calculator_(NULL)
+    , decay_calculator_(NULL)
     , exact_time_calculator_(NULL)
-    , cont_rand_(sector.cont_rand_)
-    , scattering_(sector.scattering_)
+    , cont_rand_(NULL)
+    , scattering_(NULL)
+    , tables_ready_(true)
+    , abort_table_build_(false)
 {
+    // Copying a sector in the middle of the switch to the interpolants
+    // would mix components bound to different utilities.
+    sector.WaitForTables();
+
+    utility_ = std::make_shared<Utility>(*sector.utility_);
+    displacement_calculator_.reset(sector.displacement_calculator_->clone(*utility_));
+    interaction_calculator_.reset(sector.interaction_calculator_->clone(*utility_));
+    decay_calculator_.reset(sector.decay_calculator_->clone(*utility_));
+    cont_rand_ = sector.cont_rand_;
+    scattering_ = sector.scattering_;
+
+    // The shared components are still bound to the utilities of the
+    // original sector.
+    fallback_utilities_ = sector.fallback_utilities_;
+    fallback_utilities_.push_back(sector.utility_);
+
     // These are optional, therfore check NULL
     if (sector.exact_time_calculator_ != NULL) {
         exact_time_calculator_ = sector.exact_time_calculator_;
     }
 
+    tables_ready_ = sector.tables_ready_.load();
 }
 
 bool Sector::operator==(const Sector& sector) const
@@ -313,11 +380,11 @@ bool Sector::operator==(const Sector& sector) const
         return false;
     else if (particle_def_ != sector.particle_def_)
         return false;
-    else if (utility_ != sector.utility_)
+    else if (GetUtility() != sector.GetUtility())
         return false;
-    else if (*cont_rand_ != *sector.cont_rand_)
+    else if (*std::atomic_load(&cont_rand_) != *std::atomic_load(&sector.cont_rand_))
         return false;
-    else if (*scattering_ != *sector.scattering_)
+    else if (*GetScattering() != *sector.GetScattering())
         return false;
     return true;
 }
@@ -329,7 +396,114 @@ bool Sector::operator!=(const Sector& sector) const
 
 Sector::~Sector()
 {
+    // Tables which are already in progress are finished, so they end up
+    // on disk and can be reused by the next run.
+    abort_table_build_ = true;
+    WaitForTables();
+}
+
+void Sector::WaitForTables() const
+{
+    if (table_build_.valid()) {
+        table_build_.wait();
+    }
+}
+
+void Sector::BuildTables(const InterpolationDef& interpolation_def)
+{
+    try {
+        // All tables are built against this utility, which is never touched
+        // by the propagation. The propagation only gets copies of it.
+        Utility utility(particle_def_, sector_def_.GetMedium(),
+            sector_def_.cut_settings, sector_def_.utility_def,
+            interpolation_def);
+
+        // First step: the cross sections are interpolated. Integrating over
+        // them is already much faster, so the integral classes are rebound
+        // to the new utility right away.
+        auto published = std::make_shared<Utility>(utility);
+        fallback_utilities_.push_back(published);
+
+        std::atomic_store(&displacement_calculator_, std::shared_ptr<UtilityDecorator>(
+            std::make_shared<UtilityIntegralDisplacement>(*published)));
+        std::atomic_store(&interaction_calculator_, std::shared_ptr<UtilityDecorator>(
+            std::make_shared<UtilityIntegralInteraction>(*published)));
+        std::atomic_store(&decay_calculator_, std::shared_ptr<UtilityDecorator>(
+            std::make_shared<UtilityIntegralDecay>(*published)));
+        if (sector_def_.do_exact_time_calculation) {
+            std::atomic_store(&exact_time_calculator_, std::shared_ptr<UtilityDecorator>(
+                std::make_shared<UtilityIntegralTime>(*published)));
+        }
+        if (sector_def_.do_continuous_randomization) {
+            std::atomic_store(&cont_rand_,
+                std::make_shared<ContinuousRandomizer>(*published));
+        }
+        std::atomic_store(&scattering_, std::shared_ptr<Scattering>(
+            ScatteringFactory::Get().CreateScattering(
+                sector_def_.scattering_model, particle_def_, *published)));
+        std::atomic_store(&utility_, published);
+
+        // Second step: the propagation utilities. They are bound to a fresh
+        // copy of the utility, because the published one has already been
+        // modified by the propagation.
+        if (abort_table_build_)
+            return;
+        UtilityInterpolantDisplacement displacement(utility, interpolation_def);
+        if (abort_table_build_)
+            return;
+        UtilityInterpolantInteraction interaction(utility, interpolation_def);
+        if (abort_table_build_)
+            return;
+        UtilityInterpolantDecay decay(utility, interpolation_def);
+
+        std::unique_ptr<UtilityInterpolantTime> exact_time;
+        if (sector_def_.do_exact_time_calculation) {
+            if (abort_table_build_)
+                return;
+            exact_time.reset(new UtilityInterpolantTime(utility, interpolation_def));
+        }
+
+        std::unique_ptr<ContinuousRandomizer> cont_rand;
+        if (sector_def_.do_continuous_randomization) {
+            if (abort_table_build_)
+                return;
+            cont_rand.reset(new ContinuousRandomizer(utility, interpolation_def));
+        }
 
+        if (abort_table_build_)
+            return;
+        std::unique_ptr<Scattering> scattering(
+            ScatteringFactory::Get().CreateScattering(
+                sector_def_.scattering_model, particle_def_, utility,
+                interpolation_def));
+
+        published = std::make_shared<Utility>(utility);
+        fallback_utilities_.push_back(published);
+
+        std::atomic_store(&displacement_calculator_,
+            std::shared_ptr<UtilityDecorator>(displacement.clone(*published)));
+        std::atomic_store(&interaction_calculator_,
+            std::shared_ptr<UtilityDecorator>(interaction.clone(*published)));
+        std::atomic_store(&decay_calculator_,
+            std::shared_ptr<UtilityDecorator>(decay.clone(*published)));
+        if (exact_time) {
+            std::atomic_store(&exact_time_calculator_,
+                std::shared_ptr<UtilityDecorator>(exact_time->clone(*published)));
+        }
+        if (cont_rand) {
+            std::atomic_store(&cont_rand_,
+                std::make_shared<ContinuousRandomizer>(*published, *cont_rand));
+        }
+        std::atomic_store(&scattering_, std::shared_ptr<Scattering>(
+            scattering->clone(particle_def_, *published)));
+        std::atomic_store(&utility_, published);
+
+        tables_ready_ = true;
+        log_debug("Interpolation tables of the sector are ready.");
+    } catch (const std::exception& e) {
+        log_error("Building the interpolation tables failed, the sector "
+                  "stays in integral mode: %s", e.what());
+    }
 }
 
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -340,12 +514,16 @@ double Sector::CalculateTime(const DynamicData& p_condition,
     const double final_energy, const double displacement)
 {
     if (exact_time_calculator_) {
+        double time = std::atomic_load(&exact_time_calculator_)->Calculate(
+            p_condition.GetEnergy(), final_energy, 0.0);
+
+        if (homogeneous_density_ > 0)
+            return p_condition.GetTime() + time / homogeneous_density_;
+
         // DensityDistribution Approximation: Use the DensityDistribution at the
         // position of initial energy
-        return p_condition.GetTime()
-            + exact_time_calculator_->Calculate(
-                  p_condition.GetEnergy(), final_energy, 0.0)
-            / utility_.GetMedium()->GetDensityDistribution().Evaluate(
+        return p_condition.GetTime() + time
+            / sector_def_.GetMedium()->GetDensityDistribution().Evaluate(
                   p_condition.GetPosition());
     }
 
@@ -356,7 +534,7 @@ void Sector::Scatter(const double displacement, const double initial_energy,
     const double final_energy, Vector3D& position, Vector3D& direction)
 {
     if (sector_def_.scattering_model != ScatteringFactory::Enum::NoScattering) {
-        Directions directions = scattering_->Scatter(
+        Directions directions = std::atomic_load(&scattering_)->Scatter(
             displacement, initial_energy, final_energy, position, direction);
         position = position + displacement * directions.u_;
         direction = directions.n_i_;
@@ -368,10 +546,11 @@ void Sector::Scatter(const double displacement, const double initial_energy,
 double Sector::ContinuousRandomize(
     const double initial_energy, const double final_energy)
 {
-    if (cont_rand_) {
+    auto cont_rand = std::atomic_load(&cont_rand_);
+    if (cont_rand) {
         if (final_energy != particle_def_.low) {
             double rnd = RandomGenerator::Get().RandomDouble();
-            return cont_rand_->Randomize(initial_energy, final_energy, rnd);
+            return cont_rand->Randomize(initial_energy, final_energy, rnd);
         }
     }
     return final_energy;
@@ -396,7 +575,8 @@ std::pair<double, int> Sector::MakeStochasticLoss(double particle_energy)
         }
     }
 
-    energy_loss = utility_.StochasticLoss(particle_energy, rnd1, rnd2, rnd3);
+    energy_loss = std::atomic_load(&utility_)->StochasticLoss(
+        particle_energy, rnd1, rnd2, rnd3);
 
     return energy_loss;
 }
@@ -404,8 +584,15 @@ std::pair<double, int> Sector::MakeStochasticLoss(double particle_energy)
 double Sector::Displacement(const DynamicData& p_condition,
     const double final_energy, const double border_length)
 {
+    // a homogeneous medium only scales the grammage, which never crosses
+    // the border and needs neither the position nor the direction
+    if (homogeneous_density_ > 0) {
+        return std::atomic_load(&displacement_calculator_)->Calculate(
+            p_condition.GetEnergy(), final_energy, border_length) / homogeneous_density_;
+    }
+
     try{
-        return displacement_calculator_->Calculate(p_condition.GetEnergy(),
+        return std::atomic_load(&displacement_calculator_)->Calculate(p_condition.GetEnergy(),
         final_energy, border_length, p_condition.GetPosition(),
         p_condition.GetDirection());
     }
@@ -416,6 +603,11 @@ double Sector::Displacement(const DynamicData& p_condition,
     
 }
 
+double Sector::ContinuousDisplacement(const double initial_energy, const double final_energy)
+{
+    return std::atomic_load(&displacement_calculator_)->Calculate(initial_energy, final_energy, 0.0);
+}
+
 double Sector::BorderLength(const Vector3D& position, const Vector3D& direction)
 {
     // loop ueber alle sektoren hoeherer ordnung die im aktuellen sektor liegen
@@ -437,15 +629,16 @@ double Sector::EnergyDecay(const double initial_energy, const double rnd)
         return particle_def_.low;
     }
 
+    auto decay_calculator = std::atomic_load(&decay_calculator_);
     rnddMin
-        = decay_calculator_->Calculate(initial_energy, particle_def_.low, rndd);
+        = decay_calculator->Calculate(initial_energy, particle_def_.low, rndd);
 
     // evaluating the energy loss
     if (rndd >= rnddMin || rnddMin <= 0) {
         return particle_def_.low;
     }
 
-    return decay_calculator_->GetUpperLimit(initial_energy, rndd);
+    return decay_calculator->GetUpperLimit(initial_energy, rndd);
 }
 
 double Sector::EnergyInteraction(const double initial_energy, const double rnd)
@@ -454,14 +647,15 @@ double Sector::EnergyInteraction(const double initial_energy, const double rnd)
     double rndiMin = 0;
 
     // solving the tracking integral
-    rndiMin = interaction_calculator_->Calculate(
+    auto interaction_calculator = std::atomic_load(&interaction_calculator_);
+    rndiMin = interaction_calculator->Calculate(
         initial_energy, particle_def_.low, rndi);
 
     if (rndi >= rndiMin || rndiMin <= 0) {
         return particle_def_.low;
     }
 
-    return interaction_calculator_->GetUpperLimit(initial_energy, rndi);
+    return interaction_calculator->GetUpperLimit(initial_energy, rndi);
 }
 
 double Sector::EnergyMinimal(const double current_energy, const double cut)
@@ -472,7 +666,7 @@ double Sector::EnergyMinimal(const double current_energy, const double cut)
 double Sector::EnergyDistance(
     const double initial_energy, const double distance)
 {
-    return displacement_calculator_->GetUpperLimit(initial_energy, distance);
+    return std::atomic_load(&displacement_calculator_)->GetUpperLimit(initial_energy, distance);
 }
 
 int Sector::maximizeEnergy(const std::array<double, 4>& LossEnergies)
@@ -498,7 +692,7 @@ std::shared_ptr<DynamicData> Sector::DoInteraction(
         = MakeStochasticLoss(p_condition.GetEnergy());
 
     CrossSection* cross_section
-        = utility_.GetCrosssection(stochastic_loss.second);
+        = GetUtility().GetCrosssection(stochastic_loss.second);
     std::pair<double, double> deflection_angles
         = cross_section->StochasticDeflection(
             p_condition.GetEnergy(), stochastic_loss.first);
@@ -89,10 +89,7 @@ std::pair<std::vector<DynamicData>, bool> AnnihilationInterpolant::CalculateProd
 
         if (rsum > rnd)
         {
-            parametrization_->SetCurrentComponent(i);
-            Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
-            rho = (limits.vUp * std::exp(dndx_interpolant_2d_.at(i)->FindLimit(energy, rnd_ * prob_for_component_[i]) *
-                                         std::log(limits.vMax / limits.vUp)));
+            rho = CalculateRelativeLoss(energy, i, rnd_, prob_for_component_[i]);
 
             // The available energy is the positron energy plus the mass of the electron
             particle_list[0].SetEnergy((energy + ME) * (1-rho));
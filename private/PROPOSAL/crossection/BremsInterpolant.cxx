@@ -30,6 +30,7 @@ BremsInterpolant::BremsInterpolant(const Bremsstrahlung& param, InterpolationDef
     BremsIntegral brems(param);
 
     builder1d.SetMax(def.nodes_cross_section)
+        .SetPrecision(def.interpolation_precision)
         .SetXMin(param.GetParticleDef().mass)
         .SetXMax(def.max_node_energy)
         .SetRomberg(def.order_of_interpolation)
@@ -52,6 +53,7 @@ BremsInterpolant::BremsInterpolant(const Bremsstrahlung& param, InterpolationDef
     Helper::InterpolantBuilderContainer builder_container_de2dx;
 
     builder_de2dx.SetMax(def.nodes_continous_randomization)
+        .SetPrecision(def.interpolation_precision)
         .SetXMin(param.GetParticleDef().mass)
         .SetXMax(def.max_node_energy)
         .SetRomberg(def.order_of_interpolation)
@@ -45,23 +45,13 @@ double ComptonIntegral::CalculatedEdxWithoutMultiplier(double energy){
         sum += dedx_integral_.Integrate(
                 t_min,
                 t_max,
-                std::bind(integrand_substitution, energy, std::placeholders::_1),
+                [integrand_substitution, energy](double t) { return integrand_substitution(energy, t); },
                 2);
     }
 
     return energy * sum;
 }
 
-double ComptonIntegral::CalculatedEdx(double energy)
-{
-    if (parametrization_->GetMultiplier() <= 0)
-    {
-        return 0;
-    }
-
-    return parametrization_->GetMultiplier() * ComptonIntegral::CalculatedEdxWithoutMultiplier(energy);
-}
-
 double ComptonIntegral::CalculatedE2dxWithoutMultiplier(double energy)
 {
     double sum = 0;
@@ -82,7 +72,7 @@ double ComptonIntegral::CalculatedE2dxWithoutMultiplier(double energy)
         sum += de2dx_integral_.Integrate(
                 t_min,
                 t_max,
-                std::bind(integrand_substitution, energy, std::placeholders::_1),
+                [integrand_substitution, energy](double t) { return integrand_substitution(energy, t); },
                 2);
     }
 
@@ -90,13 +80,8 @@ double ComptonIntegral::CalculatedE2dxWithoutMultiplier(double energy)
 }
 
 // ------------------------------------------------------------------------- //
-double ComptonIntegral::CalculatedNdx(double energy)
+double ComptonIntegral::CalculatedNdxWithoutMultiplier(double energy)
 {
-    if (parametrization_->GetMultiplier() <= 0)
-    {
-        return 0;
-    }
-
     sum_of_rates_ = 0;
 
     for (size_t i = 0; i < components_.size(); ++i)
@@ -115,12 +100,12 @@ double ComptonIntegral::CalculatedNdx(double energy)
         prob_for_component_[i] = dndx_integral_[i].Integrate(
                 t_min,
                 t_max,
-                std::bind(integrand_substitution, energy, std::placeholders::_1),
+                [integrand_substitution, energy](double t) { return integrand_substitution(energy, t); },
                 2);
 
         sum_of_rates_ += prob_for_component_[i];
     }
-    return parametrization_->GetMultiplier() * sum_of_rates_;
+    return sum_of_rates_;
 }
 
 // ------------------------------------------------------------------------- //
@@ -157,7 +142,7 @@ double ComptonIntegral::CalculatedNdx(double energy, double rnd)
         prob_for_component_[i] = -dndx_integral_[i].IntegrateWithRandomRatio(
                 t_max,
                 t_min,
-                std::bind(integrand_substitution, energy, std::placeholders::_1),
+                [integrand_substitution, energy](double t) { return integrand_substitution(energy, t); },
                 3,
                 rnd);
 
@@ -182,7 +167,7 @@ double ComptonIntegral::CalculateCumulativeCrossSection(double energy, int i, do
     return dndx_integral_.at(i).Integrate(
             t_min,
             t_max,
-            std::bind(integrand_substitution, energy, std::placeholders::_1),
+            [integrand_substitution, energy](double t) { return integrand_substitution(energy, t); },
             2);
 }
 
@@ -33,6 +33,7 @@ ComptonInterpolant::ComptonInterpolant(const Compton& param, InterpolationDef de
     ComptonIntegral compton(param);
 
     builder1d.SetMax(def.nodes_cross_section)
+            .SetPrecision(def.interpolation_precision)
             .SetXMin(param.GetParticleDef().low)
             .SetXMax(def.max_node_energy)
             .SetRomberg(def.order_of_interpolation)
@@ -55,6 +56,7 @@ ComptonInterpolant::ComptonInterpolant(const Compton& param, InterpolationDef de
     Helper::InterpolantBuilderContainer builder_container_de2dx;
 
     builder_de2dx.SetMax(def.nodes_continous_randomization)
+            .SetPrecision(def.interpolation_precision)
             .SetXMin(param.GetParticleDef().low)
             .SetXMax(def.max_node_energy)
             .SetRomberg(def.order_of_interpolation)
@@ -208,12 +210,14 @@ void ComptonInterpolant::InitdNdxInterpolation(const InterpolationDef& def)
 
     Helper::InterpolantBuilderContainer builder_container1d(components_.size());
     Helper::InterpolantBuilderContainer builder_container2d(components_.size());
-    Helper::InterpolantBuilderContainer builder_return;
 
     Integral integral(IROMB, IMAXS, IPREC);
+    integral.SetQuadrature(parametrization_->GetQuadrature());
 
     for (unsigned int i = 0; i < components_.size(); ++i)
     {
+        double normalization = GetComponentNormalization(i);
+
         // !!! IMPORTANT !!!
         // Order of builder matter because the functions needed for 1d interpolation
         // needs the already intitialized 2d interpolants.
@@ -222,6 +226,7 @@ void ComptonInterpolant::InitdNdxInterpolation(const InterpolationDef& def)
                 .SetX1Min(parametrization_->GetParticleDef().low)
                 .SetX1Max(def.max_node_energy)
                 .SetMax2(def.nodes_cross_section)
+                .SetPrecision(def.interpolation_precision)
                 .SetX2Min(1. / (2. * (1. - def.nodes_cross_section)))
                 .SetX2Max((1. - 2. * def.nodes_cross_section) / (2. * (1. - def.nodes_cross_section)))
                 .SetRomberg1(def.order_of_interpolation)
@@ -236,19 +241,16 @@ void ComptonInterpolant::InitdNdxInterpolation(const InterpolationDef& def)
                 .SetRationalY(true)
                 .SetRelativeY(false)
                 .SetLogSubst(false)
-                .SetFunction2D(std::bind(
-                        &CrossSectionInterpolant::FunctionToBuildDNdxInterpolant2D,
-                        this,
-                        std::placeholders::_1,
-                        std::placeholders::_2,
-                        std::ref(integral),
-                        i));
+                .SetFunction2D([this, &integral, i, normalization](double energy, double v) {
+                    return FunctionToBuildDNdxInterpolant2D(energy, v, integral, i) / normalization;
+                });
 
         builder_container2d[i].first  = &builder2d[i];
         builder_container2d[i].second = &dndx_interpolant_2d_[i];
 
         builder1d[i]
                 .SetMax(def.nodes_cross_section)
+                .SetPrecision(def.interpolation_precision)
                 .SetXMin(parametrization_->GetParticleDef().low)
                 .SetXMax(def.max_node_energy)
                 .SetRomberg(def.order_of_interpolation)
@@ -265,9 +267,5 @@ void ComptonInterpolant::InitdNdxInterpolation(const InterpolationDef& def)
         builder_container1d[i].second = &dndx_interpolant_1d_[i];
     }
 
-    builder_return.insert(builder_return.end(), builder_container2d.begin(), builder_container2d.end());
-    builder_return.insert(builder_return.end(), builder_container1d.begin(), builder_container1d.end());
-    // builder2d.insert(builder2d.end(), builder1d.begin(), builder1d.end());
-
-    Helper::InitializeInterpolation("dNdx", builder_return, std::vector<Parametrization*>(1, parametrization_), def);
+    InitializeComponentInterpolation("dNdx", builder_container2d, builder_container1d, true, def);
 }
@@ -1,4 +1,5 @@
 
+#include <algorithm>
 #include <functional>
 
 #include "PROPOSAL/crossection/CrossSectionIntegral.h"
@@ -19,7 +20,16 @@ CrossSectionIntegral::CrossSectionIntegral(const InteractionType& type, const Pa
     , dedx_integral_(IROMB, IMAXS, IPREC)
     , de2dx_integral_(IROMB, IMAXS, IPREC)
     , dndx_integral_(param.GetMedium()->GetNumComponents(), Integral(IROMB, IMAXS, IPREC))
+    , dedx_cache_()
+    , de2dx_cache_()
+    , dndx_cache_()
 {
+    dedx_integral_.SetQuadrature(param.GetQuadrature());
+    de2dx_integral_.SetQuadrature(param.GetQuadrature());
+    for (auto& integral : dndx_integral_)
+    {
+        integral.SetQuadrature(param.GetQuadrature());
+    }
 }
 
 CrossSectionIntegral::CrossSectionIntegral(const CrossSectionIntegral& cross_section)
@@ -27,6 +37,9 @@ CrossSectionIntegral::CrossSectionIntegral(const CrossSectionIntegral& cross_sec
     , dedx_integral_(cross_section.dedx_integral_)
     , de2dx_integral_(cross_section.de2dx_integral_)
     , dndx_integral_(cross_section.dndx_integral_)
+    , dedx_cache_(cross_section.dedx_cache_)
+    , de2dx_cache_(cross_section.de2dx_cache_)
+    , dndx_cache_(cross_section.dndx_cache_)
 {
 }
 
@@ -50,6 +63,34 @@ bool CrossSectionIntegral::compare(const CrossSection& cross_section) const
 // Pulblic methods
 // ------------------------------------------------------------------------- //
 
+// ------------------------------------------------------------------------- //
+void CrossSectionIntegral::SetCache(size_t size, double tolerance)
+{
+    dedx_cache_  = EnergyCache<double>(size, tolerance);
+    de2dx_cache_ = EnergyCache<double>(size, tolerance);
+    dndx_cache_  = EnergyCache<std::vector<double> >(size, tolerance);
+}
+
+// ------------------------------------------------------------------------- //
+double CrossSectionIntegral::CalculatedEdx(double energy)
+{
+    if (parametrization_->GetMultiplier() <= 0)
+    {
+        return 0;
+    }
+
+    const double* cached = dedx_cache_.Find(energy);
+    if (cached != nullptr)
+    {
+        return parametrization_->GetMultiplier() * (*cached);
+    }
+
+    double aux = CalculatedEdxWithoutMultiplier(energy);
+    dedx_cache_.Insert(energy, aux);
+
+    return parametrization_->GetMultiplier() * aux;
+}
+
 // ------------------------------------------------------------------------- //
 double CrossSectionIntegral::CalculatedE2dx(double energy)
 {
@@ -58,9 +99,14 @@ double CrossSectionIntegral::CalculatedE2dx(double energy)
         return 0;
     }
 
-    double aux = 0;
-    aux = CrossSectionIntegral::CalculatedE2dxWithoutMultiplier(energy);
+    const double* cached = de2dx_cache_.Find(energy);
+    if (cached != nullptr)
+    {
+        return parametrization_->GetMultiplier() * (*cached);
+    }
 
+    double aux = CalculatedE2dxWithoutMultiplier(energy);
+    de2dx_cache_.Insert(energy, aux);
 
     return parametrization_->GetMultiplier() * aux;
 }
@@ -74,11 +120,16 @@ double CrossSectionIntegral::CalculatedE2dxWithoutMultiplier(double energy)
         parametrization_->SetCurrentComponent(i);
         Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
 
-        sum += de2dx_integral_.Integrate(
-            limits.vMin,
-            limits.vUp,
-            std::bind(&Parametrization::FunctionToDE2dxIntegral, parametrization_, energy, std::placeholders::_1),
-            2);
+        double integral = 0;
+        if (!parametrization_->IntegrateDifferentialCrossSection(energy, limits.vMin, limits.vUp, 2, integral))
+        {
+            integral = de2dx_integral_.IntegrateBatch(
+                limits.vMin,
+                limits.vUp,
+                [this, energy](const double* v, double* out, size_t n) { parametrization_->FunctionToDE2dxIntegral(energy, v, out, n); },
+                2);
+        }
+        sum += integral;
     }
 
     return energy * energy * sum;
@@ -92,6 +143,32 @@ double CrossSectionIntegral::CalculatedNdx(double energy)
         return 0;
     }
 
+    // the rates of the components are restored as well, they are used
+    // by the sampling of the stochastic loss
+    const std::vector<double>* cached = dndx_cache_.Find(energy);
+    if (cached != nullptr)
+    {
+        std::copy(cached->begin(), cached->end() - 1, prob_for_component_.begin());
+        sum_of_rates_ = cached->back();
+
+        return parametrization_->GetMultiplier() * sum_of_rates_;
+    }
+
+    CalculatedNdxWithoutMultiplier(energy);
+
+    if (dndx_cache_.IsEnabled())
+    {
+        std::vector<double> rates(prob_for_component_.begin(), prob_for_component_.end());
+        rates.push_back(sum_of_rates_);
+        dndx_cache_.Insert(energy, rates);
+    }
+
+    return parametrization_->GetMultiplier() * sum_of_rates_;
+}
+
+// ------------------------------------------------------------------------- //
+double CrossSectionIntegral::CalculatedNdxWithoutMultiplier(double energy)
+{
     sum_of_rates_ = 0;
 
     for (size_t i = 0; i < components_.size(); ++i)
@@ -99,14 +176,18 @@ double CrossSectionIntegral::CalculatedNdx(double energy)
         parametrization_->SetCurrentComponent(i);
         Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
 
-        prob_for_component_[i] = dndx_integral_[i].Integrate(
-            limits.vUp,
-            limits.vMax,
-            std::bind(&Parametrization::FunctionToDNdxIntegral, parametrization_, energy, std::placeholders::_1),
-            4);
+        if (!parametrization_->IntegrateDifferentialCrossSection(
+                energy, limits.vUp, limits.vMax, 0, prob_for_component_[i]))
+        {
+            prob_for_component_[i] = dndx_integral_[i].IntegrateBatch(
+                limits.vUp,
+                limits.vMax,
+                [this, energy](const double* v, double* out, size_t n) { parametrization_->FunctionToDNdxIntegral(energy, v, out, n); },
+                4);
+        }
         sum_of_rates_ += prob_for_component_[i];
     }
-    return parametrization_->GetMultiplier() * sum_of_rates_;
+    return sum_of_rates_;
 }
 
 // ------------------------------------------------------------------------- //
@@ -132,7 +213,7 @@ double CrossSectionIntegral::CalculatedNdx(double energy, double rnd)
         prob_for_component_[i] = dndx_integral_[i].IntegrateWithRandomRatio(
             limits.vUp,
             limits.vMax,
-            std::bind(&Parametrization::FunctionToDNdxIntegral, parametrization_, energy, std::placeholders::_1),
+            [this, energy](double v) { return parametrization_->FunctionToDNdxIntegral(energy, v); },
             4,
             rnd);
         sum_of_rates_ += prob_for_component_[i];
@@ -157,10 +238,16 @@ double CrossSectionIntegral::CalculateCumulativeCrossSection(double energy, int
     parametrization_->SetCurrentComponent(i);
     Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
 
-    return dndx_integral_.at(i).Integrate(
+    double integral = 0;
+    if (parametrization_->IntegrateDifferentialCrossSection(energy, limits.vUp, v, 0, integral))
+    {
+        return integral;
+    }
+
+    return dndx_integral_.at(i).IntegrateBatch(
             limits.vUp,
             v,
-            std::bind(&Parametrization::FunctionToDNdxIntegral, parametrization_, energy, std::placeholders::_1),
+            [this, energy](const double* v, double* out, size_t n) { parametrization_->FunctionToDNdxIntegral(energy, v, out, n); },
             4);
 
 }
@@ -1,6 +1,7 @@
 
 #include <functional>
 #include <cmath>
+#include <memory>
 
 #include "PROPOSAL/crossection/CrossSectionInterpolant.h"
 #include "PROPOSAL/crossection/parametrization/Parametrization.h"
@@ -15,6 +16,9 @@
 
 using namespace PROPOSAL;
 
+// Lowest energy loss in MeV covered by the cut independent dNdx tables
+const double CrossSectionInterpolant::cut_independent_min_loss_ = 1e-6;
+
 // ------------------------------------------------------------------------- //
 // Constructor & Destructor
 // ------------------------------------------------------------------------- //
@@ -25,6 +29,7 @@ CrossSectionInterpolant::CrossSectionInterpolant(const InteractionType& type, co
     , de2dx_interpolant_(NULL)
     , dndx_interpolant_1d_(param.GetMedium()->GetNumComponents(), NULL)
     , dndx_interpolant_2d_(param.GetMedium()->GetNumComponents(), NULL)
+    , cut_independent_dndx_(false)
 {
 }
 
@@ -33,7 +38,9 @@ bool CrossSectionInterpolant::compare(const CrossSection& cross_section) const
     const CrossSectionInterpolant* cross_section_interpolant =
         static_cast<const CrossSectionInterpolant*>(&cross_section);
 
-    if (*dedx_interpolant_ != *cross_section_interpolant->dedx_interpolant_)
+    if (cut_independent_dndx_ != cross_section_interpolant->cut_independent_dndx_)
+        return false;
+    else if (*dedx_interpolant_ != *cross_section_interpolant->dedx_interpolant_)
         return false;
     else if (*de2dx_interpolant_ != *cross_section_interpolant->de2dx_interpolant_)
         return false;
@@ -59,6 +66,11 @@ bool CrossSectionInterpolant::compare(const CrossSection& cross_section) const
 // ------------------------------------------------------------------------- //
 void CrossSectionInterpolant::InitdNdxInterpolation(const InterpolationDef& def)
 {
+    if (def.do_cut_independent_dndx && InitCutIndependentdNdxInterpolation(def))
+    {
+        return;
+    }
+
     // --------------------------------------------------------------------- //
     // Builder for dNdx
     // --------------------------------------------------------------------- //
@@ -68,12 +80,14 @@ void CrossSectionInterpolant::InitdNdxInterpolation(const InterpolationDef& def)
 
     Helper::InterpolantBuilderContainer builder_container1d(components_.size());
     Helper::InterpolantBuilderContainer builder_container2d(components_.size());
-    Helper::InterpolantBuilderContainer builder_return;
 
     Integral integral(IROMB, IMAXS, IPREC);
+    integral.SetQuadrature(parametrization_->GetQuadrature());
 
     for (unsigned int i = 0; i < components_.size(); ++i)
     {
+        double normalization = GetComponentNormalization(i);
+
         // !!! IMPORTANT !!!
         // Order of builder matter because the functions needed for 1d interpolation
         // needs the already intitialized 2d interpolants.
@@ -82,6 +96,7 @@ void CrossSectionInterpolant::InitdNdxInterpolation(const InterpolationDef& def)
             .SetX1Min(parametrization_->GetParticleDef().mass)
             .SetX1Max(def.max_node_energy)
             .SetMax2(def.nodes_cross_section)
+            .SetPrecision(def.interpolation_precision)
             .SetX2Min(0.0)
             .SetX2Max(1.0)
             .SetRomberg1(def.order_of_interpolation)
@@ -96,19 +111,16 @@ void CrossSectionInterpolant::InitdNdxInterpolation(const InterpolationDef& def)
             .SetRationalY(true)
             .SetRelativeY(false)
             .SetLogSubst(false)
-            .SetFunction2D(std::bind(
-                &CrossSectionInterpolant::FunctionToBuildDNdxInterpolant2D,
-                this,
-                std::placeholders::_1,
-                std::placeholders::_2,
-                std::ref(integral),
-                i));
+            .SetFunction2D([this, &integral, i, normalization](double energy, double v) {
+                return FunctionToBuildDNdxInterpolant2D(energy, v, integral, i) / normalization;
+            });
 
         builder_container2d[i].first  = &builder2d[i];
         builder_container2d[i].second = &dndx_interpolant_2d_[i];
 
         builder1d[i]
             .SetMax(def.nodes_cross_section)
+            .SetPrecision(def.interpolation_precision)
             .SetXMin(parametrization_->GetParticleDef().mass)
             .SetXMax(def.max_node_energy)
             .SetRomberg(def.order_of_interpolation)
@@ -125,11 +137,147 @@ void CrossSectionInterpolant::InitdNdxInterpolation(const InterpolationDef& def)
         builder_container1d[i].second = &dndx_interpolant_1d_[i];
     }
 
-    builder_return.insert(builder_return.end(), builder_container2d.begin(), builder_container2d.end());
-    builder_return.insert(builder_return.end(), builder_container1d.begin(), builder_container1d.end());
-    // builder2d.insert(builder2d.end(), builder1d.begin(), builder1d.end());
+    InitializeComponentInterpolation("dNdx", builder_container2d, builder_container1d, true, def);
+}
+
+// ------------------------------------------------------------------------- //
+bool CrossSectionInterpolant::InitCutIndependentdNdxInterpolation(const InterpolationDef& def)
+{
+    // The tables have to reach down to the lowest energy loss the cuts ask for.
+    // The cut in units of energy is smallest at the lowest energy.
+    double energy_min = parametrization_->GetParticleDef().mass;
+
+    if (energy_min <= 0 ||
+        parametrization_->GetEnergyCuts().GetCut(energy_min) * energy_min < cut_independent_min_loss_)
+    {
+        log_info("Energy cuts of %s reach below the cut independent dNdx tables. Use cut specific tables.",
+                 parametrization_->GetName().c_str());
+        return false;
+    }
+
+    cut_independent_dndx_ = true;
+
+    // --------------------------------------------------------------------- //
+    // Builder for the cut independent dNdx
+    // --------------------------------------------------------------------- //
+
+    std::vector<Interpolant2DBuilder> builder2d(components_.size());
+    Helper::InterpolantBuilderContainer builder_container2d(components_.size());
+
+    Integral integral(IROMB, IMAXS, IPREC);
+    integral.SetQuadrature(parametrization_->GetQuadrature());
+
+    for (unsigned int i = 0; i < components_.size(); ++i)
+    {
+        double normalization = GetComponentNormalization(i);
+
+        builder2d[i]
+            .SetMax1(def.nodes_cross_section)
+            .SetX1Min(energy_min)
+            .SetX1Max(def.max_node_energy)
+            .SetMax2(def.nodes_cross_section)
+            .SetPrecision(def.interpolation_precision)
+            .SetX2Min(0.0)
+            .SetX2Max(1.0)
+            .SetRomberg1(def.order_of_interpolation)
+            .SetRational1(false)
+            .SetRelative1(false)
+            .SetIsLog1(true)
+            .SetRomberg2(def.order_of_interpolation)
+            .SetRational2(false)
+            .SetRelative2(false)
+            .SetIsLog2(false)
+            .SetRombergY(def.order_of_interpolation)
+            .SetRationalY(true)
+            .SetRelativeY(false)
+            .SetLogSubst(true)
+            .SetFunction2D([this, &integral, i, normalization](double energy, double v) {
+                return FunctionToBuildCutIndependentDNdxInterpolant2D(energy, v, integral, i) / normalization;
+            });
+
+        builder_container2d[i].first  = &builder2d[i];
+        builder_container2d[i].second = &dndx_interpolant_2d_[i];
+    }
+
+    Helper::InterpolantBuilderContainer builder_container1d;
+    InitializeComponentInterpolation("dNdx_cut_independent", builder_container2d, builder_container1d, false, def);
+
+    // --------------------------------------------------------------------- //
+    // The total rates for the actual cut are cheap to derive and are not stored
+    // --------------------------------------------------------------------- //
+
+    for (unsigned int i = 0; i < components_.size(); ++i)
+    {
+        Interpolant1DBuilder builder1d;
+        builder1d.SetMax(def.nodes_cross_section)
+            .SetPrecision(def.interpolation_precision)
+            .SetXMin(energy_min)
+            .SetXMax(def.max_node_energy)
+            .SetRomberg(def.order_of_interpolation)
+            .SetRational(false)
+            .SetRelative(false)
+            .SetIsLog(true)
+            .SetRombergY(def.order_of_interpolation)
+            .SetRationalY(true)
+            .SetRelativeY(false)
+            .SetLogSubst(false)
+            .SetFunction1D(std::bind(&CrossSectionInterpolant::CalculateCutIndependentdNdx, this, std::placeholders::_1, i));
+
+        dndx_interpolant_1d_[i] = builder1d.build();
 
-    Helper::InitializeInterpolation("dNdx", builder_return, std::vector<Parametrization*>(1, parametrization_), def);
+        std::unique_ptr<InterpolantBuilder> extension_builder(
+            builder1d.CreateExtensionBuilder(def.max_node_energy, def.extended_max_node_energy));
+        if (extension_builder)
+        {
+            std::unique_ptr<Interpolant> extension(extension_builder->build());
+            dndx_interpolant_1d_[i]->Append(*extension);
+        }
+    }
+
+    return true;
+}
+
+// ------------------------------------------------------------------------- //
+void CrossSectionInterpolant::InitializeComponentInterpolation(const std::string& name,
+                                                               Helper::InterpolantBuilderContainer& builder_container2d,
+                                                               Helper::InterpolantBuilderContainer& builder_container1d,
+                                                               bool cut_dependent,
+                                                               const InterpolationDef& def)
+{
+    for (unsigned int i = 0; i < components_.size(); ++i)
+    {
+        // !!! IMPORTANT !!!
+        // The 1d tables are built from the 2d table of the same component,
+        // so the 2d table has to come first.
+        Helper::InterpolantBuilderContainer builder_container(1, builder_container2d.at(i));
+        if (!builder_container1d.empty())
+        {
+            builder_container.push_back(builder_container1d.at(i));
+        }
+
+        size_t hash_digest = parametrization_->GetComponentHash(i);
+        if (cut_dependent)
+        {
+            const EnergyCutSettings& cuts = parametrization_->GetEnergyCuts();
+            hash_combine(hash_digest, cuts.GetEcut(), cuts.GetVcut());
+        }
+
+        Helper::InitializeInterpolation(name, builder_container, hash_digest, def);
+
+        for (auto& builder : builder_container)
+        {
+            (*builder.second)->Scale(GetComponentNormalization(i));
+        }
+    }
+}
+
+// ------------------------------------------------------------------------- //
+double CrossSectionInterpolant::GetComponentNormalization(int component) const
+{
+    double normalization =
+        parametrization_->GetMedium()->GetMolDensity() * components_.at(component).GetAtomInMolecule();
+
+    return normalization > 0 ? normalization : 1.;
 }
 
 CrossSectionInterpolant::CrossSectionInterpolant(const CrossSectionInterpolant& cross_section)
@@ -153,6 +301,8 @@ CrossSectionInterpolant::CrossSectionInterpolant(const CrossSectionInterpolant&
 
     int num_components = cross_section.parametrization_->GetMedium()->GetNumComponents();
 
+    cut_independent_dndx_ = cross_section.cut_independent_dndx_;
+
     dndx_interpolant_1d_.reserve(num_components);
     for (auto interpolant: cross_section.dndx_interpolant_1d_)
     {
@@ -281,9 +431,7 @@ double CrossSectionInterpolant::CalculateStochasticLoss(double energy, double rn
                 return energy * limits.vUp;
             }
 
-            return energy *
-                   (limits.vUp * std::exp(dndx_interpolant_2d_.at(i)->FindLimit(energy, rnd_ * prob_for_component_[i]) *
-                                     std::log(limits.vMax / limits.vUp)));
+            return energy * CalculateRelativeLoss(energy, i, rnd_, prob_for_component_[i]);
         }
     }
 
@@ -317,6 +465,23 @@ double CrossSectionInterpolant::FunctionToBuildDNdxInterpolant(double energy, in
 
 double CrossSectionInterpolant::CalculateCumulativeCrossSection(double energy, int component, double v)
 {
+    if (cut_independent_dndx_)
+    {
+        parametrization_->SetCurrentComponent(component);
+        Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
+
+        double v_low = GetCutIndependentVLow(energy, limits.vMin);
+        if (v_low >= limits.vMax)
+        {
+            return 0;
+        }
+
+        v = std::log(std::max(v, v_low) / v_low) / std::log(limits.vMax / v_low);
+
+        return CalculateCutIndependentdNdx(energy, component) -
+               dndx_interpolant_2d_.at(component)->Interpolate(energy, std::min(v, 1.));
+    }
+
     parametrization_->SetCurrentComponent(component);
     Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
 
@@ -341,6 +506,92 @@ double CrossSectionInterpolant::FunctionToBuildDNdxInterpolant2D(double energy,
 
     v = limits.vUp * std::exp(v * std::log(limits.vMax / limits.vUp));
 
-    return integral.Integrate(
-        limits.vUp, v, std::bind(&Parametrization::FunctionToDNdxIntegral, parametrization_, energy, std::placeholders::_1), 4);
+    double result = 0;
+    if (parametrization_->IntegrateDifferentialCrossSection(energy, limits.vUp, v, 0, result))
+    {
+        return result;
+    }
+
+    return integral.IntegrateBatch(
+        limits.vUp, v,
+        [this, energy](const double* x, double* out, size_t n) { parametrization_->FunctionToDNdxIntegral(energy, x, out, n); },
+        4);
+}
+
+//----------------------------------------------------------------------------//
+double CrossSectionInterpolant::FunctionToBuildCutIndependentDNdxInterpolant2D(double energy,
+                                                                               double v,
+                                                                               Integral& integral,
+                                                                               int component)
+{
+    parametrization_->SetCurrentComponent(component);
+    Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
+
+    double v_low = GetCutIndependentVLow(energy, limits.vMin);
+    if (v_low >= limits.vMax)
+    {
+        return 0;
+    }
+
+    v = v_low * std::exp(v * std::log(limits.vMax / v_low));
+
+    double result = 0;
+    if (parametrization_->IntegrateDifferentialCrossSection(energy, v, limits.vMax, 0, result))
+    {
+        return result;
+    }
+
+    return integral.IntegrateBatch(
+        v, limits.vMax,
+        [this, energy](const double* x, double* out, size_t n) { parametrization_->FunctionToDNdxIntegral(energy, x, out, n); },
+        4);
+}
+
+// ------------------------------------------------------------------------- //
+// Cut independent tables
+// ------------------------------------------------------------------------- //
+
+// ------------------------------------------------------------------------- //
+double CrossSectionInterpolant::GetCutIndependentVLow(double energy, double v_min) const
+{
+    return std::max(v_min, cut_independent_min_loss_ / energy);
+}
+
+// ------------------------------------------------------------------------- //
+double CrossSectionInterpolant::CalculateCutIndependentdNdx(double energy, int component)
+{
+    parametrization_->SetCurrentComponent(component);
+    Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
+
+    double v_low = GetCutIndependentVLow(energy, limits.vMin);
+    if (limits.vUp >= limits.vMax || v_low >= limits.vMax)
+    {
+        return 0;
+    }
+
+    double t_cut = std::log(std::max(limits.vUp, v_low) / v_low) / std::log(limits.vMax / v_low);
+
+    return std::max(dndx_interpolant_2d_.at(component)->Interpolate(energy, t_cut), 0.);
+}
+
+// ------------------------------------------------------------------------- //
+double CrossSectionInterpolant::CalculateRelativeLoss(double energy, int component, double rnd, double rate)
+{
+    parametrization_->SetCurrentComponent(component);
+    Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
+
+    if (cut_independent_dndx_)
+    {
+        // Solve integral_v^vMax dNdx = (1 - rnd) * integral_vUp^vMax dNdx,
+        // the rate is the tabulated integral above the cut
+        double v_low     = GetCutIndependentVLow(energy, limits.vMin);
+        double log_range = std::log(limits.vMax / v_low);
+
+        double t = dndx_interpolant_2d_.at(component)->FindLimit(energy, (1. - rnd) * rate);
+
+        return std::min(std::max(v_low * std::exp(t * log_range), limits.vUp), limits.vMax);
+    }
+
+    return limits.vUp *
+           std::exp(dndx_interpolant_2d_.at(component)->FindLimit(energy, rnd * rate) * std::log(limits.vMax / limits.vUp));
 }
@@ -24,16 +24,6 @@ EpairIntegral::~EpairIntegral() {}
 // Public methods
 // ----------------------------------------------------------------- //
 
-double EpairIntegral::CalculatedEdx(double energy)
-{
-    if (parametrization_->GetMultiplier() <= 0)
-    {
-        return 0;
-    }
-
-    return parametrization_->GetMultiplier() * EpairIntegral::CalculatedEdxWithoutMultiplier(energy);
-}
-
 double EpairIntegral::CalculatedEdxWithoutMultiplier(double energy)
 {
     double sum = 0;
@@ -43,6 +33,14 @@ double EpairIntegral::CalculatedEdxWithoutMultiplier(double energy)
         parametrization_->SetCurrentComponent(i);
         Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
 
+        // the cubature substitutes log(1 - v) towards vUp on its own
+        double integral = 0;
+        if (parametrization_->IntegrateDifferentialCrossSection(energy, limits.vMin, limits.vUp, 1, integral))
+        {
+            sum += integral;
+            continue;
+        }
+
         double r1  = 0.8;
         double rUp = limits.vUp * (1 - HALF_PRECISION);
         bool rflag = false;
@@ -68,10 +66,10 @@ double EpairIntegral::CalculatedEdxWithoutMultiplier(double energy)
                 r1 = limits.vMin;
             }
 
-            sum += dedx_integral_.Integrate(
+            sum += dedx_integral_.IntegrateBatch(
                 limits.vMin,
                 r1,
-                std::bind(&Parametrization::FunctionToDEdxIntegral, parametrization_, energy, std::placeholders::_1),
+                [this, energy](const double* v, double* out, size_t n) { parametrization_->FunctionToDEdxIntegral(energy, v, out, n); },
                 4);
             double r2 = std::max(1 - limits.vUp, COMPUTER_PRECISION);
 
@@ -83,19 +81,19 @@ double EpairIntegral::CalculatedEdxWithoutMultiplier(double energy)
             sum +=
                 dedx_integral_.Integrate(1 - limits.vUp,
                                          r2,
-                                         std::bind(&EpairIntegral::FunctionToDEdxIntegralReverse, this, energy, std::placeholders::_1),
+                                         [this, energy](double v) { return FunctionToDEdxIntegralReverse(energy, v); },
                                          2) +
                 dedx_integral_.Integrate(
-                    r2, 1 - r1, std::bind(&EpairIntegral::FunctionToDEdxIntegralReverse, this, energy, std::placeholders::_1), 4);
+                    r2, 1 - r1, [this, energy](double v) { return FunctionToDEdxIntegralReverse(energy, v); }, 4);
 
         }
 
         else
         {
-            sum += dedx_integral_.Integrate(
+            sum += dedx_integral_.IntegrateBatch(
                 limits.vMin,
                 limits.vUp,
-                std::bind(&Parametrization::FunctionToDEdxIntegral, parametrization_, energy, std::placeholders::_1),
+                [this, energy](const double* v, double* out, size_t n) { parametrization_->FunctionToDEdxIntegral(energy, v, out, n); },
                 4);
         }
     }
@@ -36,10 +36,10 @@ double IonizIntegral::CalculatedEdxWithoutMultiplier(double energy)
     Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
 
     if(parametrization_->GetName() != "IonizBergerSeltzerBhabha" && parametrization_->GetName() != "IonizBergerSeltzerMoller"){
-        return energy * dedx_integral_.Integrate(
+        return energy * dedx_integral_.IntegrateBatch(
                 limits.vMin,
                 limits.vUp,
-                std::bind(&Parametrization::FunctionToDEdxIntegral, parametrization_, energy, std::placeholders::_1),
+                [this, energy](const double* v, double* out, size_t n) { parametrization_->FunctionToDEdxIntegral(energy, v, out, n); },
                 4);
     }
     else{
@@ -48,56 +48,30 @@ double IonizIntegral::CalculatedEdxWithoutMultiplier(double energy)
 
 }
 
-double IonizIntegral::CalculatedEdx(double energy)
-{
-    if (parametrization_->GetMultiplier() <= 0)
-    {
-        return 0;
-    }
-
-    return parametrization_->GetMultiplier() * IonizIntegral::CalculatedEdxWithoutMultiplier(energy);
-}
-
-// ------------------------------------------------------------------------- //
-double IonizIntegral::CalculatedE2dx(double energy)
-{
-    if (parametrization_->GetMultiplier() <= 0)
-    {
-        return 0;
-    }
-
-    return parametrization_->GetMultiplier() * IonizIntegral::CalculatedE2dxWithoutMultiplier(energy);
-}
-
 double IonizIntegral::CalculatedE2dxWithoutMultiplier(double energy)
 {
     Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
 
-    return de2dx_integral_.Integrate(
+    return de2dx_integral_.IntegrateBatch(
         limits.vMin,
         limits.vUp,
-        std::bind(&Parametrization::FunctionToDE2dxIntegral, parametrization_, energy, std::placeholders::_1),
+        [this, energy](const double* v, double* out, size_t n) { parametrization_->FunctionToDE2dxIntegral(energy, v, out, n); },
         2);
 }
 
 // ------------------------------------------------------------------------- //
-double IonizIntegral::CalculatedNdx(double energy)
+double IonizIntegral::CalculatedNdxWithoutMultiplier(double energy)
 {
-    if (parametrization_->GetMultiplier() <= 0)
-    {
-        return 0;
-    }
-
     Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
     ;
     sum_of_rates_ =
-        dndx_integral_[0].Integrate(limits.vUp,
-                                    limits.vMax,
-                                    std::bind(&Parametrization::FunctionToDNdxIntegral, parametrization_, energy, std::placeholders::_1),
-                                    3,
-                                    1);
+        dndx_integral_[0].IntegrateBatch(limits.vUp,
+                                         limits.vMax,
+                                         [this, energy](const double* v, double* out, size_t n) { parametrization_->FunctionToDNdxIntegral(energy, v, out, n); },
+                                         3,
+                                         1);
 
-    return parametrization_->GetMultiplier() * sum_of_rates_;
+    return sum_of_rates_;
 }
 
 // ------------------------------------------------------------------------- //
@@ -115,7 +89,7 @@ double IonizIntegral::CalculatedNdx(double energy, double rnd)
     sum_of_rates_ = dndx_integral_[0].IntegrateWithRandomRatio(
         limits.vUp,
         limits.vMax,
-        std::bind(&Parametrization::FunctionToDNdxIntegral, parametrization_, energy, std::placeholders::_1),
+        [this, energy](double v) { return parametrization_->FunctionToDNdxIntegral(energy, v); },
         3,
         rnd,
         1);
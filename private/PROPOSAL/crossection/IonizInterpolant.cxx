@@ -36,6 +36,7 @@ IonizInterpolant::IonizInterpolant(const Ionization& param, InterpolationDef def
     IonizIntegral ioniz(param);
 
     builder1d.SetMax(def.nodes_cross_section)
+        .SetPrecision(def.interpolation_precision)
         .SetXMin(param.GetParticleDef().mass)
         .SetXMax(def.max_node_energy)
         .SetRomberg(def.order_of_interpolation)
@@ -58,6 +59,7 @@ IonizInterpolant::IonizInterpolant(const Ionization& param, InterpolationDef def
     Helper::InterpolantBuilderContainer builder_container_de2dx;
 
     builder_de2dx.SetMax(def.nodes_continous_randomization)
+        .SetPrecision(def.interpolation_precision)
         .SetXMin(param.GetParticleDef().mass)
         .SetXMax(def.max_node_energy)
         .SetRomberg(def.order_of_interpolation)
@@ -87,6 +89,11 @@ IonizInterpolant::~IonizInterpolant() {}
 // ------------------------------------------------------------------------- //
 void IonizInterpolant::InitdNdxInterpolation(const InterpolationDef& def)
 {
+    if (def.do_cut_independent_dndx && InitCutIndependentdNdxInterpolation(def))
+    {
+        return;
+    }
+
     // --------------------------------------------------------------------- //
     // Builder for dNdx
     // --------------------------------------------------------------------- //
@@ -99,6 +106,7 @@ void IonizInterpolant::InitdNdxInterpolation(const InterpolationDef& def)
     Helper::InterpolantBuilderContainer builder_return;
 
     Integral integral(IROMB, IMAXS, IPREC);
+    integral.SetQuadrature(parametrization_->GetQuadrature());
 
     for (unsigned int i = 0; i < components_.size(); ++i)
     {
@@ -110,6 +118,7 @@ void IonizInterpolant::InitdNdxInterpolation(const InterpolationDef& def)
             .SetX1Min(parametrization_->GetParticleDef().mass)
             .SetX1Max(def.max_node_energy)
             .SetMax2(def.nodes_cross_section)
+            .SetPrecision(def.interpolation_precision)
             .SetX2Min(0.0)
             .SetX2Max(1.0)
             .SetRomberg1(def.order_of_interpolation)
@@ -132,6 +141,7 @@ void IonizInterpolant::InitdNdxInterpolation(const InterpolationDef& def)
 
         builder1d[i]
             .SetMax(def.nodes_cross_section)
+            .SetPrecision(def.interpolation_precision)
             .SetXMin(parametrization_->GetParticleDef().mass)
             .SetXMax(def.max_node_energy)
             .SetRomberg(def.order_of_interpolation)
@@ -219,8 +229,10 @@ double IonizInterpolant::FunctionToBuildDNdxInterpolant2D(double energy, double
 
     v = limits.vUp * std::exp(v * std::log(limits.vMax / limits.vUp));
 
-    return integral.Integrate(
-        limits.vUp, v, std::bind(&Parametrization::FunctionToDNdxIntegral, parametrization_, energy, std::placeholders::_1), 3, 1);
+    return integral.IntegrateBatch(
+        limits.vUp, v,
+        [this, energy](const double* x, double* out, size_t n) { parametrization_->FunctionToDNdxIntegral(energy, x, out, n); },
+        3, 1);
 }
 
 // ------------------------------------------------------------------------- //
@@ -243,8 +255,7 @@ double IonizInterpolant::CalculateStochasticLoss(double energy, double rnd1)
             {
                 return energy * limits.vUp;
             }
-            return energy * (limits.vUp * std::exp(dndx_interpolant_2d_[0]->FindLimit(energy, rnd1 * sum_of_rates_) *
-                                              std::log(limits.vMax / limits.vUp)));
+            return energy * CalculateRelativeLoss(energy, 0, rnd1, sum_of_rates_);
         }
     }
 
@@ -31,16 +31,6 @@ MupairIntegral::~MupairIntegral() {}
 // Public methods
 // ----------------------------------------------------------------- //
 
-double MupairIntegral::CalculatedEdx(double energy)
-{
-    if (parametrization_->GetMultiplier() <= 0)
-    {
-        return 0;
-    }
-
-    return parametrization_->GetMultiplier() * MupairIntegral::CalculatedEdxWithoutMultiplier(energy);
-}
-
 double MupairIntegral::CalculatedEdxWithoutMultiplier(double energy)
 {
     double sum = 0;
@@ -50,10 +40,10 @@ double MupairIntegral::CalculatedEdxWithoutMultiplier(double energy)
         parametrization_->SetCurrentComponent(i);
         Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
 
-        sum += dedx_integral_.Integrate(
+        sum += dedx_integral_.IntegrateBatch(
             limits.vMin,
             limits.vUp,
-            std::bind(&Parametrization::FunctionToDEdxIntegral, parametrization_, energy, std::placeholders::_1),
+            [this, energy](const double* v, double* out, size_t n) { parametrization_->FunctionToDEdxIntegral(energy, v, out, n); },
             4);
     }
 
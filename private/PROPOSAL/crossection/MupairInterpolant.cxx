@@ -1,5 +1,9 @@
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
+#include <map>
+#include <utility>
 
 #include "PROPOSAL/crossection/MupairIntegral.h"
 #include "PROPOSAL/crossection/MupairInterpolant.h"
@@ -33,6 +37,7 @@ MupairInterpolant::MupairInterpolant(const MupairProduction& param, Interpolatio
     MupairIntegral mupair(param);
 
     builder1d.SetMax(def.nodes_cross_section)
+        .SetPrecision(def.interpolation_precision)
         .SetXMin(param.GetParticleDef().mass)
         .SetXMax(def.max_node_energy)
         .SetRomberg(def.order_of_interpolation)
@@ -55,6 +60,7 @@ MupairInterpolant::MupairInterpolant(const MupairProduction& param, Interpolatio
     Helper::InterpolantBuilderContainer builder_container_de2dx;
 
     builder_de2dx.SetMax(def.nodes_continous_randomization)
+        .SetPrecision(def.interpolation_precision)
         .SetXMin(param.GetParticleDef().mass)
         .SetXMax(def.max_node_energy)
         .SetRomberg(def.order_of_interpolation)
@@ -73,18 +79,42 @@ MupairInterpolant::MupairInterpolant(const MupairProduction& param, Interpolatio
     Helper::InitializeInterpolation(
         "dE2dx", builder_container_de2dx, std::vector<Parametrization*>(1, parametrization_), def);
 
+    if (param.IsParticleOutputEnabled())
+    {
+        InitRhoInterpolation(def);
+    }
+
     muminus_def_ = &MuMinusDef::Get();
     muplus_def_ = &MuPlusDef::Get();
 }
 
 MupairInterpolant::MupairInterpolant(const MupairInterpolant& mupair)
     : CrossSectionInterpolant(mupair)
+    , rho_interpolant_()
     , muminus_def_(mupair.muminus_def_)
     , muplus_def_(mupair.muplus_def_)
 {
+    rho_interpolant_.reserve(mupair.rho_interpolant_.size());
+    for (const InterpolantVec& interpolants : mupair.rho_interpolant_)
+    {
+        rho_interpolant_.push_back(InterpolantVec());
+        for (Interpolant* interpolant : interpolants)
+        {
+            rho_interpolant_.back().push_back(new Interpolant(*interpolant));
+        }
+    }
 }
 
-MupairInterpolant::~MupairInterpolant() {}
+MupairInterpolant::~MupairInterpolant()
+{
+    for (InterpolantVec& interpolants : rho_interpolant_)
+    {
+        for (Interpolant* interpolant : interpolants)
+        {
+            delete interpolant;
+        }
+    }
+}
 
 // ----------------------------------------------------------------- //
 // Public methods
@@ -117,7 +147,7 @@ std::pair<std::vector<DynamicData>, bool> MupairInterpolant::CalculateProducedPa
     double rnd2 = RandomGenerator::Get().RandomDouble();
 
     //Sample and assign energies
-    double rho = parametrization_->Calculaterho(energy, energy_loss/energy, rnd1, rnd2);
+    double rho = Calculaterho(energy, energy_loss/energy, rnd1, rnd2);
 
     mupair[0].SetEnergy(0.5*energy_loss*(1 + rho));
     mupair[1].SetEnergy(0.5*energy_loss*(1 - rho));
@@ -135,3 +165,140 @@ InteractionType MupairInterpolant::GetType(const MupairProduction& param){
         return InteractionType::MuPair;
     }
 }
+
+// ------------------------------------------------------------------------- //
+// Tabulated rho sampling
+// ------------------------------------------------------------------------- //
+
+// ------------------------------------------------------------------------- //
+void MupairInterpolant::InitRhoInterpolation(const InterpolationDef& def)
+{
+    // inner nodes of the random number, see FunctionToBuildRhoInterpolant
+    int nodes = def.nodes_cross_section / 5;
+
+    std::vector<Interpolant2DBuilder> builder2d(components_.size() * nodes);
+    Helper::InterpolantBuilderContainer builder_container2d(components_.size() * nodes);
+
+    rho_interpolant_.assign(components_.size(), InterpolantVec(nodes, NULL));
+
+    // All nodes of one (energy, t) point come from the same inversion, so they
+    // are computed once and shared between the tables of a component. This
+    // requires the same equidistant grid for all tables, they are not adapted.
+    std::vector<std::map<std::pair<double, double>, std::vector<double>>> cache(components_.size());
+
+    for (unsigned int i = 0; i < components_.size(); ++i)
+    {
+        for (int k = 0; k < nodes; ++k)
+        {
+            Interpolant2DBuilder& builder = builder2d[i * nodes + k];
+
+            builder.SetMax1(def.nodes_cross_section)
+                .SetX1Min(parametrization_->GetParticleDef().mass)
+                .SetX1Max(def.max_node_energy)
+                .SetMax2(def.nodes_cross_section)
+                .SetX2Min(0.0)
+                .SetX2Max(1.0)
+                .SetRomberg1(def.order_of_interpolation)
+                .SetRational1(false)
+                .SetRelative1(false)
+                .SetIsLog1(true)
+                .SetRomberg2(def.order_of_interpolation)
+                .SetRational2(false)
+                .SetRelative2(false)
+                .SetIsLog2(false)
+                .SetRombergY(def.order_of_interpolation)
+                .SetRationalY(false)
+                .SetRelativeY(false)
+                .SetLogSubst(false)
+                .SetFunction2D([this, &cache, i, k, nodes](double energy, double t) {
+                    std::vector<double>& rho = cache[i][std::make_pair(energy, t)];
+                    if (rho.empty())
+                    {
+                        rho = FunctionToBuildRhoInterpolant(energy, t, i, nodes);
+                    }
+                    return rho[k];
+                });
+
+            builder_container2d[i * nodes + k].first  = &builder;
+            builder_container2d[i * nodes + k].second = &rho_interpolant_[i][k];
+        }
+    }
+
+    Helper::InitializeInterpolation(
+        "MupairRho", builder_container2d, std::vector<Parametrization*>(1, parametrization_), def);
+}
+
+// ------------------------------------------------------------------------- //
+std::vector<double> MupairInterpolant::FunctionToBuildRhoInterpolant(double energy, double t, int component, int nodes)
+{
+    std::vector<double> rho(nodes, 0.);
+
+    parametrization_->SetCurrentComponent(component);
+    Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
+
+    double v       = limits.vMin * std::pow(limits.vMax / limits.vMin, t);
+    double rho_max = 1 - 2 * MMU / (v * energy);
+
+    if (rho_max <= 0)
+    {
+        return rho;
+    }
+
+    // The nodes are equidistant in u = 1 - sqrt(1 - rnd), which puts more of
+    // them towards rho_max where the inverse distribution is steep.
+    for (int k = 0; k < nodes; ++k)
+    {
+        double u   = 1 - static_cast<double>(k + 1) / (nodes + 1);
+        double rnd = 1 - u * u;
+        rho[k]     = parametrization_->Calculaterho(energy, v, rnd, 1.) / rho_max;
+    }
+
+    return rho;
+}
+
+// ------------------------------------------------------------------------- //
+double MupairInterpolant::Calculaterho(double energy, double v, double rnd1, double rnd2)
+{
+    if (rho_interpolant_.empty())
+    {
+        return parametrization_->Calculaterho(energy, v, rnd1, rnd2);
+    }
+
+    double rho_max = 1 - 2 * MMU / (v * energy);
+
+    if (rho_max <= 0)
+    {
+        return 0;
+    }
+
+    int component = parametrization_->GetCurrentComponent();
+    Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
+
+    double t = 0;
+    if (limits.vMax > limits.vMin)
+    {
+        t = std::log(v / limits.vMin) / std::log(limits.vMax / limits.vMin);
+        t = std::min(std::max(t, 0.), 1.);
+    }
+
+    // linear interpolation between the random number nodes, the outer
+    // nodes rnd = 0 and rnd = 1 are rho = 0 and rho = rho_max
+    const InterpolantVec& interpolants = rho_interpolant_[component];
+    int nodes = interpolants.size();
+
+    double x = (1 - std::sqrt(1 - rnd1)) * (nodes + 1);
+    int k    = std::min(static_cast<int>(x), nodes);
+    double f = x - k;
+
+    double lower = (k == 0) ? 0. : interpolants[k - 1]->Interpolate(energy, t);
+    double upper = (k == nodes) ? 1. : interpolants[k]->Interpolate(energy, t);
+
+    double rho = rho_max * std::min(std::max((1 - f) * lower + f * upper, 0.), 1.);
+
+    if (rnd2 < 0.5)
+    {
+        rho = -rho;
+    }
+
+    return rho;
+}
@@ -24,16 +24,6 @@ PhotoIntegral::~PhotoIntegral() {}
 // Public methods
 // ----------------------------------------------------------------- //
 
-double PhotoIntegral::CalculatedEdx(double energy)
-{
-    if (parametrization_->GetMultiplier() <= 0)
-    {
-        return 0;
-    }
-
-    return parametrization_->GetMultiplier() * PhotoIntegral::CalculatedEdxWithoutMultiplier(energy);
-}
-
 double PhotoIntegral::CalculatedEdxWithoutMultiplier(double energy)
 {
     double sum = 0;
@@ -43,11 +33,16 @@ double PhotoIntegral::CalculatedEdxWithoutMultiplier(double energy)
         parametrization_->SetCurrentComponent(i);
         Parametrization::IntegralLimits limits = parametrization_->GetIntegralLimits(energy);
 
-        sum += dedx_integral_.Integrate(
-            limits.vMin,
-            limits.vUp,
-            std::bind(&Parametrization::FunctionToDEdxIntegral, parametrization_, energy, std::placeholders::_1),
-            4);
+        double integral = 0;
+        if (!parametrization_->IntegrateDifferentialCrossSection(energy, limits.vMin, limits.vUp, 1, integral))
+        {
+            integral = dedx_integral_.IntegrateBatch(
+                limits.vMin,
+                limits.vUp,
+                [this, energy](const double* v, double* out, size_t n) { parametrization_->FunctionToDEdxIntegral(energy, v, out, n); },
+                4);
+        }
+        sum += integral;
     }
 
     return energy * sum;
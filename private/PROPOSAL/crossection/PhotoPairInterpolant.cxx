@@ -153,12 +153,14 @@ void PhotoPairInterpolant::InitdNdxInterpolation(const InterpolationDef& def)
 
     Helper::InterpolantBuilderContainer builder_container1d(components_.size());
     Helper::InterpolantBuilderContainer builder_container2d(components_.size());
-    Helper::InterpolantBuilderContainer builder_return;
 
     Integral integral(IROMB, IMAXS, IPREC);
+    integral.SetQuadrature(parametrization_->GetQuadrature());
 
     for (unsigned int i = 0; i < components_.size(); ++i)
     {
+        double normalization = GetComponentNormalization(i);
+
         // !!! IMPORTANT !!!
         // Order of builder matter because the functions needed for 1d interpolation
         // needs the already intitialized 2d interpolants.
@@ -167,6 +169,7 @@ void PhotoPairInterpolant::InitdNdxInterpolation(const InterpolationDef& def)
                 .SetX1Min(ME)
                 .SetX1Max(def.max_node_energy)
                 .SetMax2(def.nodes_cross_section)
+                .SetPrecision(def.interpolation_precision)
                 .SetX2Min(0.0)
                 .SetX2Max(1.0)
                 .SetRomberg1(def.order_of_interpolation)
@@ -181,19 +184,16 @@ void PhotoPairInterpolant::InitdNdxInterpolation(const InterpolationDef& def)
                 .SetRationalY(true)
                 .SetRelativeY(false)
                 .SetLogSubst(false)
-                .SetFunction2D(std::bind(
-                        &CrossSectionInterpolant::FunctionToBuildDNdxInterpolant2D,
-                        this,
-                        std::placeholders::_1,
-                        std::placeholders::_2,
-                        std::ref(integral),
-                        i));
+                .SetFunction2D([this, &integral, i, normalization](double energy, double v) {
+                    return FunctionToBuildDNdxInterpolant2D(energy, v, integral, i) / normalization;
+                });
 
         builder_container2d[i].first  = &builder2d[i];
         builder_container2d[i].second = &dndx_interpolant_2d_[i];
 
         builder1d[i]
                 .SetMax(def.nodes_cross_section)
+                .SetPrecision(def.interpolation_precision)
                 .SetXMin(ME)
                 .SetXMax(def.max_node_energy)
                 .SetRomberg(def.order_of_interpolation)
@@ -210,9 +210,5 @@ void PhotoPairInterpolant::InitdNdxInterpolation(const InterpolationDef& def)
         builder_container1d[i].second = &dndx_interpolant_1d_[i];
     }
 
-    builder_return.insert(builder_return.end(), builder_container2d.begin(), builder_container2d.end());
-    builder_return.insert(builder_return.end(), builder_container1d.begin(), builder_container1d.end());
-    // builder2d.insert(builder2d.end(), builder1d.begin(), builder1d.end());
-
-    Helper::InitializeInterpolation("dNdx", builder_return, std::vector<Parametrization*>(1, parametrization_), def);
+    InitializeComponentInterpolation("dNdx", builder_container2d, builder_container1d, true, def);
 }
@@ -45,6 +45,7 @@ CrossSection* AnnihilationFactory::CreateAnnihilation(const ParticleDef& particl
     if (it != annihilation_map_enum_.end())
     {
         std::unique_ptr<Annihilation> param(it->second(particle_def, medium, def.multiplier)); 
+        param->SetQuadrature(def.quadrature);
         return new AnnihilationIntegral(*param);
     } else
     {
@@ -69,6 +70,7 @@ CrossSection* AnnihilationFactory::CreateAnnihilation(const ParticleDef& particl
     if (it != annihilation_map_enum_.end())
     {
         std::unique_ptr<Annihilation> param(it->second(particle_def, medium, def.multiplier)); 
+        param->SetQuadrature(def.quadrature);
         return new AnnihilationInterpolant(*param, interpolation_def);
     } else
     {
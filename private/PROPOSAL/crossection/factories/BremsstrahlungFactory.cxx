@@ -62,6 +62,7 @@ CrossSection* BremsstrahlungFactory::CreateBremsstrahlung(const ParticleDef& par
     if (it != bremsstrahlung_map_enum_.end())
     {
         std::unique_ptr<Bremsstrahlung> param(it->second(particle_def, medium, cuts, def.multiplier, def.lpm_effect)); 
+        param->SetQuadrature(def.quadrature);
         return new BremsIntegral(*param);
     } else
     {
@@ -87,6 +88,7 @@ CrossSection* BremsstrahlungFactory::CreateBremsstrahlung(const ParticleDef& par
     if (it != bremsstrahlung_map_enum_.end())
     {
         std::unique_ptr<Bremsstrahlung> param(it->second(particle_def, medium, cuts, def.multiplier, def.lpm_effect)); 
+        param->SetQuadrature(def.quadrature);
         return new BremsInterpolant(*param, interpolation_def);
     } else
     {
@@ -57,6 +57,7 @@ CrossSection* ComptonFactory::CreateCompton(const ParticleDef& particle_def,
     if (it != compton_map_enum_.end())
     {
         std::unique_ptr<Compton> param(it->second(particle_def, medium, cuts, def.multiplier));
+        param->SetQuadrature(def.quadrature);
         return new ComptonIntegral(*param);
     } else
     {
@@ -82,6 +83,7 @@ CrossSection* ComptonFactory::CreateCompton(const ParticleDef& particle_def,
     if (it != compton_map_enum_.end())
     {
         std::unique_ptr<Compton> param(it->second(particle_def, medium, cuts, def.multiplier));
+        param->SetQuadrature(def.quadrature);
         return new ComptonInterpolant(*param, interpolation_def);
     } else
     {
@@ -47,6 +47,7 @@ CrossSection* EpairProductionFactory::CreateEpairProduction(const ParticleDef& p
     if (it != epair_map_enum_.end())
     {
         std::unique_ptr<EpairProduction> param(it->second.first(particle_def, medium, cuts, def.multiplier, def.lpm_effect));
+        param->SetQuadrature(def.quadrature);
         return new EpairIntegral(*param);
     } else
     {
@@ -72,6 +73,7 @@ CrossSection* EpairProductionFactory::CreateEpairProduction(const ParticleDef& p
     if (it != epair_map_enum_.end())
     {
         std::unique_ptr<EpairProduction> param(it->second.second(particle_def, medium, cuts, def.multiplier, def.lpm_effect, interpolation_def));
+        param->SetQuadrature(def.quadrature);
         return new EpairInterpolant(*param, interpolation_def);
     } else
     {
@@ -55,6 +55,7 @@ CrossSection* IonizationFactory::CreateIonization(const ParticleDef& particle_de
     if (it != ioniz_map_enum_.end())
     {
         std::unique_ptr<Ionization> param(it->second(particle_def, medium, cuts, def.multiplier)); 
+        param->SetQuadrature(def.quadrature);
         return new IonizIntegral(*param);;
     } else
     {
@@ -80,6 +81,7 @@ CrossSection* IonizationFactory::CreateIonization(const ParticleDef& particle_de
     if (it != ioniz_map_enum_.end())
     {
         std::unique_ptr<Ionization> param(it->second(particle_def, medium, cuts, def.multiplier));        
+        param->SetQuadrature(def.quadrature);
         return new IonizInterpolant(*param, interpolation_def);;
     } else
     {
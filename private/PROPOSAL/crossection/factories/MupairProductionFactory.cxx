@@ -46,6 +46,7 @@ CrossSection* MupairProductionFactory::CreateMupairProduction(const ParticleDef&
     if (it != mupair_map_enum_.end())
     {
         std::unique_ptr<MupairProduction> param(it->second.first(particle_def, medium, cuts, def.multiplier, def.particle_output)); 
+        param->SetQuadrature(def.quadrature);
         return new MupairIntegral(*param);
     } else
     {
@@ -71,6 +72,7 @@ CrossSection* MupairProductionFactory::CreateMupairProduction(const ParticleDef&
     if (it != mupair_map_enum_.end())
     {
         std::unique_ptr<MupairProduction> param(it->second.second(particle_def, medium, cuts, def.multiplier, def.particle_output, interpolation_def)); 
+        param->SetQuadrature(def.quadrature);
         return new MupairInterpolant(*param, interpolation_def);
     } else
     {
@@ -71,6 +71,7 @@ CrossSection* PhotoPairFactory::CreatePhotoPair(const ParticleDef& particle_def,
     {
         std::unique_ptr<PhotoAngleDistribution> photoangle(Get().CreatePhotoAngleDistribution(def.photoangle, particle_def, medium));
         std::unique_ptr<PhotoPairProduction> param(it->second(particle_def, medium, def.multiplier)); 
+        param->SetQuadrature(def.quadrature);
         return new PhotoPairIntegral(*param, *photoangle);;
     } else
     {
@@ -96,6 +97,7 @@ CrossSection* PhotoPairFactory::CreatePhotoPair(const ParticleDef& particle_def,
     {
         std::unique_ptr<PhotoAngleDistribution> photoangle(Get().CreatePhotoAngleDistribution(def.photoangle, particle_def, medium));
         std::unique_ptr<PhotoPairProduction> param(it->second(particle_def, medium, def.multiplier)); 
+        param->SetQuadrature(def.quadrature);
         return new PhotoPairInterpolant(*param, *photoangle, interpolation_def);;
     } else
     {
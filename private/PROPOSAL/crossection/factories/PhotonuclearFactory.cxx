@@ -145,10 +145,12 @@ CrossSection* PhotonuclearFactory::CreatePhotonuclear(const ParticleDef& particl
     {
         std::unique_ptr<ShadowEffect> shadow(Get().CreateShadowEffect(def.shadow));
         std::unique_ptr<Photonuclear> param(it_q2->second.first(particle_def, medium, cuts, def.multiplier, *shadow)); 
+        param->SetQuadrature(def.quadrature);
         return new PhotoIntegral(*param);
     } else if (it_photo != photo_real_map_enum_.end())
     {
         std::unique_ptr<Photonuclear> param(it_photo->second(particle_def, medium, cuts, def.multiplier, def.hard_component)); 
+        param->SetQuadrature(def.quadrature);
         return new PhotoIntegral(*param);
     } else
     {
@@ -176,10 +178,12 @@ CrossSection* PhotonuclearFactory::CreatePhotonuclear(const ParticleDef& particl
     {
         std::unique_ptr<ShadowEffect> shadow(Get().CreateShadowEffect(def.shadow));
         std::unique_ptr<Photonuclear> param(it_q2->second.second(particle_def, medium, cuts, def.multiplier, *shadow, interpolation_def)); 
+        param->SetQuadrature(def.quadrature);
         return new PhotoInterpolant(*param, interpolation_def);
     } else if (it_photo != photo_real_map_enum_.end())
     {
         std::unique_ptr<Photonuclear> param(it_photo->second(particle_def, medium, cuts, def.multiplier, def.hard_component)); 
+        param->SetQuadrature(def.quadrature);
         return new PhotoInterpolant(*param, interpolation_def);
     } else
     {
@@ -45,6 +45,7 @@ CrossSection* WeakInteractionFactory::CreateWeakInteraction(const ParticleDef& p
     if (it != weak_map_enum_.end())
     {
         std::unique_ptr<WeakInteraction> param(it->second(particle_def, medium, def.multiplier)); 
+        param->SetQuadrature(def.quadrature);
         return new WeakIntegral(*param);
     } else
     {
@@ -69,6 +70,7 @@ CrossSection* WeakInteractionFactory::CreateWeakInteraction(const ParticleDef& p
     if (it != weak_map_enum_.end())
     {
         std::unique_ptr<WeakInteraction> param(it->second(particle_def, medium, def.multiplier));
+        param->SetQuadrature(def.quadrature);
         return new WeakInterpolant(*param, interpolation_def);
     } else
     {
@@ -53,14 +53,23 @@ Parametrization::IntegralLimits Annihilation::GetIntegralLimits(double energy)
     return limits;
 }
 
-size_t Annihilation::GetHash() const
+size_t Annihilation::GetParametrizationHash() const
 {
-    size_t seed = Parametrization::GetHash();
+    size_t seed = Parametrization::GetParametrizationHash();
     hash_combine(seed);
 
     return seed;
 }
 
+size_t Annihilation::GetComponentHash(int component) const
+{
+    // the cross section scales with the electron density of the whole medium
+    size_t seed = Parametrization::GetComponentHash(component);
+    hash_combine(seed, medium_->GetName());
+
+    return seed;
+}
+
 // ------------------------------------------------------------------------- //
 // Specific implementations
 // ------------------------------------------------------------------------- //
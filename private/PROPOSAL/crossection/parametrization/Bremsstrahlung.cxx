@@ -111,6 +111,43 @@ double Bremsstrahlung::DifferentialCrossSection(double energy, double v)
     return medium_->GetMolDensity() * components_[component_index_].GetAtomInMolecule() * aux;
 }
 
+// ------------------------------------------------------------------------- //
+void Bremsstrahlung::DifferentialCrossSection(double energy, const double* v, double* out, size_t n)
+{
+    CalculateParametrization(energy, v, out, n);
+
+    double prefactor = 2 * particle_def_.charge * particle_def_.charge * (ME / particle_def_.mass) * RE *
+                       components_[component_index_].GetNucCharge();
+    double density = medium_->GetMolDensity() * components_[component_index_].GetAtomInMolecule();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        out[i] = prefactor * (prefactor * (ALPHA / v[i]) * out[i]);
+    }
+
+    if (lpm_)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] *= lpm(energy, v[i]);
+        }
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        out[i] = density * out[i];
+    }
+}
+
+// ------------------------------------------------------------------------- //
+void Bremsstrahlung::CalculateParametrization(double energy, const double* v, double* out, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        out[i] = CalculateParametrization(energy, v[i]);
+    }
+}
+
 // ------------------------------------------------------------------------- //
 Parametrization::IntegralLimits Bremsstrahlung::GetIntegralLimits(double energy)
 {
@@ -164,9 +201,9 @@ double Bremsstrahlung::lpm(double energy, double v)
             Parametrization::IntegralLimits limits = GetIntegralLimits(upper_energy);
 
             sum += integral_temp.Integrate(
-                limits.vMin, limits.vUp, std::bind(&Bremsstrahlung::FunctionToDEdxIntegral, this, upper_energy, std::placeholders::_1), 2);
+                limits.vMin, limits.vUp, [this, upper_energy](double v) { return FunctionToDEdxIntegral(upper_energy, v); }, 2);
             sum += integral_temp.Integrate(
-                limits.vUp, limits.vMax, std::bind(&Bremsstrahlung::FunctionToDEdxIntegral, this, upper_energy, std::placeholders::_1), 4);
+                limits.vUp, limits.vMax, [this, upper_energy](double v) { return FunctionToDEdxIntegral(upper_energy, v); }, 4);
         }
 
         eLpm_ = ALPHA * (particle_def_.mass);
@@ -240,14 +277,27 @@ double Bremsstrahlung::lpm(double energy, double v)
 // Getter
 // ------------------------------------------------------------------------- //
 
-size_t Bremsstrahlung::GetHash() const
+size_t Bremsstrahlung::GetParametrizationHash() const
 {
-    size_t seed = Parametrization::GetHash();
+    size_t seed = Parametrization::GetParametrizationHash();
     hash_combine(seed, lpm_, lorenz_);
 
     return seed;
 }
 
+size_t Bremsstrahlung::GetComponentHash(int component) const
+{
+    size_t seed = Parametrization::GetComponentHash(component);
+
+    // the lpm suppression depends on the whole medium
+    if (lpm_)
+    {
+        hash_combine(seed, medium_->GetName());
+    }
+
+    return seed;
+}
+
 // ------------------------------------------------------------------------- //
 // Print
 // ------------------------------------------------------------------------- //
@@ -360,6 +410,54 @@ double BremsKelnerKokoulinPetrukhin::CalculateParametrization(double energy, dou
     return result;
 }
 
+// ------------------------------------------------------------------------- //
+// Batch form of the parametrization above. Everything not depending on v is
+// evaluated once, the loop body is free of calls except for the logarithms.
+// ------------------------------------------------------------------------- //
+
+void BremsKelnerKokoulinPetrukhin::CalculateParametrization(double energy, const double* v, double* out, size_t n)
+{
+    const Components::Component& component = components_[component_index_];
+
+    double mass         = particle_def_.mass;
+    double charge       = component.GetNucCharge();
+    double log_constant = component.GetLogConstant();
+    double b_prime      = component.GetBPrime();
+
+    double Z3 = std::pow(charge, -1. / 3);
+    double Dn = 1.54 * std::pow(component.GetAtomicNum(), 0.27);
+
+    double square_momentum   = (energy - mass) * (energy + mass);
+    double particle_momentum = std::sqrt(std::max(square_momentum, 0.0));
+    double maxV              = ME * (energy - mass) / (energy * (energy - particle_momentum + ME));
+
+    // no inelastic nuclear contribution for Hydrogen, see the scalar version
+    bool nuclear_inelastic = (charge != 1);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double vi = v[i];
+
+        double delta = mass * mass * vi / (2 * energy * (1 - vi));
+
+        double formfactor_atomic_elastic  = std::log(1 + ME / (delta * SQRTE * log_constant * Z3));
+        double formfactor_nuclear_elastic = std::log(Dn / (1 + delta * (Dn * SQRTE - 2) / mass));
+
+        double formfactor_atomic_inelastic = 0.;
+        if (vi < maxV)
+        {
+            formfactor_atomic_inelastic = std::log(mass / (delta * (delta * mass / (ME * ME) + SQRTE))) -
+                                          std::log(1 + ME / (delta * SQRTE * b_prime * Z3 * Z3));
+        }
+
+        double formfactor_nuclear_inelastic = nuclear_inelastic ? formfactor_nuclear_elastic : 0.;
+
+        out[i] = ((4. / 3) * (1 - vi) + vi * vi) *
+                 (std::log(mass / delta) - 0.5 - formfactor_atomic_elastic - formfactor_nuclear_elastic +
+                  (formfactor_nuclear_inelastic + formfactor_atomic_inelastic) / charge);
+    }
+}
+
 // ------------------------------------------------------------------------- //
 // CompleteScreening parametrization (by Tsai)
 // Rev. Mod. Phys. 46 (1974), 815
@@ -627,6 +725,12 @@ double BremsElectronScreening::DifferentialCrossSection(double energy, double v)
     return medium_->GetMolDensity() * components_[component_index_].GetAtomInMolecule() * aux;
 }
 
+// the batch form of Bremsstrahlung would use the wrong prefactor
+void BremsElectronScreening::DifferentialCrossSection(double energy, const double* v, double* out, size_t n)
+{
+    Parametrization::DifferentialCrossSection(energy, v, out, n);
+}
+
 double BremsElectronScreening::CalculateParametrization(double energy, double v)
 {
 
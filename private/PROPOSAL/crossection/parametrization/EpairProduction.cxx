@@ -1,4 +1,5 @@
 
+#include <algorithm>
 #include <cmath>
 
 #include "PROPOSAL/crossection/parametrization/EpairProduction.h"
@@ -177,6 +178,7 @@ EpairProductionRhoIntegral::EpairProductionRhoIntegral(const ParticleDef& partic
                                                        bool lpm)
     : EpairProduction(particle_def, medium, cuts, multiplier, lpm)
     , integral_(IROMB, IMAXS, IPREC)
+    , cubature_()
 {
 }
 
@@ -184,6 +186,7 @@ EpairProductionRhoIntegral::EpairProductionRhoIntegral(const ParticleDef& partic
 EpairProductionRhoIntegral::EpairProductionRhoIntegral(const EpairProductionRhoIntegral& epair)
     : EpairProduction(epair)
     , integral_(epair.integral_)
+    , cubature_(epair.cubature_)
 {
 }
 
@@ -219,12 +222,73 @@ double EpairProductionRhoIntegral::DifferentialCrossSection(double energy, doubl
 
     aux = std::max(1 - rMax, COMPUTER_PRECISION);
 
+    auto integrand = [this, energy, v](const double* rho, double* out, size_t n) {
+        FunctionToIntegral(energy, v, rho, out, n);
+    };
+
     return medium_->GetMolDensity() * components_[component_index_].GetAtomInMolecule() *
            particle_def_.charge * particle_def_.charge *
-           (integral_.Integrate(
-                1 - rMax, aux, std::bind(&EpairProductionRhoIntegral::FunctionToIntegral, this, energy, v, std::placeholders::_1), 2) +
-            integral_.Integrate(
-                aux, 1, std::bind(&EpairProductionRhoIntegral::FunctionToIntegral, this, energy, v, std::placeholders::_1), 4));
+           (integral_.IntegrateBatch(1 - rMax, aux, integrand, 2) + integral_.IntegrateBatch(aux, 1, integrand, 4));
+}
+
+// ------------------------------------------------------------------------- //
+bool EpairProductionRhoIntegral::IntegrateDifferentialCrossSection(double energy,
+                                                                   double v_min,
+                                                                   double v_max,
+                                                                   int moment,
+                                                                   double& result)
+{
+    if (quadrature_ != Integral::Cubature)
+    {
+        return false;
+    }
+
+    double prefactor = medium_->GetMolDensity() * components_[component_index_].GetAtomInMolecule() *
+                       particle_def_.charge * particle_def_.charge;
+
+    auto integrand = [&](double v, const double* u, double* out, size_t n) {
+        double rMax, aux, aux2;
+
+        aux  = 1 - (4 * ME) / (energy * v);
+        aux2 = 1 - (6 * particle_def_.mass * particle_def_.mass) / (energy * energy * (1 - v));
+
+        if (aux > 0 && aux2 > 0)
+        {
+            rMax = std::sqrt(aux) * aux2;
+        } else
+        {
+            std::fill(out, out + n, 0.);
+            return;
+        }
+
+        // The part below ComputerPrecision, integrated linearly in
+        // DifferentialCrossSection, is negligible. r = r_low^(1 - u)
+        double log_low = std::log(std::max(1 - rMax, COMPUTER_PRECISION));
+        double r[Cubature::max_points_per_line] = {};
+        for (size_t i = 0; i < n; ++i)
+        {
+            r[i] = std::exp((1 - u[i]) * log_low);
+        }
+
+        FunctionToIntegral(energy, v, r, out, n);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] *= -prefactor * r[i] * log_low;
+        }
+    };
+
+    result = IntegrateWithCubature(cubature_, v_min, v_max, moment, integrand);
+    return true;
+}
+
+// ------------------------------------------------------------------------- //
+void EpairProductionRhoIntegral::FunctionToIntegral(double energy, double v, const double* rho, double* out, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        out[i] = FunctionToIntegral(energy, v, rho[i]);
+    }
 }
 
 // ------------------------------------------------------------------------- //
@@ -234,14 +298,35 @@ void EpairProductionRhoIntegral::print(std::ostream& os) const
 }
 
 // ------------------------------------------------------------------------- //
-size_t EpairProductionRhoIntegral::GetHash() const
+size_t EpairProductionRhoIntegral::GetParametrizationHash() const
 {
-    size_t seed = Parametrization::GetHash();
+    size_t seed = Parametrization::GetParametrizationHash();
     hash_combine(seed, lpm_);
 
     return seed;
 }
 
+// ------------------------------------------------------------------------- //
+void EpairProductionRhoIntegral::SetQuadrature(Integral::Quadrature quadrature)
+{
+    Parametrization::SetQuadrature(quadrature);
+    integral_.SetQuadrature(quadrature);
+}
+
+// ------------------------------------------------------------------------- //
+size_t EpairProductionRhoIntegral::GetComponentHash(int component) const
+{
+    size_t seed = Parametrization::GetComponentHash(component);
+
+    // the lpm suppression depends on the whole medium
+    if (lpm_)
+    {
+        hash_combine(seed, medium_->GetName());
+    }
+
+    return seed;
+}
+
 /******************************************************************************
  *                          Specifc Parametrizations                           *
  ******************************************************************************/
@@ -365,6 +450,104 @@ double EpairKelnerKokoulinPetrukhin::FunctionToIntegral(double energy, double v,
     return aux;
 }
 
+// ------------------------------------------------------------------------- //
+// Batch form of the integrand above. All terms independent of rho are
+// evaluated once for the whole block.
+// ------------------------------------------------------------------------- //
+void EpairKelnerKokoulinPetrukhin::FunctionToIntegral(double energy, double v, const double* rho, double* out, size_t n)
+{
+    double medium_charge       = components_[component_index_].GetNucCharge();
+    double medium_log_constant = components_[component_index_].GetLogConstant();
+
+    double Z3   = std::pow(medium_charge, -1. / 3);
+    double aux  = (particle_def_.mass * v) / (2 * ME);
+    double xi0  = aux * aux;
+    double beta = (v * v) / (2 * (1 - v));
+
+    // constants of the L_e and L_mu expressions
+    double aux_l        = (1.5 * ME) / (particle_def_.mass * Z3);
+    double aux_l2       = aux_l * aux_l;
+    double log_z3       = medium_log_constant * Z3;
+    double log_z3_mu    = medium_log_constant / aux_l * Z3;
+    double screening    = 2 * ME * SQRTE * medium_log_constant * Z3;
+    double energy_v     = energy * v;
+
+    // contribution of atomic electrons, see the scalar version
+    double g1, g2;
+    if (medium_charge == 1)
+    {
+        g1 = 4.4e-5;
+        g2 = 4.8e-5;
+    } else
+    {
+        g1 = 1.95e-5;
+        g2 = 5.3e-5;
+    }
+
+    aux         = energy / particle_def_.mass;
+    double aux1 = 0.073 * std::log(aux / (1 + g1 * aux / (Z3 * Z3))) - 0.26;
+    double aux2 = 0.058 * std::log(aux / (1 + g2 * aux / Z3)) - 0.14;
+
+    double atomic_electron_contribution = (aux1 > 0 && aux2 > 0) ? aux1 / aux2 : 0;
+
+    double prefactor = ALPHA * RE * particle_def_.charge;
+    prefactor *= prefactor / (1.5 * PI) * 2 * medium_charge * (medium_charge + atomic_electron_contribution);
+    aux1             = ME / particle_def_.mass * particle_def_.charge;
+    double mu_factor = aux1 * aux1;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double r  = 1 - rho[i];
+        double r2 = r * r;
+        double xi = xi0 * (1 - r2) / (1 - v);
+
+        double diagram_e =
+            (5 - r2 + 4 * beta * (1 + r2)) / (2 * (1 + 3 * beta) * std::log(3 + 1 / xi) - r2 - 2 * beta * (2 - r2));
+        double diagram_mu =
+            (4 + r2 + 3 * beta * (1 + r2)) / ((1 + r2) * (1.5 + 2 * beta) * std::log(3 + xi) + 1 - 1.5 * r2);
+
+        double aux_e  = (1 + xi) * (1 + diagram_e);
+        double aux_r2 = screening / (energy_v * (1 - r2));
+        diagram_e     = std::log((log_z3 * std::sqrt(aux_e)) / (1 + aux_r2 * aux_e)) - 0.5 * std::log(1 + aux_l2 * aux_e);
+        diagram_mu    = std::log(log_z3_mu / (1 + aux_r2 * (1 + xi) * (1 + diagram_mu)));
+
+        if (diagram_e > 0)
+        {
+            if (1 / xi < HALF_PRECISION)
+            {
+                diagram_e = (1.5 - r2 / 2 + beta * (1 + r2)) / xi * diagram_e;
+            } else
+            {
+                diagram_e = (((2 + r2) * (1 + beta) + xi * (3 + r2)) * std::log(1 + 1 / xi) + (1 - r2 - beta) / (1 + xi) -
+                             (3 + r2)) *
+                            diagram_e;
+            }
+        } else
+        {
+            diagram_e = 0;
+        }
+
+        if (diagram_mu > 0)
+        {
+            diagram_mu = (((1 + r2) * (1 + 1.5 * beta) - (1 + 2 * beta) * (1 - r2) / xi) * std::log(1 + xi) +
+                          xi * (1 - r2 - beta) / (1 + xi) + (1 + 2 * beta) * (1 - r2)) *
+                         diagram_mu;
+        } else
+        {
+            diagram_mu = 0;
+        }
+
+        double result = prefactor * ((1 - v) / v * (diagram_e + mu_factor * diagram_mu));
+
+        if (lpm_)
+        {
+            result *= lpm(energy, v, r2, beta, xi);
+        }
+
+        out[i] = std::max(result, 0.);
+    }
+}
+
 // ------------------------------------------------------------------------- //
 double EpairSandrockSoedingreksoRhode::FunctionToIntegral(double energy, double v, double rho)
 {
@@ -1,4 +1,5 @@
 
+#include <algorithm>
 #include <cmath>
 
 #include "PROPOSAL/crossection/parametrization/Ionization.h"
@@ -6,6 +7,7 @@
 #include "PROPOSAL/Constants.h"
 #include "PROPOSAL/math/Integral.h"
 #include "PROPOSAL/medium/Medium.h"
+#include "PROPOSAL/methods.h"
 
 using namespace PROPOSAL;
 
@@ -32,6 +34,25 @@ Ionization::Ionization(const Ionization& ioniz)
 
 Ionization::~Ionization() {}
 
+// ------------------------------------------------------------------------- //
+size_t Ionization::GetComponentHash(int component) const
+{
+    // ionization is calculated for the whole medium
+    size_t seed = Parametrization::GetComponentHash(component);
+    hash_combine(seed, medium_->GetName());
+
+    return seed;
+}
+
+// ------------------------------------------------------------------------- //
+void Ionization::FunctionToDEdxIntegral(double energy, const double* v, double* out, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        out[i] = FunctionToDEdxIntegral(energy, v[i]);
+    }
+}
+
 // ------------------------------------------------------------------------- //
 double Ionization::Delta(double beta, double gamma) {
     /* std::shared_ptr<const Medium> medium = this->GetMedium(); */
@@ -178,6 +199,106 @@ double IonizBetheBlochRossi::FunctionToDEdxIntegral(double energy, double variab
     return result / energy + variable * CrossSectionWithoutInelasticCorrection(energy, variable) * InelCorrection(energy, variable);
 }
 
+// ------------------------------------------------------------------------- //
+// Batch forms of the cross section and the dEdx integrand. The limits and
+// the kinematic prefactors only depend on the energy and are evaluated once,
+// the loops over v are free of branches and calls.
+// ------------------------------------------------------------------------- //
+void IonizBetheBlochRossi::DifferentialCrossSection(double energy, const double* v, double* out, size_t n)
+{
+    IntegralLimits limits = GetIntegralLimits(energy);
+
+    double square_momentum   = (energy - particle_def_.mass) * (energy + particle_def_.mass);
+    double particle_momentum = std::sqrt(std::max(square_momentum, 0.0));
+    double beta              = particle_momentum / energy;
+    double gamma             = energy / particle_def_.mass;
+    beta *= beta;
+
+    double norm    = IONK * particle_def_.charge * particle_def_.charge * medium_->GetZA();
+    double denom   = 2 * beta * energy;
+    double density = medium_->GetMassDensity();
+    double mass    = particle_def_.mass;
+    double v_max   = limits.vMax;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double vi = v[i];
+
+        double spin_1_2_contribution = vi / (1 + 1 / gamma);
+        spin_1_2_contribution *= 0.5 * spin_1_2_contribution;
+        double result = 1 - beta * (vi / v_max) + spin_1_2_contribution;
+        result *= norm / (denom * vi * vi);
+
+        // InelCorrection
+        double a = std::log(1 + 2 * vi * energy / ME);
+        double b = std::log((1 - vi / v_max) / (1 - vi));
+        double c = std::log((2 * gamma * (1 - vi) * ME) / (mass * vi));
+
+        out[i] = density * result * (1 + ALPHA / (2 * PI) * (a * (2 * b + c) - b * b));
+    }
+}
+
+// ------------------------------------------------------------------------- //
+void IonizBetheBlochRossi::FunctionToDEdxIntegral(double energy, const double* v, double* out, size_t n)
+{
+    Parametrization::IntegralLimits limits = GetIntegralLimits(energy);
+
+    if (limits.vUp == limits.vMin)
+    {
+        std::fill(out, out + n, 0.);
+        return;
+    }
+
+    // v independent part, see the scalar version
+    double square_momentum   = (energy - particle_def_.mass) * (energy + particle_def_.mass);
+    double particle_momentum = std::sqrt(std::max(square_momentum, 0.0));
+    double beta              = particle_momentum / energy;
+    double gamma             = energy / particle_def_.mass;
+
+    double aux    = beta * gamma / (1.e-6 * medium_->GetI());
+    double result = std::log(limits.vUp * (2 * ME * energy)) + 2 * std::log(aux);
+    aux           = limits.vUp / (2 * (1 + 1 / gamma));
+    result += aux * aux;
+    aux = beta * beta;
+    result -= aux * (1 + limits.vUp / limits.vMax) + Delta(beta, gamma);
+
+    if (result > 0)
+    {
+        result *= IONK * particle_def_.charge * particle_def_.charge * medium_->GetZA() / (2 * aux);
+    } else
+    {
+        result = 0;
+    }
+
+    result *= medium_->GetMassDensity() / (limits.vUp - limits.vMin);
+    double offset = result / energy;
+
+    // v dependent part v * CrossSectionWithoutInelasticCorrection * InelCorrection
+    beta = aux;
+
+    double norm    = IONK * particle_def_.charge * particle_def_.charge * medium_->GetZA();
+    double denom   = 2 * beta * energy;
+    double density = medium_->GetMassDensity();
+    double mass    = particle_def_.mass;
+    double v_max   = limits.vMax;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double vi = v[i];
+
+        double spin_1_2_contribution = vi / (1 + 1 / gamma);
+        spin_1_2_contribution *= 0.5 * spin_1_2_contribution;
+        double cross_section = 1 - beta * (vi / v_max) + spin_1_2_contribution;
+        cross_section *= norm / (denom * vi * vi);
+
+        double a = std::log(1 + 2 * vi * energy / ME);
+        double b = std::log((1 - vi / v_max) / (1 - vi));
+        double c = std::log((2 * gamma * (1 - vi) * ME) / (mass * vi));
+
+        out[i] = offset + vi * (density * cross_section) * (ALPHA / (2 * PI) * (a * (2 * b + c) - b * b));
+    }
+}
+
 // ------------------------------------------------------------------------- //
 // Bremststrahlung when scattering at atomic electrons
 // and the atomic electrons emit the Bremsstrahlung photon
@@ -185,14 +185,21 @@ void MupairProductionRhoIntegral::print(std::ostream& os) const
 */
 
 // ------------------------------------------------------------------------- //
-size_t MupairProductionRhoIntegral::GetHash() const
+size_t MupairProductionRhoIntegral::GetParametrizationHash() const
 {
-    size_t seed = Parametrization::GetHash();
+    size_t seed = Parametrization::GetParametrizationHash();
     hash_combine(seed);
 
     return seed;
 }
 
+// ------------------------------------------------------------------------- //
+void MupairProductionRhoIntegral::SetQuadrature(Integral::Quadrature quadrature)
+{
+    Parametrization::SetQuadrature(quadrature);
+    integral_.SetQuadrature(quadrature);
+}
+
 /******************************************************************************
  *                          Specifc Parametrizations                           *
  ******************************************************************************/
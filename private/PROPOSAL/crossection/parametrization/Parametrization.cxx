@@ -20,7 +20,8 @@ Parametrization::Parametrization(const ParticleDef& particle_def,
       cut_settings_(cuts),
       components_(medium_->GetComponents()),
       component_index_(0),
-      multiplier_(multiplier) {}
+      multiplier_(multiplier),
+      quadrature_(Integral::Romberg) {}
 
 Parametrization::Parametrization(const Parametrization& param)
     : particle_def_(param.particle_def_),
@@ -30,7 +31,8 @@ Parametrization::Parametrization(const Parametrization& param)
       component_index_(param.component_index_)  // //TODO(mario): Check better
                                                 // way Mon 2017/09/04
       ,
-      multiplier_(param.multiplier_) {}
+      multiplier_(param.multiplier_),
+      quadrature_(param.quadrature_) {}
 
 Parametrization::~Parametrization() {
 }
@@ -57,6 +59,8 @@ bool Parametrization::compare(const Parametrization& parametrization) const {
         return false;
     else if (multiplier_ != parametrization.multiplier_)
         return false;
+    else if (quadrature_ != parametrization.quadrature_)
+        return false;
     else
         return true;
 }
@@ -72,6 +76,7 @@ std::ostream& operator<<(std::ostream& os, Parametrization const& param) {
     param.print(os);
 
     os << "multiplier: " << param.multiplier_ << '\n';
+    os << "quadrature: " << param.quadrature_ << '\n';
     os << "current component index: " << param.component_index_ << '\n';
     os << param.particle_def_ << '\n';
     os << *param.medium_ << '\n';
@@ -86,6 +91,19 @@ std::ostream& operator<<(std::ostream& os, Parametrization const& param) {
 // ------------------------------------------------------------------------- //
 
 //----------------------------------------------------------------------------//
+void Parametrization::DifferentialCrossSection(double energy, const double* v, double* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = DifferentialCrossSection(energy, v[i]);
+    }
+}
+
+// ------------------------------------------------------------------------- //
+bool Parametrization::IntegrateDifferentialCrossSection(double energy, double v_min, double v_max, int moment, double& result) {
+    (void)energy; (void)v_min; (void)v_max; (void)moment; (void)result;
+    return false;
+}
+
+// ------------------------------------------------------------------------- //
 double Parametrization::FunctionToDNdxIntegral(double energy, double variable) {
     return DifferentialCrossSection(energy, variable);
 }
@@ -101,15 +119,64 @@ double Parametrization::FunctionToDE2dxIntegral(double energy,
     return variable * variable * DifferentialCrossSection(energy, variable);
 }
 
+// ------------------------------------------------------------------------- //
+void Parametrization::FunctionToDNdxIntegral(double energy, const double* v, double* out, size_t n) {
+    DifferentialCrossSection(energy, v, out, n);
+}
+
+// ------------------------------------------------------------------------- //
+void Parametrization::FunctionToDEdxIntegral(double energy, const double* v, double* out, size_t n) {
+    DifferentialCrossSection(energy, v, out, n);
+    for (size_t i = 0; i < n; ++i) {
+        out[i] *= v[i];
+    }
+}
+
+// ------------------------------------------------------------------------- //
+void Parametrization::FunctionToDE2dxIntegral(double energy, const double* v, double* out, size_t n) {
+    DifferentialCrossSection(energy, v, out, n);
+    for (size_t i = 0; i < n; ++i) {
+        out[i] *= v[i] * v[i];
+    }
+}
+
 // ------------------------------------------------------------------------- //
 // Getter
 // ------------------------------------------------------------------------- //
 
-size_t Parametrization::GetHash() const {
+size_t Parametrization::GetParametrizationHash() const {
     std::size_t seed = 0;
     hash_combine(seed, GetName(), std::abs(particle_def_.charge),
-                 particle_def_.mass, medium_->GetName(),
-                 cut_settings_.GetEcut(), cut_settings_.GetVcut());
+                 particle_def_.mass);
+
+    // Romberg is not hashed to keep the names of existing tables
+    if (quadrature_ != Integral::Romberg)
+        hash_combine(seed, static_cast<int>(quadrature_));
+
+    return seed;
+}
+
+size_t Parametrization::GetCutIndependentHash() const {
+    std::size_t seed = GetParametrizationHash();
+    hash_combine(seed, medium_->GetName());
+
+    return seed;
+}
+
+size_t Parametrization::GetHash() const {
+    std::size_t seed = GetCutIndependentHash();
+    hash_combine(seed, cut_settings_.GetEcut(), cut_settings_.GetVcut());
+
+    return seed;
+}
+
+size_t Parametrization::GetComponentHash(int component) const {
+    const Components::Component& comp = components_.at(component);
+
+    std::size_t seed = GetParametrizationHash();
+    hash_combine(seed, comp.GetName(), comp.GetNucCharge(),
+                 comp.GetAtomicNum(), comp.GetLogConstant(), comp.GetBPrime(),
+                 comp.GetAverageNucleonWeight(), comp.GetWoodSaxon());
 
     return seed;
 }
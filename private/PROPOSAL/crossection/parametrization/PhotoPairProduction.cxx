@@ -60,9 +60,9 @@ Parametrization::IntegralLimits PhotoPairProduction::GetIntegralLimits(double en
     return limits;
 }
 
-size_t PhotoPairProduction::GetHash() const
+size_t PhotoPairProduction::GetParametrizationHash() const
 {
-    size_t seed = Parametrization::GetHash();
+    size_t seed = Parametrization::GetParametrizationHash();
     hash_combine(seed);
 
     return seed;
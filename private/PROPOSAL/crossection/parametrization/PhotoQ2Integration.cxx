@@ -1,4 +1,5 @@
 
+#include <algorithm>
 #include <cmath>
 
 #include "PROPOSAL/crossection/parametrization/PhotoQ2Integration.h"
@@ -42,6 +43,7 @@ PhotoQ2Integral::PhotoQ2Integral(const ParticleDef& particle_def,
     : Photonuclear(particle_def, medium, cuts, multiplier)
     , shadow_effect_(shadow_effect.clone())
     , integral_(IROMB, IMAXS, IPREC)
+    , cubature_()
 {
 }
 
@@ -49,6 +51,7 @@ PhotoQ2Integral::PhotoQ2Integral(const PhotoQ2Integral& photo)
     : Photonuclear(photo)
     , shadow_effect_(photo.shadow_effect_->clone())
     , integral_(photo.integral_)
+    , cubature_(photo.cubature_)
 {
 }
 
@@ -93,8 +96,11 @@ double PhotoQ2Integral::DifferentialCrossSection(double energy, double v)
         return 0;
     }
 
-    aux = integral_.Integrate(
-        q2_min, q2_max, std::bind(&PhotoQ2Integral::FunctionToQ2Integral, this, energy, v, std::placeholders::_1), 4);
+    aux = integral_.IntegrateBatch(
+        q2_min,
+        q2_max,
+        [this, energy, v](const double* Q2, double* out, size_t n) { FunctionToQ2Integral(energy, v, Q2, out, n); },
+        4);
 
     aux *= medium_->GetMolDensity() * components_[component_index_].GetAtomInMolecule() *
            particle_def_.charge * particle_def_.charge;
@@ -102,19 +108,93 @@ double PhotoQ2Integral::DifferentialCrossSection(double energy, double v)
     return aux;
 }
 
+// ------------------------------------------------------------------------- //
+bool PhotoQ2Integral::IntegrateDifferentialCrossSection(double energy,
+                                                        double v_min,
+                                                        double v_max,
+                                                        int moment,
+                                                        double& result)
+{
+    if (quadrature_ != Integral::Cubature)
+    {
+        return false;
+    }
+
+    IntegralLimits limits = GetIntegralLimits(energy);
+
+    double prefactor = medium_->GetMolDensity() * components_[component_index_].GetAtomInMolecule() *
+                       particle_def_.charge * particle_def_.charge;
+    double nucleon_weight = components_[component_index_].GetAverageNucleonWeight();
+
+    auto integrand = [&](double v, const double* u, double* out, size_t n) {
+        double aux, q2_min, q2_max;
+
+        q2_min = particle_def_.mass * v;
+        q2_min *= q2_min / (1 - v);
+
+        if (particle_def_.mass < MPI)
+        {
+            aux = particle_def_.mass * particle_def_.mass / energy;
+            q2_min -= (aux * aux) / (2 * (1 - v));
+        }
+
+        q2_max = 2 * nucleon_weight * energy * (v - limits.vMin);
+
+        if (q2_min > q2_max)
+        {
+            std::fill(out, out + n, 0.);
+            return;
+        }
+
+        // Q2 = q2_min * (q2_max / q2_min)^u
+        double log_range = std::log(q2_max / q2_min);
+        double Q2[Cubature::max_points_per_line] = {};
+        for (size_t i = 0; i < n; ++i)
+        {
+            Q2[i] = q2_min * std::exp(u[i] * log_range);
+        }
+
+        FunctionToQ2Integral(energy, v, Q2, out, n);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] *= prefactor * Q2[i] * log_range;
+        }
+    };
+
+    result = IntegrateWithCubature(cubature_, v_min, v_max, moment, integrand);
+    return true;
+}
+
+// ------------------------------------------------------------------------- //
+void PhotoQ2Integral::FunctionToQ2Integral(double energy, double v, const double* Q2, double* out, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        out[i] = FunctionToQ2Integral(energy, v, Q2[i]);
+    }
+}
+
 // ------------------------------------------------------------------------- //
 // Getter
 // ------------------------------------------------------------------------- //
 
 // ------------------------------------------------------------------------- //
-size_t PhotoQ2Integral::GetHash() const
+size_t PhotoQ2Integral::GetParametrizationHash() const
 {
-    size_t seed = Parametrization::GetHash();
+    size_t seed = Parametrization::GetParametrizationHash();
     hash_combine(seed, shadow_effect_->GetHash());
 
     return seed;
 }
 
+// ------------------------------------------------------------------------- //
+void PhotoQ2Integral::SetQuadrature(Integral::Quadrature quadrature)
+{
+    Parametrization::SetQuadrature(quadrature);
+    integral_.SetQuadrature(quadrature);
+}
+
 // ------------------------------------------------------------------------- //
 // Print
 // ------------------------------------------------------------------------- //
@@ -396,6 +476,109 @@ double PhotoAbramowiczLevinLevyMaor97::FunctionToQ2Integral(double energy, doubl
     return result;
 }
 
+// ------------------------------------------------------------------------- //
+// Batch form of the ALLM97 integrand above. The component, the kinematics
+// of the fixed v and the parameters are set up once for all Q2.
+// ------------------------------------------------------------------------- //
+void PhotoAbramowiczLevinLevyMaor97::FunctionToQ2Integral(double energy,
+                                                          double v,
+                                                          const double* Q2,
+                                                          double* out,
+                                                          size_t n)
+{
+    const Components::Component& component = components_[component_index_];
+
+    double mass_nucleus   = component.GetAverageNucleonWeight();
+    double mass_nucleus_2 = mass_nucleus * mass_nucleus;
+    double nuc_charge     = component.GetNucCharge();
+    double neutrons       = component.GetAtomicNum() - component.GetNucCharge();
+
+    const double a1_pomeron = -0.0808;
+    const double a2_pomeron = -0.44812;
+    const double a3_pomeron = 1.1709;
+
+    const double b1_pomeron = 0.36292;
+    const double b2_pomeron = 1.8917;
+    const double b3_pomeron = 1.8439;
+
+    const double c1_pomeron = 0.28067;
+    const double c2_pomeron = 0.22291;
+    const double c3_pomeron = 2.1979;
+
+    const double a1_reggeon = 0.58400;
+    const double a2_reggeon = 0.37888;
+    const double a3_reggeon = 2.6063;
+
+    const double b1_reggeon = 0.01147;
+    const double b2_reggeon = 3.7582;
+    const double b3_reggeon = 0.49338;
+
+    const double c1_reggeon = 0.80107;
+    const double c2_reggeon = 0.97307;
+    const double c3_reggeon = 3.4942;
+
+    const double mass_photon_eff = 0.31985 * 1e6;
+    const double mass_reggeon    = 0.15052 * 1e6;
+    const double mass_pomeron    = 49.457 * 1e6;
+    const double scaleParameter  = 0.06527 * 1e6;
+    const double Q20_free_param  = 0.52544 * 1e6;
+
+    const double R = 0;
+
+    double log_q20       = std::log(Q20_free_param / scaleParameter);
+    double bjorken_denom = 2 * mass_nucleus * v * energy;
+    double W2_0          = mass_nucleus * mass_nucleus + 2 * mass_nucleus * energy * v;
+    double nu            = v * energy;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double q2 = Q2[i];
+
+        double bjorken_x = q2 / bjorken_denom;
+
+        double t = std::log(std::log((q2 + Q20_free_param) / scaleParameter) / log_q20);
+
+        if (t < 0)
+            t = 0;
+
+        double a_reggeon = a1_reggeon + a2_reggeon * std::pow(t, a3_reggeon);
+        double b_reggeon = b1_reggeon + b2_reggeon * std::pow(t, b3_reggeon);
+        double c_reggeon = c1_reggeon + c2_reggeon * std::pow(t, c3_reggeon);
+        double b_pomeron = b1_pomeron + b2_pomeron * std::pow(t, b3_pomeron);
+        double a_pomeron = a1_pomeron + (a1_pomeron - a2_pomeron) * (1 / (1 + std::pow(t, a3_pomeron)) - 1);
+        double c_pomeron = c1_pomeron + (c1_pomeron - c2_pomeron) * (1 / (1 + std::pow(t, c3_pomeron)) - 1);
+
+        double W2 = W2_0 - q2;
+
+        double relation_proton_neutron = bjorken_x * bjorken_x;
+        relation_proton_neutron        = 1 - 1.85 * bjorken_x + 2.45 * relation_proton_neutron -
+                                  2.35 * relation_proton_neutron * bjorken_x +
+                                  relation_proton_neutron * relation_proton_neutron;
+
+        double bjorken_x_pomeron = (q2 + mass_pomeron) / (q2 + mass_pomeron + W2 - mass_nucleus_2);
+        double bjorken_x_reggeon = (q2 + mass_reggeon) / (q2 + mass_reggeon + W2 - mass_nucleus_2);
+
+        double pomeron_contribution =
+            c_pomeron * std::pow(bjorken_x_pomeron, a_pomeron) * std::pow(1 - bjorken_x, b_pomeron);
+        double reggeon_controbution =
+            c_reggeon * std::pow(bjorken_x_reggeon, a_reggeon) * std::pow(1 - bjorken_x, b_reggeon);
+
+        double structure_function_proton = q2 / (q2 + mass_photon_eff) * (pomeron_contribution + reggeon_controbution);
+
+        double structure_function_nucleus = structure_function_proton *
+                                            shadow_effect_->CalculateShadowEffect(component, bjorken_x, nu) *
+                                            (nuc_charge + neutrons * relation_proton_neutron);
+
+        double result = ME * RE / q2;
+        result *= result * 4 * PI * structure_function_nucleus / v *
+                  (1 - v - mass_nucleus * bjorken_x * v / (2 * energy) +
+                   (1 - 2 * particle_def_.mass * particle_def_.mass / q2) * v * v *
+                       (1 + 4 * mass_nucleus * mass_nucleus * bjorken_x * bjorken_x / q2) / (2 * (1 + R)));
+
+        out[i] = result;
+    }
+}
+
 // ------------------------------------------------------------------------- //
 // Butkevich Mikheyev Parametrization
 // JETP 95 (2002), 11
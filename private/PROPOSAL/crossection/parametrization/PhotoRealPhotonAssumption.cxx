@@ -142,9 +142,9 @@ double PhotoRealPhotonAssumption::NucleusCrossSectionCaldwell(double nu)
 // ------------------------------------------------------------------------- //
 
 // ------------------------------------------------------------------------- //
-size_t PhotoRealPhotonAssumption::GetHash() const
+size_t PhotoRealPhotonAssumption::GetParametrizationHash() const
 {
-    size_t seed = Parametrization::GetHash();
+    size_t seed = Parametrization::GetParametrizationHash();
     hash_combine(seed, hard_component_);
 
     return seed;
@@ -54,9 +54,9 @@ Parametrization::IntegralLimits WeakInteraction::GetIntegralLimits(double energy
     return limits;
 }
 
-size_t WeakInteraction::GetHash() const
+size_t WeakInteraction::GetParametrizationHash() const
 {
-    size_t seed = Parametrization::GetHash();
+    size_t seed = Parametrization::GetParametrizationHash();
     hash_combine(seed, particle_def_.charge);
 
     return seed;
@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "PROPOSAL/Constants.h"
+#include "PROPOSAL/geometry/BoundingVolumeHierarchy.h"
+#include "PROPOSAL/geometry/Geometry.h"
+
+using namespace PROPOSAL;
+
+const unsigned int BoundingVolumeHierarchy::max_leaf_size;
+
+// ------------------------------------------------------------------------- //
+// Boxes
+// ------------------------------------------------------------------------- //
+
+// ------------------------------------------------------------------------- //
+void BoundingVolumeHierarchy::Box::Extend(const Box& box)
+{
+    for (int i = 0; i < 3; ++i) {
+        lower[i] = std::min(lower[i], box.lower[i]);
+        upper[i] = std::max(upper[i], box.upper[i]);
+    }
+}
+
+// ------------------------------------------------------------------------- //
+bool BoundingVolumeHierarchy::Box::Contains(const double* position) const
+{
+    for (int i = 0; i < 3; ++i) {
+        if (position[i] < lower[i] || position[i] > upper[i])
+            return false;
+    }
+
+    return true;
+}
+
+// ------------------------------------------------------------------------- //
+double BoundingVolumeHierarchy::Box::Entry(const double* position, const double* direction) const
+{
+    double t_min = 0;
+    double t_max = std::numeric_limits<double>::infinity();
+
+    for (int i = 0; i < 3; ++i) {
+        if (direction[i] == 0) {
+            // parallel to the slab
+            if (position[i] < lower[i] || position[i] > upper[i])
+                return std::numeric_limits<double>::infinity();
+            continue;
+        }
+
+        double t1 = (lower[i] - position[i]) / direction[i];
+        double t2 = (upper[i] - position[i]) / direction[i];
+
+        if (t1 > t2)
+            std::swap(t1, t2);
+
+        t_min = std::max(t_min, t1);
+        t_max = std::min(t_max, t2);
+
+        if (t_min > t_max)
+            return std::numeric_limits<double>::infinity();
+    }
+
+    return t_min;
+}
+
+// ------------------------------------------------------------------------- //
+// Constructors
+// ------------------------------------------------------------------------- //
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy()
+    : boxes_()
+    , indices_()
+    , nodes_()
+{
+}
+
+// ------------------------------------------------------------------------- //
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(const std::vector<std::shared_ptr<const Geometry>>& geometries)
+    : boxes_()
+    , indices_()
+    , nodes_()
+{
+    std::vector<std::pair<Vector3D, Vector3D>> boxes;
+
+    for (auto geometry : geometries) {
+        boxes.push_back(geometry->GetBoundingBox());
+    }
+
+    Init(boxes);
+}
+
+// ------------------------------------------------------------------------- //
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(const std::vector<std::pair<Vector3D, Vector3D>>& boxes)
+    : boxes_()
+    , indices_()
+    , nodes_()
+{
+    Init(boxes);
+}
+
+// ------------------------------------------------------------------------- //
+void BoundingVolumeHierarchy::Init(const std::vector<std::pair<Vector3D, Vector3D>>& boxes)
+{
+    for (unsigned int i = 0; i < boxes.size(); ++i) {
+        Box box;
+        box.lower[0] = boxes[i].first.GetX();
+        box.lower[1] = boxes[i].first.GetY();
+        box.lower[2] = boxes[i].first.GetZ();
+        box.upper[0] = boxes[i].second.GetX();
+        box.upper[1] = boxes[i].second.GetY();
+        box.upper[2] = boxes[i].second.GetZ();
+
+        // widen the boxes by the precision of the geometry calculations, so
+        // particles on a border are not lost to rounding
+        for (int k = 0; k < 3; ++k) {
+            double margin = GEOMETRY_PRECISION + 1e-9 * std::max(std::abs(box.lower[k]), std::abs(box.upper[k]));
+            box.lower[k] -= margin;
+            box.upper[k] += margin;
+        }
+
+        boxes_.push_back(box);
+        indices_.push_back(i);
+    }
+
+    if (!indices_.empty()) {
+        nodes_.reserve(2 * indices_.size());
+        Build(0, indices_.size());
+    }
+}
+
+// ------------------------------------------------------------------------- //
+unsigned int BoundingVolumeHierarchy::Build(unsigned int begin, unsigned int end)
+{
+    unsigned int node_index = nodes_.size();
+    nodes_.push_back(Node());
+
+    Box box = boxes_[indices_[begin]];
+    double centre_lower[3], centre_upper[3];
+
+    for (int k = 0; k < 3; ++k) {
+        centre_lower[k] = centre_upper[k] = 0.5 * (box.lower[k] + box.upper[k]);
+    }
+
+    for (unsigned int i = begin + 1; i < end; ++i) {
+        const Box& child = boxes_[indices_[i]];
+        box.Extend(child);
+
+        for (int k = 0; k < 3; ++k) {
+            double centre   = 0.5 * (child.lower[k] + child.upper[k]);
+            centre_lower[k] = std::min(centre_lower[k], centre);
+            centre_upper[k] = std::max(centre_upper[k], centre);
+        }
+    }
+
+    nodes_[node_index].box = box;
+
+    if (end - begin <= max_leaf_size) {
+        nodes_[node_index].first = begin;
+        nodes_[node_index].count = end - begin;
+        return node_index;
+    }
+
+    int axis = 0;
+    for (int k = 1; k < 3; ++k) {
+        if (centre_upper[k] - centre_lower[k] > centre_upper[axis] - centre_lower[axis])
+            axis = k;
+    }
+
+    const std::vector<Box>& boxes = boxes_;
+    unsigned int mid = begin + (end - begin) / 2;
+
+    if (centre_upper[axis] > centre_lower[axis]) {
+        std::nth_element(indices_.begin() + begin,
+            indices_.begin() + mid,
+            indices_.begin() + end,
+            [&boxes, axis](unsigned int a, unsigned int b) {
+                return boxes[a].lower[axis] + boxes[a].upper[axis] < boxes[b].lower[axis] + boxes[b].upper[axis];
+            });
+    } else {
+        // common centre, the inner boxes are separated from the outer ones
+        std::nth_element(indices_.begin() + begin,
+            indices_.begin() + mid,
+            indices_.begin() + end,
+            [&boxes](unsigned int a, unsigned int b) {
+                double size_a = 0, size_b = 0;
+                for (int k = 0; k < 3; ++k) {
+                    size_a += boxes[a].upper[k] - boxes[a].lower[k];
+                    size_b += boxes[b].upper[k] - boxes[b].lower[k];
+                }
+                return size_a < size_b;
+            });
+    }
+
+    Build(begin, mid);
+    unsigned int second = Build(mid, end);
+
+    nodes_[node_index].first = second;
+    nodes_[node_index].count = 0;
+
+    return node_index;
+}
+
+// ------------------------------------------------------------------------- //
+// Queries
+// ------------------------------------------------------------------------- //
+
+// ------------------------------------------------------------------------- //
+void BoundingVolumeHierarchy::FindCandidates(const Vector3D& position, std::vector<unsigned int>& candidates) const
+{
+    candidates.clear();
+
+    if (nodes_.empty())
+        return;
+
+    double pos[3] = { position.GetX(), position.GetY(), position.GetZ() };
+
+    // the depth is bounded by the median split
+    unsigned int stack[64];
+    int size = 0;
+    stack[size++] = 0;
+
+    while (size > 0) {
+        unsigned int index = stack[--size];
+        const Node& node = nodes_[index];
+
+        if (!node.box.Contains(pos))
+            continue;
+
+        if (node.count > 0) {
+            for (unsigned int i = node.first; i < node.first + node.count; ++i) {
+                if (boxes_[indices_[i]].Contains(pos))
+                    candidates.push_back(indices_[i]);
+            }
+        } else {
+            stack[size++] = node.first;
+            stack[size++] = index + 1;
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+}
+
+// ------------------------------------------------------------------------- //
+void BoundingVolumeHierarchy::FindCandidates(const Vector3D& position,
+    const Vector3D& direction,
+    double max_distance,
+    std::vector<unsigned int>& candidates) const
+{
+    candidates.clear();
+
+    if (nodes_.empty())
+        return;
+
+    double pos[3] = { position.GetX(), position.GetY(), position.GetZ() };
+    double dir[3] = { direction.GetX(), direction.GetY(), direction.GetZ() };
+
+    unsigned int stack[64];
+    int size = 0;
+    stack[size++] = 0;
+
+    while (size > 0) {
+        unsigned int index = stack[--size];
+        const Node& node = nodes_[index];
+
+        if (!(node.box.Entry(pos, dir) < max_distance))
+            continue;
+
+        if (node.count > 0) {
+            for (unsigned int i = node.first; i < node.first + node.count; ++i) {
+                if (boxes_[indices_[i]].Entry(pos, dir) < max_distance)
+                    candidates.push_back(indices_[i]);
+            }
+        } else {
+            stack[size++] = node.first;
+            stack[size++] = index + 1;
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+}
@@ -1,5 +1,7 @@
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <vector>
 
 #include "PROPOSAL/Constants.h"
@@ -323,3 +325,66 @@ std::pair<double, double> Box::DistanceToBorder(const Vector3D& position, const
 
     return distance;
 }
+
+// ------------------------------------------------------------------------- //
+void Box::BatchDistanceToBorder(const double* x,
+                                const double* y,
+                                const double* z,
+                                const double* dir_x,
+                                const double* dir_y,
+                                const double* dir_z,
+                                double* first,
+                                double* second,
+                                size_t n) const
+{
+    // Slab test: the trajectory is inside the box between the largest entry
+    // and the smallest exit distance of the three pairs of planes.
+    const double x_calc_pos = position_.GetX() + 0.5 * x_;
+    const double x_calc_neg = position_.GetX() - 0.5 * x_;
+    const double y_calc_pos = position_.GetY() + 0.5 * y_;
+    const double y_calc_neg = position_.GetY() - 0.5 * y_;
+    const double z_calc_pos = position_.GetZ() + 0.5 * z_;
+    const double z_calc_neg = position_.GetZ() - 0.5 * z_;
+
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        // trajectories parallel to a pair of planes are inside of it for all
+        // or no distances
+        double t_neg = (x_calc_neg - x[i]) / dir_x[i];
+        double t_pos = (x_calc_pos - x[i]) / dir_x[i];
+        bool inside  = x[i] >= x_calc_neg && x[i] <= x_calc_pos;
+
+        double entry = dir_x[i] != 0 ? std::min(t_neg, t_pos) : (inside ? -infinity : infinity);
+        double exit  = dir_x[i] != 0 ? std::max(t_neg, t_pos) : (inside ? infinity : -infinity);
+
+        t_neg  = (y_calc_neg - y[i]) / dir_y[i];
+        t_pos  = (y_calc_pos - y[i]) / dir_y[i];
+        inside = y[i] >= y_calc_neg && y[i] <= y_calc_pos;
+
+        entry = std::max(entry, dir_y[i] != 0 ? std::min(t_neg, t_pos) : (inside ? -infinity : infinity));
+        exit  = std::min(exit, dir_y[i] != 0 ? std::max(t_neg, t_pos) : (inside ? infinity : -infinity));
+
+        t_neg  = (z_calc_neg - z[i]) / dir_z[i];
+        t_pos  = (z_calc_pos - z[i]) / dir_z[i];
+        inside = z[i] >= z_calc_neg && z[i] <= z_calc_pos;
+
+        entry = std::max(entry, dir_z[i] != 0 ? std::min(t_neg, t_pos) : (inside ? -infinity : infinity));
+        exit  = std::min(exit, dir_z[i] != 0 ? std::max(t_neg, t_pos) : (inside ? infinity : -infinity));
+
+        bool entry_ahead = entry < exit && entry >= GEOMETRY_PRECISION;
+        bool exit_ahead  = entry < exit && exit >= GEOMETRY_PRECISION;
+
+        first[i]  = entry_ahead ? entry : (exit_ahead ? exit : -1.);
+        second[i] = entry_ahead ? exit : -1.;
+    }
+}
+
+// ------------------------------------------------------------------------- //
+std::pair<Vector3D, Vector3D> Box::GetBoundingBox() const
+{
+    Vector3D half_width(0.5 * x_, 0.5 * y_, 0.5 * z_);
+
+    return std::make_pair(position_ - half_width, position_ + half_width);
+}
@@ -1,5 +1,7 @@
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <vector>
 
 #include "PROPOSAL/Constants.h"
@@ -568,5 +570,85 @@ std::pair<double, double> Cylinder::DistanceToBorder(const Vector3D& position, c
     if (distance.first < 0)
         std::swap(distance.first, distance.second);
 
+    // A trajectory below or above the hole enters the hollow cylinder through
+    // the inner barrel, which is found after the outer one.
+    // distance.first should be the smaller one
+    if (distance.first > 0 && distance.second > 0 && distance.second < distance.first)
+        std::swap(distance.first, distance.second);
+
     return distance;
 }
+
+// ------------------------------------------------------------------------- //
+void Cylinder::BatchDistanceToBorder(const double* x,
+                                     const double* y,
+                                     const double* z,
+                                     const double* dir_x,
+                                     const double* dir_y,
+                                     const double* dir_z,
+                                     double* first,
+                                     double* second,
+                                     size_t n) const
+{
+    // The cases of the hollow cylinder are not vectorized
+    if (inner_radius_ > 0)
+    {
+        Geometry::BatchDistanceToBorder(x, y, z, dir_x, dir_y, dir_z, first, second, n);
+        return;
+    }
+
+    // Slab test: the trajectory is inside the cylinder between the larger
+    // entry and the smaller exit distance of the barrel and the two planes.
+    const double center_x   = position_.GetX();
+    const double center_y   = position_.GetY();
+    const double radius_2   = radius_ * radius_;
+    const double z_calc_pos = position_.GetZ() + 0.5 * z_;
+    const double z_calc_neg = position_.GetZ() - 0.5 * z_;
+
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double diff_x = x[i] - center_x;
+        double diff_y = y[i] - center_y;
+
+        // barrel, trajectories parallel to it are inside for all or no distances
+        double A = diff_x * diff_x + diff_y * diff_y - radius_2;
+        double B = diff_x * dir_x[i] + diff_y * dir_y[i];
+        double C = dir_x[i] * dir_x[i] + dir_y[i] * dir_y[i];
+
+        B /= C;
+        A /= C;
+
+        double determinant = B * B - A;
+        double root        = std::sqrt(std::max(determinant, 0.));
+
+        bool parallel = C == 0;
+        bool inside   = diff_x * diff_x + diff_y * diff_y <= radius_2;
+
+        double entry = parallel ? (inside ? -infinity : infinity) : (determinant > 0 ? -B - root : infinity);
+        double exit  = parallel ? (inside ? infinity : -infinity) : (determinant > 0 ? -B + root : -infinity);
+
+        // top and bottom surface
+        double t_neg = (z_calc_neg - z[i]) / dir_z[i];
+        double t_pos = (z_calc_pos - z[i]) / dir_z[i];
+        inside       = z[i] >= z_calc_neg && z[i] <= z_calc_pos;
+
+        entry = std::max(entry, dir_z[i] != 0 ? std::min(t_neg, t_pos) : (inside ? -infinity : infinity));
+        exit  = std::min(exit, dir_z[i] != 0 ? std::max(t_neg, t_pos) : (inside ? infinity : -infinity));
+
+        bool entry_ahead = entry < exit && entry >= GEOMETRY_PRECISION;
+        bool exit_ahead  = entry < exit && exit >= GEOMETRY_PRECISION;
+
+        first[i]  = entry_ahead ? entry : (exit_ahead ? exit : -1.);
+        second[i] = entry_ahead ? exit : -1.;
+    }
+}
+
+// ------------------------------------------------------------------------- //
+std::pair<Vector3D, Vector3D> Cylinder::GetBoundingBox() const
+{
+    Vector3D half_width(radius_, radius_, 0.5 * z_);
+
+    return std::make_pair(position_ - half_width, position_ + half_width);
+}
@@ -177,3 +177,24 @@ double Geometry::DistanceToClosestApproach(const Vector3D& position, const Vecto
 {
     return scalar_product(position_ - position, direction);
 }
+
+// ------------------------------------------------------------------------- //
+void Geometry::BatchDistanceToBorder(const double* x,
+                                     const double* y,
+                                     const double* z,
+                                     const double* dir_x,
+                                     const double* dir_y,
+                                     const double* dir_z,
+                                     double* first,
+                                     double* second,
+                                     size_t n) const
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        std::pair<double, double> distance =
+            DistanceToBorder(Vector3D(x[i], y[i], z[i]), Vector3D(dir_x[i], dir_y[i], dir_z[i]));
+
+        first[i]  = distance.first;
+        second[i] = distance.second;
+    }
+}
@@ -0,0 +1,535 @@
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <queue>
+#include <sstream>
+#include <stdexcept>
+
+#include "PROPOSAL/Constants.h"
+#include "PROPOSAL/Logging.h"
+#include "PROPOSAL/geometry/Mesh.h"
+
+using namespace PROPOSAL;
+
+namespace {
+
+// Flip triangles such that neighbouring triangles traverse their common
+// edge in opposite directions. Vertices are identified by their position,
+// since STL files repeat them for every facet. The sign of the determinant
+// in DistanceToBorder then tells on which side of the surface the
+// trajectory passes a triangle.
+std::vector<std::array<unsigned int, 3>> OrientTriangles(const std::vector<Vector3D>& vertices,
+    const std::vector<std::array<unsigned int, 3>>& triangles)
+{
+    std::map<std::array<double, 3>, unsigned int> positions;
+    std::vector<unsigned int> identity(vertices.size());
+    for (unsigned int i = 0; i < vertices.size(); ++i) {
+        std::array<double, 3> key = { { vertices[i].GetX(), vertices[i].GetY(), vertices[i].GetZ() } };
+        identity[i] = positions.insert(std::make_pair(key, i)).first->second;
+    }
+
+    std::map<std::pair<unsigned int, unsigned int>, std::vector<unsigned int>> edges;
+    for (unsigned int i = 0; i < triangles.size(); ++i) {
+        for (int k = 0; k < 3; ++k) {
+            unsigned int a = identity[triangles[i][k]];
+            unsigned int b = identity[triangles[i][(k + 1) % 3]];
+            edges[std::make_pair(std::min(a, b), std::max(a, b))].push_back(i);
+        }
+    }
+
+    std::vector<std::array<unsigned int, 3>> oriented(triangles);
+    std::vector<bool> visited(triangles.size(), false);
+
+    for (unsigned int start = 0; start < triangles.size(); ++start) {
+        if (visited[start])
+            continue;
+
+        visited[start] = true;
+        std::queue<unsigned int> queue;
+        queue.push(start);
+
+        while (!queue.empty()) {
+            unsigned int current = queue.front();
+            queue.pop();
+
+            for (int k = 0; k < 3; ++k) {
+                unsigned int a = identity[oriented[current][k]];
+                unsigned int b = identity[oriented[current][(k + 1) % 3]];
+
+                // only edges shared by exactly two triangles define a side
+                const auto& neighbours = edges[std::make_pair(std::min(a, b), std::max(a, b))];
+                if (neighbours.size() != 2)
+                    continue;
+
+                unsigned int neighbour = neighbours[0] == current ? neighbours[1] : neighbours[0];
+                if (visited[neighbour])
+                    continue;
+
+                for (int l = 0; l < 3; ++l) {
+                    if (identity[oriented[neighbour][l]] == a && identity[oriented[neighbour][(l + 1) % 3]] == b) {
+                        std::swap(oriented[neighbour][1], oriented[neighbour][2]);
+                        break;
+                    }
+                }
+
+                visited[neighbour] = true;
+                queue.push(neighbour);
+            }
+        }
+    }
+
+    return oriented;
+}
+
+} // namespace
+
+Mesh::Mesh()
+    : Geometry((std::string)("Mesh"))
+    , triangles_()
+    , hierarchy_()
+{
+    // Do nothing here
+}
+
+Mesh::Mesh(const Vector3D position,
+    const std::vector<Vector3D>& vertices,
+    const std::vector<std::array<unsigned int, 3>>& triangles)
+    : Geometry("Mesh", position)
+    , triangles_()
+    , hierarchy_()
+{
+    Init(vertices, triangles);
+}
+
+Mesh::Mesh(const Vector3D position, const std::string& path)
+    : Geometry("Mesh", position)
+    , triangles_()
+    , hierarchy_()
+{
+    Read(path);
+}
+
+Mesh::Mesh(const Mesh& mesh)
+    : Geometry(mesh)
+    , triangles_(mesh.triangles_)
+    , hierarchy_(mesh.hierarchy_)
+{
+    // Nothing to do here
+}
+
+Mesh::Mesh(const nlohmann::json& config)
+    : Geometry(config)
+    , triangles_()
+    , hierarchy_()
+{
+    if(not config.contains("file"))
+        throw std::invalid_argument("No mesh file found.");
+    if(not config.at("file").is_string())
+        throw std::invalid_argument("Mesh file is not a string.");
+
+    Read(config["file"].get<std::string>());
+}
+
+// ------------------------------------------------------------------------- //
+void Mesh::swap(Geometry& geometry)
+{
+    Mesh* mesh = dynamic_cast<Mesh*>(&geometry);
+    if (!mesh)
+    {
+        log_warn("Cannot swap Mesh!");
+        return;
+    }
+
+    Geometry::swap(*mesh);
+
+    std::swap(triangles_, mesh->triangles_);
+    std::swap(hierarchy_, mesh->hierarchy_);
+}
+
+//------------------------------------------------------------------------- //
+Mesh& Mesh::operator=(const Geometry& geometry)
+{
+    if (this != &geometry)
+    {
+        const Mesh* mesh = dynamic_cast<const Mesh*>(&geometry);
+        if (!mesh)
+        {
+            log_warn("Cannot assign Mesh!");
+            return *this;
+        }
+
+        Mesh tmp(*mesh);
+        swap(tmp);
+    }
+    return *this;
+}
+
+// ------------------------------------------------------------------------- //
+bool Mesh::compare(const Geometry& geometry) const
+{
+    const Mesh* mesh = dynamic_cast<const Mesh*>(&geometry);
+
+    if (!mesh)
+        return false;
+    else if (triangles_.size() != mesh->triangles_.size())
+        return false;
+
+    for (unsigned int i = 0; i < triangles_.size(); ++i)
+    {
+        if (std::memcmp(&triangles_[i], &mesh->triangles_[i], sizeof(Triangle)) != 0)
+            return false;
+    }
+
+    return true;
+}
+
+// ------------------------------------------------------------------------- //
+void Mesh::print(std::ostream& os) const
+{
+    os << "Triangles: " << triangles_.size() << '\n';
+}
+
+// ------------------------------------------------------------------------- //
+// Reading the mesh
+// ------------------------------------------------------------------------- //
+
+// ------------------------------------------------------------------------- //
+void Mesh::Init(const std::vector<Vector3D>& vertices, const std::vector<std::array<unsigned int, 3>>& triangles)
+{
+    std::vector<std::pair<Vector3D, Vector3D>> boxes;
+
+    triangles_.clear();
+    triangles_.reserve(triangles.size());
+
+    for (const auto& indices : triangles)
+    {
+        for (auto index : indices)
+        {
+            if (index >= vertices.size())
+                throw std::invalid_argument("Mesh triangle refers to a missing vertex.");
+        }
+    }
+
+    for (const auto& indices : OrientTriangles(vertices, triangles))
+    {
+
+        Vector3D a = 100 * vertices[indices[0]]; // cm
+        Vector3D b = 100 * vertices[indices[1]];
+        Vector3D c = 100 * vertices[indices[2]];
+
+        Triangle triangle;
+        triangle.vertex[0] = a.GetX();
+        triangle.vertex[1] = a.GetY();
+        triangle.vertex[2] = a.GetZ();
+        triangle.edge_1[0] = b.GetX() - a.GetX();
+        triangle.edge_1[1] = b.GetY() - a.GetY();
+        triangle.edge_1[2] = b.GetZ() - a.GetZ();
+        triangle.edge_2[0] = c.GetX() - a.GetX();
+        triangle.edge_2[1] = c.GetY() - a.GetY();
+        triangle.edge_2[2] = c.GetZ() - a.GetZ();
+
+        triangles_.push_back(triangle);
+
+        boxes.push_back(std::make_pair(
+            Vector3D(std::min({a.GetX(), b.GetX(), c.GetX()}),
+                std::min({a.GetY(), b.GetY(), c.GetY()}),
+                std::min({a.GetZ(), b.GetZ(), c.GetZ()})),
+            Vector3D(std::max({a.GetX(), b.GetX(), c.GetX()}),
+                std::max({a.GetY(), b.GetY(), c.GetY()}),
+                std::max({a.GetZ(), b.GetZ(), c.GetZ()}))));
+    }
+
+    if (triangles_.empty())
+        throw std::invalid_argument("Mesh has no triangles.");
+
+    hierarchy_ = BoundingVolumeHierarchy(boxes);
+}
+
+// ------------------------------------------------------------------------- //
+void Mesh::Read(const std::string& path)
+{
+    std::string extension = path.substr(path.find_last_of('.') + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+        [](unsigned char c) { return std::tolower(c); });
+
+    std::vector<Vector3D> vertices;
+    std::vector<std::array<unsigned int, 3>> triangles;
+
+    if (extension == "obj")
+        ReadObj(path, vertices, triangles);
+    else if (extension == "stl")
+        ReadStl(path, vertices, triangles);
+    else
+        throw std::invalid_argument("Mesh file " + path + " is neither an OBJ nor a STL file.");
+
+    log_debug("Read %lu triangles from %s", static_cast<unsigned long>(triangles.size()), path.c_str());
+
+    Init(vertices, triangles);
+}
+
+// ------------------------------------------------------------------------- //
+void Mesh::ReadObj(const std::string& path,
+    std::vector<Vector3D>& vertices,
+    std::vector<std::array<unsigned int, 3>>& triangles) const
+{
+    // Only vertices ("v x y z") and faces ("f i j k ...") are used, faces
+    // with more than three vertices are split into triangles.
+    std::ifstream file(path);
+    if (!file.good())
+        throw std::invalid_argument("Mesh file " + path + " could not be opened.");
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream stream(line);
+        std::string keyword;
+        stream >> keyword;
+
+        if (keyword == "v")
+        {
+            double x, y, z;
+            if (!(stream >> x >> y >> z))
+                throw std::invalid_argument("Invalid vertex in " + path + ": " + line);
+
+            vertices.push_back(Vector3D(x, y, z));
+        } else if (keyword == "f")
+        {
+            std::vector<unsigned int> face;
+            std::string token;
+
+            while (stream >> token)
+            {
+                // "i", "i/t", "i//n" or "i/t/n", negative indices count from the end
+                long index = std::stol(token.substr(0, token.find('/')));
+                if (index < 0)
+                    index += vertices.size() + 1;
+                if (index < 1)
+                    throw std::invalid_argument("Invalid face in " + path + ": " + line);
+
+                face.push_back(index - 1);
+            }
+
+            if (face.size() < 3)
+                throw std::invalid_argument("Invalid face in " + path + ": " + line);
+
+            for (unsigned int i = 1; i + 1 < face.size(); ++i)
+            {
+                triangles.push_back({ { face[0], face[i], face[i + 1] } });
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------- //
+void Mesh::ReadStl(const std::string& path,
+    std::vector<Vector3D>& vertices,
+    std::vector<std::array<unsigned int, 3>>& triangles) const
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.good())
+        throw std::invalid_argument("Mesh file " + path + " could not be opened.");
+
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    // Binary files may also start with "solid", but they have no "facet"
+    // keyword and their size is given by the number of triangles.
+    bool binary = true;
+    if (content.compare(0, 5, "solid") == 0 && content.find("facet") != std::string::npos)
+    {
+        binary = false;
+
+        if (content.size() >= 84)
+        {
+            uint32_t number;
+            std::memcpy(&number, content.data() + 80, sizeof(number));
+            binary = content.size() == 84 + 50 * static_cast<size_t>(number);
+        }
+    }
+
+    if (binary)
+    {
+        if (content.size() < 84)
+            throw std::invalid_argument("Mesh file " + path + " is too short for a binary STL file.");
+
+        uint32_t number;
+        std::memcpy(&number, content.data() + 80, sizeof(number));
+
+        if (content.size() < 84 + 50 * static_cast<size_t>(number))
+            throw std::invalid_argument("Mesh file " + path + " is too short for its number of triangles.");
+
+        // normal, three vertices and attribute, all little endian
+        for (uint32_t i = 0; i < number; ++i)
+        {
+            const char* facet = content.data() + 84 + 50 * static_cast<size_t>(i);
+
+            for (int k = 1; k <= 3; ++k)
+            {
+                float coordinates[3];
+                std::memcpy(coordinates, facet + 12 * k, sizeof(coordinates));
+                vertices.push_back(Vector3D(coordinates[0], coordinates[1], coordinates[2]));
+            }
+
+            triangles.push_back({ { 3 * i, 3 * i + 1, 3 * i + 2 } });
+        }
+    } else
+    {
+        std::istringstream stream(content);
+        std::string keyword;
+
+        while (stream >> keyword)
+        {
+            if (keyword != "vertex")
+                continue;
+
+            double x, y, z;
+            if (!(stream >> x >> y >> z))
+                throw std::invalid_argument("Invalid vertex in " + path);
+
+            vertices.push_back(Vector3D(x, y, z));
+
+            if (vertices.size() % 3 == 0)
+            {
+                unsigned int first = vertices.size() - 3;
+                triangles.push_back({ { first, first + 1, first + 2 } });
+            }
+        }
+    }
+}
+
+// ------------------------------------------------------------------------- //
+// Member functions
+// ------------------------------------------------------------------------- //
+
+// ------------------------------------------------------------------------- //
+std::pair<double, double> Mesh::DistanceToBorder(const Vector3D& position, const Vector3D& direction) const
+{
+    // Intersections of the particle trajectory with the triangles
+    // (Moeller-Trumbore). We are only interested in positive distances,
+    // distances smaller than GEOMETRY_PRECISION are treated as a particle on
+    // the border.
+    // An odd number of intersections in front of the particle means the
+    // particle is inside the mesh:
+    // (-1/-1) no intersection or the mesh is behind the particle
+    // ( dist_1 / dist_2 ) the mesh is infront of the particle
+    // ( dist_1 / -1 ) particle is inside the mesh or on the border and moving
+    // inside
+
+    Vector3D relative = position - position_;
+
+    // scratch buffers, reused between the calls of a thread
+    static thread_local std::vector<unsigned int> candidates;
+    static thread_local std::vector<std::pair<double, bool>> hits;
+    static thread_local std::vector<double> dist;
+
+    hierarchy_.FindCandidates(relative, direction, std::numeric_limits<double>::infinity(), candidates);
+    hits.clear();
+    dist.clear();
+
+    double pos[3] = { relative.GetX(), relative.GetY(), relative.GetZ() };
+    double dir[3] = { direction.GetX(), direction.GetY(), direction.GetZ() };
+
+    // Hits on an edge or a vertex are accepted by every adjacent triangle,
+    // so that rounding cannot let the trajectory slip between them.
+    const double tolerance = 1e-10;
+
+    for (auto index : candidates)
+    {
+        const Triangle& triangle = triangles_[index];
+        const double* e1         = triangle.edge_1;
+        const double* e2         = triangle.edge_2;
+
+        double p[3] = { dir[1] * e2[2] - dir[2] * e2[1], dir[2] * e2[0] - dir[0] * e2[2], dir[0] * e2[1] - dir[1] * e2[0] };
+
+        double determinant = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+        if (determinant == 0) // trajectory is parallel to the triangle
+            continue;
+
+        double inverse = 1. / determinant;
+
+        double s[3] = { pos[0] - triangle.vertex[0], pos[1] - triangle.vertex[1], pos[2] - triangle.vertex[2] };
+
+        double u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * inverse;
+        if (u < -tolerance || u > 1 + tolerance)
+            continue;
+
+        double q[3] = { s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0] };
+
+        double v = (dir[0] * q[0] + dir[1] * q[1] + dir[2] * q[2]) * inverse;
+        if (v < -tolerance || u + v > 1 + tolerance)
+            continue;
+
+        double t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * inverse;
+
+        // Computer precision controll
+        if (t >= GEOMETRY_PRECISION)
+            hits.push_back(std::make_pair(t, determinant > 0));
+    }
+
+    std::sort(hits.begin(), hits.end());
+
+    // Hits at the same distance belong to an edge or a vertex. Since the
+    // triangles are oriented consistently, the trajectory crosses the
+    // surface there if all of them are passed from the same side. If both
+    // sides occur, it only touches the surface, e.g. at a silhouette edge,
+    // and the hits do not count.
+    for (unsigned int first = 0; first < hits.size();)
+    {
+        unsigned int last = first + 1;
+        bool same_side    = true;
+
+        while (last < hits.size()
+            && hits[last].first - hits[last - 1].first < GEOMETRY_PRECISION * std::max(1., hits[last].first))
+        {
+            same_side &= hits[last].second == hits[first].second;
+            ++last;
+        }
+
+        if (same_side)
+            dist.push_back(hits[first].first);
+
+        first = last;
+    }
+
+    std::pair<double, double> distance(-1, -1);
+
+    if (dist.size() % 2 == 1) // particle is inside
+    {
+        distance.first = dist[0];
+    } else if (dist.size() > 1) // mesh is infront of the particle
+    {
+        distance.first  = dist[0];
+        distance.second = dist[1];
+    }
+
+    return distance;
+}
+
+// ------------------------------------------------------------------------- //
+std::pair<Vector3D, Vector3D> Mesh::GetBoundingBox() const
+{
+    double lower[3] = { std::numeric_limits<double>::infinity(),
+        std::numeric_limits<double>::infinity(),
+        std::numeric_limits<double>::infinity() };
+    double upper[3] = { -lower[0], -lower[1], -lower[2] };
+
+    for (const auto& triangle : triangles_)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            double a = triangle.vertex[k];
+            double b = a + triangle.edge_1[k];
+            double c = a + triangle.edge_2[k];
+
+            lower[k] = std::min({ lower[k], a, b, c });
+            upper[k] = std::max({ upper[k], a, b, c });
+        }
+    }
+
+    return std::make_pair(position_ + Vector3D(lower[0], lower[1], lower[2]),
+        position_ + Vector3D(upper[0], upper[1], upper[2]));
+}
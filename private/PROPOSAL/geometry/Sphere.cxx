@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cmath>
 
 #include "PROPOSAL/Constants.h"
@@ -290,3 +291,84 @@ std::pair<double, double> Sphere::DistanceToBorder(const Vector3D& position, con
 
     return distance;
 }
+
+// ------------------------------------------------------------------------- //
+void Sphere::BatchDistanceToBorder(const double* x,
+                                   const double* y,
+                                   const double* z,
+                                   const double* dir_x,
+                                   const double* dir_y,
+                                   const double* dir_z,
+                                   double* first,
+                                   double* second,
+                                   size_t n) const
+{
+    // Same cases as in DistanceToBorder, but every case is evaluated and the
+    // result is selected, so the loop has no branches.
+    const double center_x     = position_.GetX();
+    const double center_y     = position_.GetY();
+    const double center_z     = position_.GetZ();
+    const double radius_2     = radius_ * radius_;
+    const double inner_radius_2 = inner_radius_ * inner_radius_;
+    const bool hollow         = inner_radius_ > 0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double diff_x = x[i] - center_x;
+        double diff_y = y[i] - center_y;
+        double diff_z = z[i] - center_z;
+
+        double B                         = diff_x * dir_x[i] + diff_y * dir_y[i] + diff_z * dir_z[i];
+        double difference_length_squared = diff_x * diff_x + diff_y * diff_y + diff_z * diff_z;
+
+        // outer sphere
+        double determinant = B * B - difference_length_squared + radius_2;
+        double root        = std::sqrt(std::max(determinant, 0.));
+        double t1          = -B + root;
+        double t2          = -B - root;
+
+        bool t1_ahead = determinant > 0 && t1 >= GEOMETRY_PRECISION;
+        bool t2_ahead = determinant > 0 && t2 >= GEOMETRY_PRECISION;
+
+        double dist_1 = t2_ahead ? t2 : (t1_ahead ? t1 : -1.);
+        double dist_2 = t2_ahead ? t1 : -1.;
+
+        // inner sphere
+        determinant = B * B - difference_length_squared + inner_radius_2;
+        root        = std::sqrt(std::max(determinant, 0.));
+        t1          = -B + root;
+        t2          = -B - root;
+
+        t1 = (t1 > 0 && t1 < GEOMETRY_PRECISION) ? 0. : t1;
+        t2 = (t2 > 0 && t2 < GEOMETRY_PRECISION) ? 0. : t2;
+
+        bool inner = hollow && determinant > 0 && dist_1 > 0;
+
+        // sphere is infront of the particle, the inner border limits the second distance
+        double infront_2 = (t1 > 0 && t1 < dist_2) ? t1 : dist_2;
+        infront_2        = (t2 > 0 && t2 < infront_2) ? t2 : infront_2;
+
+        // particle is inside the outer sphere, inner sphere ahead or particle inside of it
+        bool both_ahead   = t1 > 0 && t2 > 0;
+        bool one_ahead    = (t1 > 0 && t2 <= 0) || (t2 > 0 && t1 <= 0);
+        double inside_1 = both_ahead ? std::min(t1, t2) : (one_ahead ? (t1 > 0 ? t1 : t2) : dist_1);
+        double inside_2 = one_ahead ? dist_1 : dist_2;
+
+        double distance_1 = inner ? (dist_2 > 0 ? dist_1 : inside_1) : dist_1;
+        double distance_2 = inner ? (dist_2 > 0 ? infront_2 : inside_2) : dist_2;
+
+        distance_1 = distance_1 < GEOMETRY_PRECISION ? -1. : distance_1;
+        distance_2 = distance_2 < GEOMETRY_PRECISION ? -1. : distance_2;
+
+        first[i]  = distance_1 < 0 ? distance_2 : distance_1;
+        second[i] = distance_1 < 0 ? distance_1 : distance_2;
+    }
+}
+
+// ------------------------------------------------------------------------- //
+std::pair<Vector3D, Vector3D> Sphere::GetBoundingBox() const
+{
+    Vector3D half_width(radius_, radius_, radius_);
+
+    return std::make_pair(position_ - half_width, position_ + half_width);
+}
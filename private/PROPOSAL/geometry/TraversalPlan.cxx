@@ -0,0 +1,168 @@
+#include <algorithm>
+#include <limits>
+
+#include "PROPOSAL/Constants.h"
+#include "PROPOSAL/geometry/TraversalPlan.h"
+
+using namespace PROPOSAL;
+
+// ------------------------------------------------------------------------- //
+// Constructors
+// ------------------------------------------------------------------------- //
+
+TraversalPlan::TraversalPlan()
+    : geometries_()
+    , hierarchy_()
+    , is_cast_(false)
+    , origin_()
+    , direction_()
+    , distance_(0)
+    , crossings_()
+    , order_()
+    , buffer_()
+    , number_of_casts_(0)
+{
+}
+
+// ------------------------------------------------------------------------- //
+TraversalPlan::TraversalPlan(const std::vector<std::shared_ptr<const Geometry>>& geometries)
+    : geometries_(geometries)
+    , hierarchy_(geometries)
+    , is_cast_(false)
+    , origin_()
+    , direction_()
+    , distance_(0)
+    , crossings_(geometries.size())
+    , order_()
+    , buffer_()
+    , number_of_casts_(0)
+{
+}
+
+// ------------------------------------------------------------------------- //
+// Member functions
+// ------------------------------------------------------------------------- //
+
+// ------------------------------------------------------------------------- //
+void TraversalPlan::Update(const Vector3D& position, const Vector3D& direction)
+{
+    if (is_cast_) {
+        Vector3D offset = position - origin_;
+        double distance = scalar_product(offset, direction_);
+
+        if (distance >= distance_
+            && (direction - direction_).magnitude() < COMPUTER_PRECISION
+            && (offset - distance * direction_).magnitude() < PARTICLE_POSITION_RESOLUTION) {
+            distance_ = distance;
+
+            // Borders which are reached (or nearly reached) are evaluated
+            // again, so particles on a border are treated exactly like in
+            // the geometries.
+            unsigned int reached = 0;
+            while (reached < order_.size()
+                && crossings_[order_[reached]].first - distance_ < PARTICLE_POSITION_RESOLUTION) {
+                ++reached;
+            }
+
+            if (reached > 0) {
+                buffer_.assign(order_.begin(), order_.begin() + reached);
+                order_.erase(order_.begin(), order_.begin() + reached);
+
+                for (auto index : buffer_) {
+                    Evaluate(index, position, direction);
+                    Insert(index);
+                }
+            }
+
+            return;
+        }
+    }
+
+    Cast(position, direction);
+}
+
+// ------------------------------------------------------------------------- //
+std::pair<double, double> TraversalPlan::DistanceToBorder(unsigned int index) const
+{
+    const Crossing& crossing = crossings_[index];
+
+    if (crossing.first < 0)
+        return std::make_pair(-1., -1.);
+
+    return std::make_pair(crossing.first - distance_, crossing.second < 0 ? -1. : crossing.second - distance_);
+}
+
+// ------------------------------------------------------------------------- //
+bool TraversalPlan::IsInside(unsigned int index) const
+{
+    std::pair<double, double> dist = DistanceToBorder(index);
+
+    return dist.first > 0 && dist.second < 0;
+}
+
+// ------------------------------------------------------------------------- //
+Geometry::ParticleLocation::Enum TraversalPlan::GetLocation(unsigned int index) const
+{
+    std::pair<double, double> dist = DistanceToBorder(index);
+
+    if (dist.first > 0 && dist.second > 0)
+        return Geometry::ParticleLocation::InfrontGeometry;
+    if (dist.first > 0 && dist.second < 0)
+        return Geometry::ParticleLocation::InsideGeometry;
+    else
+        return Geometry::ParticleLocation::BehindGeometry;
+}
+
+// ------------------------------------------------------------------------- //
+double TraversalPlan::DistanceToClosestApproach(unsigned int index) const
+{
+    return crossings_[index].closest_approach - distance_;
+}
+
+// ------------------------------------------------------------------------- //
+void TraversalPlan::Cast(const Vector3D& position, const Vector3D& direction)
+{
+    is_cast_   = true;
+    origin_    = position;
+    direction_ = direction;
+    distance_  = 0;
+    ++number_of_casts_;
+
+    for (unsigned int i = 0; i < geometries_.size(); ++i) {
+        crossings_[i].first            = -1;
+        crossings_[i].second           = -1;
+        crossings_[i].closest_approach = scalar_product(geometries_[i]->GetPosition() - position, direction);
+    }
+
+    // geometries whose bounding box is not crossed have no border on the ray
+    hierarchy_.FindCandidates(position, direction, std::numeric_limits<double>::infinity(), buffer_);
+
+    order_.clear();
+    for (auto index : buffer_) {
+        Evaluate(index, position, direction);
+        Insert(index);
+    }
+}
+
+// ------------------------------------------------------------------------- //
+void TraversalPlan::Evaluate(unsigned int index, const Vector3D& position, const Vector3D& direction)
+{
+    std::pair<double, double> dist = geometries_[index]->DistanceToBorder(position, direction);
+
+    crossings_[index].first  = dist.first > 0 ? distance_ + dist.first : -1;
+    crossings_[index].second = dist.second > 0 ? distance_ + dist.second : -1;
+}
+
+// ------------------------------------------------------------------------- //
+void TraversalPlan::Insert(unsigned int index)
+{
+    if (crossings_[index].first < 0)
+        return;
+
+    const std::vector<Crossing>& crossings = crossings_;
+    order_.insert(std::upper_bound(order_.begin(),
+                      order_.end(),
+                      index,
+                      [&crossings](unsigned int a, unsigned int b) { return crossings[a].first < crossings[b].first; }),
+        index);
+}
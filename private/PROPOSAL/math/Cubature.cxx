@@ -0,0 +1,239 @@
+#include <algorithm>
+#include <cmath>
+
+#include "PROPOSAL/Constants.h"
+#include "PROPOSAL/Logging.h"
+#include "PROPOSAL/math/Cubature.h"
+
+using namespace PROPOSAL;
+
+namespace {
+
+// Genz-Malik degree 7 rule for two dimensions. The points are the centre,
+// +-lambda2 and +-lambda4 along each axis, (+-lambda4, +-lambda4) and
+// (+-lambda5, +-lambda5) in units of the half widths.
+const double gm_lambda2 = 0.3585685828003180919906451539079374954541; // sqrt(9/70)
+const double gm_lambda4 = 0.9486832980505137995996680633298155601160; // sqrt(9/10)
+const double gm_lambda5 = 0.6882472016116852977216287342936235251269; // sqrt(9/19)
+
+const double gm_weight1 = -3816. / 19683.;
+const double gm_weight2 = 980. / 6561.;
+const double gm_weight3 = 1020. / 19683.;
+const double gm_weight4 = 200. / 19683.;
+const double gm_weight5 = 6859. / 78732.;
+
+// embedded degree 5 rule, only used for the error estimate
+const double gm_error_weight1 = -971. / 729.;
+const double gm_error_weight2 = 245. / 486.;
+const double gm_error_weight3 = 65. / 1458.;
+const double gm_error_weight4 = 25. / 729.;
+
+const double gm_ratio = (gm_lambda2 * gm_lambda2) / (gm_lambda4 * gm_lambda4);
+
+} // namespace
+
+const size_t Cubature::max_points_per_line;
+
+//----------------------------------------------------------------------------//
+//--------------------------------constructors--------------------------------//
+//----------------------------------------------------------------------------//
+
+Cubature::Cubature()
+    : precision_(IPREC)
+    , max_regions_(100)
+    , callable_(nullptr)
+    , call_(nullptr)
+    , workspace_()
+{
+}
+
+Cubature::Cubature(double precision, unsigned int max_regions)
+    : precision_(precision)
+    , max_regions_(max_regions)
+    , callable_(nullptr)
+    , call_(nullptr)
+    , workspace_()
+{
+}
+
+bool Cubature::operator==(const Cubature& cubature) const
+{
+    return precision_ == cubature.precision_ && max_regions_ == cubature.max_regions_;
+}
+
+bool Cubature::operator!=(const Cubature& cubature) const
+{
+    return !(*this == cubature);
+}
+
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
+void Cubature::GenzMalik(Region& region)
+{
+    const double cx = region.center[0];
+    const double cy = region.center[1];
+    const double hx = region.half_width[0];
+    const double hy = region.half_width[1];
+
+    double y[max_points_per_line];
+    double f[max_points_per_line];
+
+    // line through the centre: centre, +-lambda2 and +-lambda4 along y
+    y[0] = cy;
+    y[1] = cy - gm_lambda2 * hy;
+    y[2] = cy + gm_lambda2 * hy;
+    y[3] = cy - gm_lambda4 * hy;
+    y[4] = cy + gm_lambda4 * hy;
+    call_(callable_, cx, y, f, 5);
+
+    double f0      = f[0];
+    double sum2    = f[1] + f[2];
+    double sum3    = f[3] + f[4];
+    double diff2_y = f[1] + f[2] - 2 * f0;
+    double diff4_y = f[3] + f[4] - 2 * f0;
+
+    // +-lambda2 along x
+    double diff2_x = -2 * f0;
+    for (int sign = -1; sign <= 1; sign += 2)
+    {
+        call_(callable_, cx + sign * gm_lambda2 * hx, y, f, 1);
+        sum2 += f[0];
+        diff2_x += f[0];
+    }
+
+    // +-lambda4 along x and the four (+-lambda4, +-lambda4) points
+    double sum4    = 0;
+    double diff4_x = -2 * f0;
+    y[1]           = cy - gm_lambda4 * hy;
+    y[2]           = cy + gm_lambda4 * hy;
+    for (int sign = -1; sign <= 1; sign += 2)
+    {
+        call_(callable_, cx + sign * gm_lambda4 * hx, y, f, 3);
+        sum3 += f[0];
+        diff4_x += f[0];
+        sum4 += f[1] + f[2];
+    }
+
+    // the four (+-lambda5, +-lambda5) points
+    double sum5 = 0;
+    y[0]        = cy - gm_lambda5 * hy;
+    y[1]        = cy + gm_lambda5 * hy;
+    for (int sign = -1; sign <= 1; sign += 2)
+    {
+        call_(callable_, cx + sign * gm_lambda5 * hx, y, f, 2);
+        sum5 += f[0] + f[1];
+    }
+
+    double volume = 4 * hx * hy;
+
+    region.value =
+        volume * (gm_weight1 * f0 + gm_weight2 * sum2 + gm_weight3 * sum3 + gm_weight4 * sum4 + gm_weight5 * sum5);
+    region.error = std::abs(
+        volume * (gm_error_weight1 * f0 + gm_error_weight2 * sum2 + gm_error_weight3 * sum3 + gm_error_weight4 * sum4) -
+        region.value);
+
+    // split along the axis where the function varies most (fourth difference)
+    double fourth_x = std::abs(diff2_x - gm_ratio * diff4_x);
+    double fourth_y = std::abs(diff2_y - gm_ratio * diff4_y);
+
+    if (fourth_x > fourth_y || (fourth_x == fourth_y && hx >= hy))
+    {
+        region.split_axis = 0;
+    } else
+    {
+        region.split_axis = 1;
+    }
+}
+
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
+double Cubature::IntegrateRectangle(double x_min, double x_max, double y_min, double y_max)
+{
+    if (x_min == x_max || y_min == y_max)
+    {
+        return 0;
+    }
+
+    // The workspace keeps its capacity, so repeated integrations with the
+    // same Cubature object do not allocate.
+    workspace_.clear();
+
+    Region region;
+    region.center[0]     = 0.5 * (x_min + x_max);
+    region.center[1]     = 0.5 * (y_min + y_max);
+    region.half_width[0] = 0.5 * (x_max - x_min);
+    region.half_width[1] = 0.5 * (y_max - y_min);
+    GenzMalik(region);
+    workspace_.push_back(region);
+
+    double result = region.value;
+    double error  = region.error;
+
+    while (error > precision_ * std::abs(result))
+    {
+        if (workspace_.size() >= max_regions_)
+        {
+            // happens for integrands with numerical noise above the precision
+            log_debug("Precision %e has not been reached after %u regions! value = %e, abserr = %e",
+                      precision_,
+                      max_regions_,
+                      result,
+                      error);
+            break;
+        }
+
+        std::pop_heap(workspace_.begin(), workspace_.end());
+        Region worst = workspace_.back();
+        workspace_.pop_back();
+
+        int axis      = worst.split_axis;
+        double half   = 0.5 * worst.half_width[axis];
+        double center = worst.center[axis];
+        if (center - half == center || center + half == center)
+        {
+            // region can not be bisected any further
+            workspace_.push_back(worst);
+            std::push_heap(workspace_.begin(), workspace_.end());
+            break;
+        }
+
+        Region lower = worst;
+        Region upper = worst;
+        lower.half_width[axis] = half;
+        upper.half_width[axis] = half;
+        lower.center[axis]     = center - half;
+        upper.center[axis]     = center + half;
+        GenzMalik(lower);
+        GenzMalik(upper);
+
+        result += lower.value + upper.value - worst.value;
+        error += lower.error + upper.error - worst.error;
+
+        double sum = lower.value + upper.value;
+        if (lower.error + upper.error >= 0.99 * worst.error &&
+            std::abs(sum - worst.value) <= 1e-5 * std::abs(sum))
+        {
+            // same criterion as in Integral::AdaptiveGaussKronrod: the region
+            // is resolved down to the numerical noise of the integrand
+            error -= lower.error + upper.error;
+            lower.error = 0;
+            upper.error = 0;
+        }
+
+        workspace_.push_back(lower);
+        std::push_heap(workspace_.begin(), workspace_.end());
+        workspace_.push_back(upper);
+        std::push_heap(workspace_.begin(), workspace_.end());
+    }
+
+    // sum up again to get rid of the cancellation in the running sum
+    result = 0;
+    for (const Region& it : workspace_)
+    {
+        result += it.value;
+    }
+
+    return result;
+}
@@ -0,0 +1,108 @@
+#include "PROPOSAL/math/FastMath.h"
+
+namespace PROPOSAL {
+
+const double fastmath::exp_table[64] = {
+    1.0, 1.0108892860517005, 1.0218971486541166, 1.0330248790212284,
+    1.0442737824274138, 1.0556451783605572, 1.0671404006768237, 1.0787607977571199,
+    1.0905077326652577, 1.102382583307841, 1.1143867425958924, 1.1265216186082418,
+    1.1387886347566916, 1.1511892299529827, 1.1637248587775775, 1.1763969916502812,
+    1.189207115002721, 1.202156731452703, 1.215247359980469, 1.22848053610687,
+    1.241857812073484, 1.255380757024691, 1.2690509571917332, 1.2828700160787783,
+    1.2968395546510096, 1.3109612115247644, 1.3252366431597413, 1.339667524053303,
+    1.3542555469368927, 1.3690024229745905, 1.383909881963832, 1.3989796725383112,
+    1.4142135623730951, 1.42961333839197, 1.4451808069770467, 1.460917794180647,
+    1.4768261459394993, 1.4929077282912648, 1.5091644275934228, 1.5255981507445384,
+    1.5422108254079407, 1.559004400237837, 1.5759808451078865, 1.593142151342267,
+    1.6104903319492543, 1.6280274218573478, 1.645755478153965, 1.6636765803267364,
+    1.681792830507429, 1.7001063537185235, 1.718619298122478, 1.7373338352737062,
+    1.7562521603732995, 1.7753764925265212, 1.7947090750031072, 1.8142521755003989,
+    1.8340080864093424, 1.8539791250833855, 1.8741676341103, 1.8945759815869656,
+    1.9152065613971474, 1.9360617934922943, 1.9571441241754002, 1.978456026387951,
+};
+
+const double fastmath::log_table[65][3] = {
+    {1.0, 0.0, 0.0},
+    {0.9846153846153847, 0.015504186535965254, -3.278321022892429e-19},
+    {0.9696969696969697, 0.030771658666753687, 1.0431732029005968e-18},
+    {0.9552238805970149, 0.0458095360312942, 1.902959866474257e-18},
+    {0.9411764705882353, 0.06062462181643484, 2.6424025938726934e-18},
+    {0.927536231884058, 0.07522342123758753, -5.930604196293241e-18},
+    {0.9142857142857143, 0.08961215868968714, -5.4268129336647135e-18},
+    {0.9014084507042254, 0.10379679368164356, 5.47772415726659e-18},
+    {0.8888888888888888, 0.11778303565638346, -1.1971685747593677e-18},
+    {0.8767123287671232, 0.13157635778871926, 1.1123000879729588e-17},
+    {0.8648648648648649, 0.1451820098444979, 8.242418783022475e-18},
+    {0.8533333333333334, 0.15860503017663857, 1.1257003872182592e-17},
+    {0.8421052631578947, 0.17185025692665923, -6.0224538210113705e-18},
+    {0.8311688311688312, 0.184922338494012, 3.0236614153574064e-18},
+    {0.8205128205128205, 0.19782574332991987, 1.2821194372980142e-17},
+    {0.810126582278481, 0.21056476910734964, -4.249405314729895e-18},
+    {0.8, 0.22314355131420976, -9.091270597324799e-18},
+    {0.7901234567901234, 0.2355660713127669, -2.3943371495187355e-18},
+    {0.7804878048780488, 0.24783616390458127, -1.2432209578702523e-17},
+    {0.7710843373493976, 0.25995752443692605, 2.069806938978935e-17},
+    {0.7619047619047619, 0.27193371548364176, 7.83319637697442e-19},
+    {0.7529411764705882, 0.2837681731306446, -2.032665581126656e-17},
+    {0.7441860465116279, 0.2954642128938359, -2.16461086040599e-17},
+    {0.735632183908046, 0.3070250352949119, -1.2319916200101964e-17},
+    {0.7272727272727273, 0.3184537311185346, 2.7114779367326236e-17},
+    {0.7191011235955056, 0.329753286372468, 2.122020616196946e-18},
+    {0.7111111111111111, 0.3409265869705932, 1.7467136443544747e-17},
+    {0.7032967032967034, 0.3519764231571782, -1.2953893030191963e-17},
+    {0.6956521739130435, 0.3629054936893685, -2.1492361455310972e-17},
+    {0.6881720430107527, 0.37371640979358406, 2.1836211281198184e-17},
+    {0.6808510638297872, 0.38441169891033206, -1.612149700764673e-17},
+    {0.6736842105263158, 0.394993808240869, -1.5113724418336168e-17},
+    {0.6666666666666666, 0.4054651081081644, -2.8811380259626426e-18},
+    {0.6597938144329897, 0.415827895143711, -2.48753990369597e-17},
+    {0.6530612244897959, 0.4260843953109001, -2.499176776547466e-17},
+    {0.6464646464646465, 0.43623676677491807, -1.8379648230620457e-18},
+    {0.64, 0.44628710262841953, -1.8182541194649598e-17},
+    {0.6336633663366337, 0.4562374334815876, 2.122222784062318e-17},
+    {0.6274509803921569, 0.46608972992459924, -1.4116523239904406e-17},
+    {0.6213592233009708, 0.4758459048699639, -6.181952722542219e-18},
+    {0.6153846153846154, 0.4855078157817008, -1.6618350693852048e-17},
+    {0.6095238095238096, 0.4950772667978515, -8.307950959627356e-18},
+    {0.6037735849056604, 0.5045560107523953, -2.4888518873597905e-17},
+    {0.5981308411214953, 0.5139457511022343, 3.397548559332142e-17},
+    {0.5925925925925926, 0.5232481437645479, -3.1833882216350925e-17},
+    {0.5871559633027523, 0.5324647988694718, -9.149239241180804e-19},
+    {0.5818181818181818, 0.5415972824327444, -3.748764246125639e-17},
+    {0.5765765765765766, 0.5506471179526623, -2.239429485856908e-17},
+    {0.5714285714285714, 0.5596157879354227, 2.685492580212308e-17},
+    {0.5663716814159292, 0.5685047353526688, -5.4267346029482773e-17},
+    {0.5614035087719298, 0.5773153650348236, -8.903591846974013e-18},
+    {0.5565217391304348, 0.5860490450035782, -3.058363205263577e-17},
+    {0.5517241379310345, 0.5947071077466928, 1.3751689964323675e-17},
+    {0.5470085470085471, 0.6032908514380843, 9.9400563470175e-18},
+    {0.5423728813559322, 0.6118015411059929, -3.7397759448726e-17},
+    {0.5378151260504201, 0.6202404097518576, -3.989161064307651e-17},
+    {0.5333333333333333, 0.6286086594223741, 4.3538742607970387e-17},
+    {0.5289256198347108, 0.6369074622370692, 5.422955873465247e-17},
+    {0.5245901639344263, 0.6451379613735847, 9.346960920120906e-19},
+    {0.5203252032520326, 0.6533012720127457, -4.306892322029408e-17},
+    {0.5161290322580645, 0.661398482245365, -7.603333785634003e-18},
+    {0.512, 0.6694306539426292, 2.823733943928343e-17},
+    {0.5079365079365079, 0.6773988235918061, -2.0978183882652005e-18},
+    {0.5039370078740157, 0.6853040030989194, 4.893484946270261e-17},
+    {0.5, 0.6931471803691238, 1.9082149292705877e-10},
+};
+
+void fastExp(const double* x, double* out, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        out[i] = fastExp(x[i]);
+    }
+}
+
+void fastLog(const double* x, double* out, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        out[i] = fastLog(x[i]);
+    }
+}
+
+} // namespace PROPOSAL
@@ -18,6 +18,32 @@
 
 using namespace PROPOSAL;
 
+namespace {
+
+// Abscissae and weights of the 7-point Gauss-Legendre and the embedding
+// 15-point Kronrod rule on [-1, 1] (QUADPACK dqk15). Only the non-negative
+// half is stored, the last entry is the centre of the interval.
+const double gk15_xgk[8] = { 0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+                             0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+                             0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+                             0.207784955007898467600689403773245, 0.000000000000000000000000000000000 };
+
+const double gk15_wgk[8] = { 0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+                             0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+                             0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+                             0.204432940075298892414161999234649, 0.209482141084727828012999174891714 };
+
+// Gauss weights belonging to gk15_xgk[1], gk15_xgk[3], gk15_xgk[5], gk15_xgk[7]
+const double gk15_wg[4] = { 0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+                            0.381830050505118944950369775488975, 0.417959183673469387755102040816327 };
+
+// maximum number of subintervals of the adaptive Gauss-Kronrod integration
+const unsigned int gk_limit = 100;
+
+} // namespace
+
+const size_t Integral::batch_size;
+
 //----------------------------------------------------------------------------//
 //----------------------------------------------------------------------------//
 //-------------------------public member functions----------------------------//
@@ -31,11 +57,11 @@ using namespace PROPOSAL;
 //   method = 4: IntegrateWithLog
 //   method = 5: IntegrateWithLogSubstitution
 
-double Integral::Integrate(double min,
-                           double max,
-                           std::function<double(double)> integrand,
-                           int method,
-                           double powerOfSubstitution)
+double Integral::IntegrateRef(double min,
+                              double max,
+                              IntegrandRef integrand,
+                              int method,
+                              double powerOfSubstitution)
 {
     if (min == 0. && max == 0.)
     {
@@ -102,6 +128,30 @@ double Integral::IntegrateWithRandomRatio(double min,
 //----------------------------------------------------------------------------//
 //----------------------------------------------------------------------------//
 
+Integral::Quadrature Integral::GetQuadratureFromString(const std::string& name)
+{
+    std::string name_lower = name;
+    std::transform(name.begin(), name.end(), name_lower.begin(), ::tolower);
+
+    if (name_lower == "romberg")
+    {
+        return Romberg;
+    } else if (name_lower == "gausskronrod")
+    {
+        return GaussKronrod;
+    } else if (name_lower == "cubature")
+    {
+        return Cubature;
+    } else
+    {
+        log_fatal("Quadrature %s not known!", name.c_str());
+        return Romberg; // Just to prevent warnings
+    }
+}
+
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
 double Integral::GetUpperLimit()
 {
 
@@ -214,6 +264,7 @@ double Integral::IntegrateWithSubstitution(double min,
     }
 
     this->integrand_           = integrand;
+    this->integrand_ref_       = IntegrandRef(integrand_);
     this->powerOfSubstitution_ = powerOfSubstitution;
 
     if (randomRatio > 1)
@@ -281,6 +332,7 @@ double Integral::IntegrateWithLog(double min, double max, std::function<double(d
     }
 
     this->integrand_     = integrand;
+    this->integrand_ref_ = IntegrandRef(integrand_);
     powerOfSubstitution_ = 0;
 
     if (randomRatio > 1)
@@ -340,6 +392,8 @@ Integral::Integral()
     , q_last_3_results_()
     , q_rlist2_()
     , q_iord_()
+    , quadrature_(Romberg)
+    , gk_workspace_()
 {
     int aux;
     if (romberg_ <= 0)
@@ -396,8 +450,11 @@ Integral::Integral(const Integral& integral)
     , q_last_3_results_(integral.q_last_3_results_)
     , q_rlist2_(integral.q_rlist2_)
     , q_iord_(integral.q_iord_)
+    , quadrature_(integral.quadrature_)
+    , gk_workspace_()
 {
-    integrand_ = std::ref(integral.integrand_);
+    integrand_     = std::ref(integral.integrand_);
+    integrand_ref_ = integral.integrand_ref_;
 }
 
 //----------------------------------------------------------------------------//
@@ -423,6 +480,8 @@ Integral::Integral(int romberg, int maxSteps, double precision)
     , q_last_3_results_()
     , q_rlist2_()
     , q_iord_()
+    , quadrature_(Romberg)
+    , gk_workspace_()
 {
     int aux;
     if (romberg <= 0)
@@ -539,6 +598,8 @@ bool Integral::operator==(const Integral& integral) const
 
     if (powerOfSubstitution_ != integral.powerOfSubstitution_)
         return false;
+    if (quadrature_ != integral.quadrature_)
+        return false;
 
     else
         return true;
@@ -573,6 +634,7 @@ void Integral::swap(Integral& integral)
     d_.swap(integral.d_);
 
     integrand_ = std::ref(integral.integrand_);
+    swap(integrand_ref_, integral.integrand_ref_);
 
     swap(romberg4refine_, integral.romberg4refine_);
     swap(powerOfSubstitution_, integral.powerOfSubstitution_);
@@ -583,6 +645,8 @@ void Integral::swap(Integral& integral)
     swap(reverse_, integral.reverse_);
     swap(reverseX_, integral.reverseX_);
     swap(savedResult_, integral.savedResult_);
+    swap(quadrature_, integral.quadrature_);
+    gk_workspace_.swap(integral.gk_workspace_);
 }
 
 //----------------------------------------------------------------------------//
@@ -618,11 +682,11 @@ double Integral::Function(double x)
         t = std::exp(t);
         result *= t;
     }
-    result *= integrand_(t);
+    result *= integrand_ref_(t);
 
     if (result != result)
     {
-        if (integrand_(t) == 0)
+        if (integrand_ref_(t) == 0)
         {
             log_info("substitution not suitable! returning 0!");
             return 0;
@@ -638,6 +702,79 @@ double Integral::Function(double x)
 //----------------------------------------------------------------------------//
 //----------------------------------------------------------------------------//
 
+void Integral::Function(const double* x, double* out, size_t n)
+{
+    double t[batch_size] = {}, jacobian[batch_size];
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double xi = reverse_ ? reverseX_ - x[i] : x[i];
+
+        if (powerOfSubstitution_ == 0)
+        {
+            t[i]        = xi;
+            jacobian[i] = 1;
+        } else if (powerOfSubstitution_ > 0)
+        {
+            t[i]        = std::pow(xi, -powerOfSubstitution_);
+            jacobian[i] = powerOfSubstitution_ * (t[i] / xi);
+        } else
+        {
+            t[i]        = -std::pow(-xi, powerOfSubstitution_);
+            jacobian[i] = -powerOfSubstitution_ * (t[i] / xi);
+        }
+
+        if (useLog_)
+        {
+            t[i] = std::exp(t[i]);
+            jacobian[i] *= t[i];
+        }
+    }
+
+    integrand_ref_(t, out, n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double result = jacobian[i] * out[i];
+
+        if (result != result)
+        {
+            if (out[i] == 0)
+            {
+                log_info("substitution not suitable! returning 0!");
+                result = 0;
+            } else
+            {
+                log_fatal("result is nan! returning 0");
+            }
+        }
+        out[i] = result;
+    }
+}
+
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
+void Integral::SumFunction(const double* x, size_t n, double& sum)
+{
+    if (n == 0)
+    {
+        return;
+    }
+
+    double values[batch_size];
+
+    Function(x, values, n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        sum += values[i];
+    }
+}
+
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
 double Integral::Trapezoid(int n, double oldSum)
 {
     double xStep, stepSize, resultSum;
@@ -651,10 +788,21 @@ double Integral::Trapezoid(int n, double oldSum)
     stepSize  = (max_ - min_) / n;
     resultSum = 0;
 
+    // collect the new sampling points to evaluate them in blocks
+    double x[batch_size];
+    size_t points = 0;
+
     for (xStep = min_ + stepSize / 2; xStep < max_; xStep += stepSize)
     {
-        resultSum += Function(xStep);
+        x[points++] = xStep;
+
+        if (points == batch_size)
+        {
+            SumFunction(x, points, resultSum);
+            points = 0;
+        }
     }
+    SumFunction(x, points, resultSum);
 
     return (oldSum + resultSum * stepSize) / 2;
 }
@@ -674,12 +822,22 @@ double Integral::Trapezoid3(int n, double oldSum)
     stepSize  = (max_ - min_) / n;
     resultSum = 0;
 
+    double x[batch_size];
+    size_t points = 0;
+
     for (xStep = min_ + stepSize / 2; xStep < max_; xStep += stepSize)
     {
-        resultSum += Function(xStep);
+        x[points++] = xStep;
         xStep += 2 * stepSize;
-        resultSum += Function(xStep);
+        x[points++] = xStep;
+
+        if (points == batch_size)
+        {
+            SumFunction(x, points, resultSum);
+            points = 0;
+        }
     }
+    SumFunction(x, points, resultSum);
 
     return oldSum / 3 + resultSum * stepSize;
 }
@@ -1060,7 +1218,7 @@ double Integral::RombergIntegrateOpened(double bigValue)
 //----------------------------------------------------------------------------//
 //----------------------------------------------------------------------------//
 
-double Integral::InitIntegralOpenedAndClosed(double min, double max, std::function<double(double)> integrand)
+double Integral::InitIntegralOpenedAndClosed(double min, double max, IntegrandRef integrand)
 {
     double aux;
 
@@ -1078,7 +1236,7 @@ double Integral::InitIntegralOpenedAndClosed(double min, double max, std::functi
 
     this->min_           = min;
     this->max_           = max;
-    integrand_           = integrand;
+    integrand_ref_       = integrand;
     powerOfSubstitution_ = 0;
     randomDo_            = false;
 
@@ -1088,7 +1246,7 @@ double Integral::InitIntegralOpenedAndClosed(double min, double max, std::functi
 //----------------------------------------------------------------------------//
 //----------------------------------------------------------------------------//
 
-double Integral::IntegrateClosed(double min, double max, std::function<double(double)> integrand)
+double Integral::IntegrateClosed(double min, double max, IntegrandRef integrand)
 {
     double aux;
     aux = InitIntegralOpenedAndClosed(min, max, integrand);
@@ -1097,13 +1255,17 @@ double Integral::IntegrateClosed(double min, double max, std::function<double(do
     {
         return 0;
     }
+    if (quadrature_ != Romberg)
+    {
+        return aux * AdaptiveGaussKronrod();
+    }
     return aux * RombergIntegrateClosed();
 }
 
 //----------------------------------------------------------------------------------------------------//
 //----------------------------------------------------------------------------//
 
-double Integral::IntegrateOpened(double min, double max, std::function<double(double)> integrand)
+double Integral::IntegrateOpened(double min, double max, IntegrandRef integrand)
 {
     double aux;
     aux = InitIntegralOpenedAndClosed(min, max, integrand);
@@ -1113,6 +1275,10 @@ double Integral::IntegrateOpened(double min, double max, std::function<double(do
         return 0;
     }
 
+    if (quadrature_ != Romberg)
+    {
+        return aux * AdaptiveGaussKronrod();
+    }
     return aux * RombergIntegrateOpened();
 }
 
@@ -1121,7 +1287,7 @@ double Integral::IntegrateOpened(double min, double max, std::function<double(do
 
 double Integral::InitIntegralWithSubstitution(double min,
                                               double max,
-                                              std::function<double(double)> integrand,
+                                              IntegrandRef integrand,
                                               double powerOfSubstitution)
 {
     double aux;
@@ -1174,7 +1340,7 @@ double Integral::InitIntegralWithSubstitution(double min,
         this->max_ = max;
     }
 
-    this->integrand_           = integrand;
+    this->integrand_ref_       = integrand;
     this->powerOfSubstitution_ = powerOfSubstitution;
     randomNumber_              = 0;
     randomDo_                  = false;
@@ -1187,7 +1353,7 @@ double Integral::InitIntegralWithSubstitution(double min,
 
 double Integral::IntegrateWithSubstitution(double min,
                                            double max,
-                                           std::function<double(double)> integrand,
+                                           IntegrandRef integrand,
                                            double powerOfSubstitution)
 {
     double aux;
@@ -1199,6 +1365,10 @@ double Integral::IntegrateWithSubstitution(double min,
         return 0;
     }
 
+    if (quadrature_ != Romberg)
+    {
+        return aux * AdaptiveGaussKronrod();
+    }
     return aux * RombergIntegrateOpened();
 }
 
@@ -1326,7 +1496,7 @@ void Integral::RefineUpperLimit(double result)
 //----------------------------------------------------------------------------//
 //----------------------------------------------------------------------------//
 
-double Integral::InitIntegralWithLog(double min, double max, std::function<double(double)> integrand)
+double Integral::InitIntegralWithLog(double min, double max, IntegrandRef integrand)
 {
     double aux;
 
@@ -1345,7 +1515,7 @@ double Integral::InitIntegralWithLog(double min, double max, std::function<doubl
 
     this->min_           = std::log(min);
     this->max_           = std::log(max);
-    this->integrand_     = integrand;
+    this->integrand_ref_ = integrand;
     powerOfSubstitution_ = 0;
     randomNumber_        = 0;
     randomDo_            = false;
@@ -1356,7 +1526,7 @@ double Integral::InitIntegralWithLog(double min, double max, std::function<doubl
 //----------------------------------------------------------------------------//
 //----------------------------------------------------------------------------//
 
-double Integral::IntegrateWithLog(double min, double max, std::function<double(double)> integrand)
+double Integral::IntegrateWithLog(double min, double max, IntegrandRef integrand)
 {
     double aux;
 
@@ -1367,6 +1537,10 @@ double Integral::IntegrateWithLog(double min, double max, std::function<double(d
         return 0;
     }
 
+    if (quadrature_ != Romberg)
+    {
+        return aux * AdaptiveGaussKronrod();
+    }
     return aux * RombergIntegrateOpened();
 }
 
@@ -1375,7 +1549,7 @@ double Integral::IntegrateWithLog(double min, double max, std::function<double(d
 
 double Integral::InitIntegralWithLogSubstitution(double min,
                                                  double max,
-                                                 std::function<double(double)> integrand,
+                                                 IntegrandRef integrand,
                                                  double powerOfSubstitution)
 {
     double aux;
@@ -1431,7 +1605,7 @@ double Integral::InitIntegralWithLogSubstitution(double min,
         this->max_ = std::log(max);
     }
 
-    this->integrand_           = integrand;
+    this->integrand_ref_       = integrand;
     this->powerOfSubstitution_ = powerOfSubstitution;
     randomNumber_              = 0;
     randomDo_                  = false;
@@ -1444,7 +1618,7 @@ double Integral::InitIntegralWithLogSubstitution(double min,
 
 double Integral::IntegrateWithLogSubstitution(double min,
                                               double max,
-                                              std::function<double(double)> integrand,
+                                              IntegrandRef integrand,
                                               double powerOfSubstitution)
 {
 
@@ -1457,12 +1631,159 @@ double Integral::IntegrateWithLogSubstitution(double min,
         return 0;
     }
 
+    if (quadrature_ != Romberg)
+    {
+        return aux * AdaptiveGaussKronrod();
+    }
     return aux * RombergIntegrateOpened();
 }
 
 //----------------------------------------------------------------------------//
 //----------------------------------------------------------------------------//
 
+Integral::InterpolationResults Integral::GaussKronrod15(double q_min, double q_max)
+{
+    static const double q_epmach = std::numeric_limits<double>::epsilon();
+
+    double centr = 0.5 * (q_min + q_max);
+    double hlgth = 0.5 * (q_max - q_min);
+
+    // all 15 abscissae are evaluated with a single call of the integrand
+    double x[15], fval[15];
+
+    x[14] = centr;
+    for (int j = 0; j < 7; ++j)
+    {
+        double absc  = hlgth * gk15_xgk[j];
+        x[2 * j]     = centr - absc;
+        x[2 * j + 1] = centr + absc;
+    }
+    Function(x, fval, 15);
+
+    double fc     = fval[14];
+    double resg   = fc * gk15_wg[3];
+    double resk   = fc * gk15_wgk[7];
+    double resabs = std::abs(resk);
+
+    for (int j = 0; j < 7; ++j)
+    {
+        double fval1 = fval[2 * j];
+        double fval2 = fval[2 * j + 1];
+
+        double fsum = fval1 + fval2;
+        resk += gk15_wgk[j] * fsum;
+        resabs += gk15_wgk[j] * (std::abs(fval1) + std::abs(fval2));
+
+        if (j % 2 == 1)
+        {
+            resg += gk15_wg[j / 2] * fsum;
+        }
+    }
+
+    // The difference to the embedded Gauss rule is used directly as error
+    // estimate. The rescaling of QUADPACK is too pessimistic for integrands
+    // with a small numerical noise (e.g. the epair rho integrand), which would
+    // otherwise be subdivided until the limit is reached.
+    InterpolationResults result;
+    result.Value = resk * hlgth;
+    result.Error = std::max(std::abs((resk - resg) * hlgth), 50 * q_epmach * resabs * std::abs(hlgth));
+
+    return result;
+}
+
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
+double Integral::AdaptiveGaussKronrod()
+{
+    // The workspace keeps its capacity, so repeated integrations with the
+    // same Integral object do not allocate.
+    gk_workspace_.clear();
+
+    GaussKronrodInterval interval;
+    InterpolationResults gk = GaussKronrod15(min_, max_);
+    interval.min            = min_;
+    interval.max            = max_;
+    interval.value          = gk.Value;
+    interval.error          = gk.Error;
+    gk_workspace_.push_back(interval);
+
+    double result = gk.Value;
+    double error  = gk.Error;
+
+    while (error > precision_ * std::abs(result))
+    {
+        if (gk_workspace_.size() >= gk_limit)
+        {
+            // happens for integrands with numerical noise above the precision
+            log_debug("Precision %e has not been reached after %u subintervals! value = %e, abserr = %e",
+                      precision_,
+                      gk_limit,
+                      result,
+                      error);
+            break;
+        }
+
+        std::pop_heap(gk_workspace_.begin(), gk_workspace_.end());
+        GaussKronrodInterval worst = gk_workspace_.back();
+        gk_workspace_.pop_back();
+
+        double center = 0.5 * (worst.min + worst.max);
+        if (center <= worst.min || center >= worst.max)
+        {
+            // interval can not be bisected any further
+            gk_workspace_.push_back(worst);
+            std::push_heap(gk_workspace_.begin(), gk_workspace_.end());
+            break;
+        }
+
+        GaussKronrodInterval lower, upper;
+        gk          = GaussKronrod15(worst.min, center);
+        lower.min   = worst.min;
+        lower.max   = center;
+        lower.value = gk.Value;
+        lower.error = gk.Error;
+        gk          = GaussKronrod15(center, worst.max);
+        upper.min   = center;
+        upper.max   = worst.max;
+        upper.value = gk.Value;
+        upper.error = gk.Error;
+
+        result += lower.value + upper.value - worst.value;
+        error += lower.error + upper.error - worst.error;
+
+        double area = lower.value + upper.value;
+        if (lower.error + upper.error >= 0.99 * worst.error &&
+            std::abs(area - worst.value) <= 1e-5 * std::abs(area))
+        {
+            // The bisection did neither improve the error estimate nor change
+            // the value, so the interval is resolved down to the numerical
+            // noise of the integrand (same criterion as in qags). It is
+            // excluded from further refinement.
+            error -= lower.error + upper.error;
+            lower.error = 0;
+            upper.error = 0;
+        }
+
+        gk_workspace_.push_back(lower);
+        std::push_heap(gk_workspace_.begin(), gk_workspace_.end());
+        gk_workspace_.push_back(upper);
+        std::push_heap(gk_workspace_.begin(), gk_workspace_.end());
+    }
+
+    // sum up again to get rid of the cancellation in the running sum
+    result = 0;
+    for (const GaussKronrodInterval& it : gk_workspace_)
+    {
+        result += it.value;
+    }
+
+    return result;
+}
+
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
 Integral::QuadpackResults Integral::qags(double q_limit, double q_epsabs, double q_epsrel)
 {
 
@@ -2187,7 +2508,8 @@ Integral::InterpolationResults Integral::q_epsilon_extrapolation(int q_limit_eps
 
 void Integral::SetIntegrand(std::function<double(double)> integrand)
 {
-    integrand_ = integrand;
+    integrand_     = integrand;
+    integrand_ref_ = IntegrandRef(integrand_);
 }
 
 void Integral::SetMax(double max)
@@ -2260,6 +2582,11 @@ void Integral::SetSavedResult(double savedResult)
     savedResult_ = savedResult;
 }
 
+void Integral::SetQuadrature(Quadrature quadrature)
+{
+    quadrature_ = quadrature;
+}
+
 void Integral::SetUseLog(bool useLog)
 {
     useLog_ = useLog;
@@ -28,11 +28,78 @@
 #include <fstream>
 #include <sstream>
 
+#include "PROPOSAL/math/FastMath.h"
 #include "PROPOSAL/math/Interpolant.h"
 #include "PROPOSAL/Logging.h"
 
 using namespace PROPOSAL;
 
+namespace {
+
+// Intervals of adaptive grids are not bisected below this fraction of the
+// equidistant spacing, e.g. at discontinuities or for noisy functions
+const double min_interval_fraction = 1. / 16;
+
+// Number of nodes of the equidistant grid adaptive grids start with
+int StartNodes(int max, int romberg)
+{
+    return std::min(max, std::max(romberg + 1, 8));
+}
+
+// Deviation relative to the tolerated one, larger than one if the
+// interpolated value is not precise enough
+double ErrorRatio(double interpolated, double exact, double precision)
+{
+    double error = std::abs(interpolated - exact);
+
+    if (error <= precision * std::abs(exact))
+    {
+        return 0;
+    }
+    return error / (precision * std::abs(exact));
+}
+
+// Intervals to bisect in ascending order. If the budget of new nodes does not
+// suffice for all of them, the ones with the largest errors are chosen.
+std::vector<int> SelectIntervals(const std::vector<double>& ratios, int budget)
+{
+    std::vector<std::pair<double, int> > candidates;
+
+    for (unsigned int k = 0; k < ratios.size(); ++k)
+    {
+        if (ratios[k] > 1)
+        {
+            candidates.push_back(std::make_pair(ratios[k], k));
+        }
+    }
+
+    budget = std::max(budget, 0);
+
+    if (static_cast<int>(candidates.size()) > budget)
+    {
+        std::partial_sort(candidates.begin(),
+                          candidates.begin() + budget,
+                          candidates.end(),
+                          [](const std::pair<double, int>& a, const std::pair<double, int>& b) {
+                              return a.first > b.first;
+                          });
+        candidates.resize(budget);
+    }
+
+    std::vector<int> intervals;
+
+    for (const auto& candidate : candidates)
+    {
+        intervals.push_back(candidate.second);
+    }
+
+    std::sort(intervals.begin(), intervals.end());
+
+    return intervals;
+}
+
+} // namespace
+
 const double Interpolant::bigNumber_  = -300;
 const double Interpolant::aBigNumber_ = -299;
 
@@ -53,7 +120,7 @@ double Interpolant::Interpolate(double x)
     }
 
     reverse_ = true;
-    aux      = (x - xmin_) / step_;
+    aux      = GridPosition(x);
     starti_  = (int)aux;
 
     if (starti_ < 0)
@@ -96,12 +163,12 @@ double Interpolant::Interpolate(double x1, double x2)
 
     if (isLog_)
     {
-        x2 = std::log(x2);
+        x2 = fastLog(x2);
     }
 
     reverse_ = true;
 
-    aux     = (x2 - xmin_) / step_;
+    aux     = GridPosition(x2);
     starti_ = (int)aux;
 
     if (starti_ < 0)
@@ -124,7 +191,7 @@ double Interpolant::Interpolate(double x1, double x2)
 
     for (i = start; i < start + romberg_; i++)
     {
-        iY_.at(i) = Interpolant_.at(i)->Interpolate(x1);
+        iY_.at(i) = Row(i)->Interpolate(x1);
     }
 
     if (!fast_)
@@ -133,10 +200,10 @@ double Interpolant::Interpolate(double x1, double x2)
 
         for (i = start; i < start + romberg_; i++)
         {
-            if (Interpolant_.at(i)->precision_ > aux)
+            if (Row(i)->precision_ > aux)
             {
-                aux  = Interpolant_.at(i)->precision_;
-                aux2 = Interpolant_.at(i)->worstX_;
+                aux  = Row(i)->precision_;
+                aux2 = Row(i)->worstX_;
             }
         }
 
@@ -268,7 +335,7 @@ double Interpolant::InterpolateArray(double x1, double x2)
 
     for (i = start; i < start + romberg_; i++)
     {
-        iY_.at(i) = Interpolant_.at(i)->InterpolateArray(x2);
+        iY_.at(i) = Row(i)->InterpolateArray(x2);
     }
 
     if (!fast_)
@@ -278,10 +345,10 @@ double Interpolant::InterpolateArray(double x1, double x2)
 
         for (i = start; i < start + romberg_; i++)
         {
-            if (Interpolant_.at(i)->precision_ > aux)
+            if (Row(i)->precision_ > aux)
             {
-                aux  = Interpolant_.at(i)->precision_;
-                aux2 = Interpolant_.at(i)->worstX_;
+                aux  = Row(i)->precision_;
+                aux2 = Row(i)->worstX_;
             }
         }
 
@@ -342,6 +409,7 @@ double Interpolant::FindLimit(double y)
     }
 
     std::swap(romberg_, rombergY_);
+    std::swap(neville_, nevilleY_);
 
     rel       = relative_;
     relative_ = relativeY_;
@@ -386,6 +454,7 @@ double Interpolant::FindLimit(double y)
     }
 
     std::swap(romberg_, rombergY_);
+    std::swap(neville_, nevilleY_);
 
     relative_ = rel;
 
@@ -425,7 +494,7 @@ double Interpolant::FindLimit(double x1, double y)
     {
         for (i = 0; i < max_; i++)
         {
-            iY_.at(i) = Interpolant_.at(i)->Interpolate(x1);
+            iY_.at(i) = Row(i)->Interpolate(x1);
         }
     }
 
@@ -434,7 +503,10 @@ double Interpolant::FindLimit(double x1, double y)
 
     if (flag_)
     {
-        dir = Interpolant_.at(max_ - 1)->Interpolate(x1) > Interpolant_.at(0)->Interpolate(x1);
+        // the rows of compacted tables share one interpolant, so they are
+        // evaluated one after another
+        aux = Row(max_ - 1)->Interpolate(x1);
+        dir = aux > Row(0)->Interpolate(x1);
     } else
     {
         dir = iY_.at(max_ - 1) > iY_.at(0);
@@ -446,7 +518,7 @@ double Interpolant::FindLimit(double x1, double y)
 
         if (flag_)
         {
-            aux = Interpolant_.at(m)->Interpolate(x1);
+            aux = Row(m)->Interpolate(x1);
         } else
         {
             aux = iY_.at(m);
@@ -471,6 +543,7 @@ double Interpolant::FindLimit(double x1, double y)
     }
 
     std::swap(romberg_, rombergY_);
+    std::swap(neville_, nevilleY_);
     std::swap(relative_, relativeY_);
 
     if (i + 1 < max_)
@@ -478,8 +551,8 @@ double Interpolant::FindLimit(double x1, double y)
         // iX_ is not pre-filled if flag is true. Fill the bits we're about to use.
         if (flag_)
         {
-            iX_.at(i) = Interpolant_.at(i)->Interpolate(x1);
-            iX_.at(i+1) = Interpolant_.at(i+1)->Interpolate(x1);
+            iX_.at(i) = Row(i)->Interpolate(x1);
+            iX_.at(i+1) = Row(i+1)->Interpolate(x1);
         }
         if (((y - iX_.at(i)) < (iX_.at(i + 1) - y)) == dir)
         {
@@ -510,7 +583,7 @@ double Interpolant::FindLimit(double x1, double y)
     {
         for (i = start; i < start + romberg_; i++)
         {
-            iX_.at(i) = Interpolant_.at(i)->Interpolate(x1);
+            iX_.at(i) = Row(i)->Interpolate(x1);
         }
     }
 
@@ -526,6 +599,7 @@ double Interpolant::FindLimit(double x1, double y)
     }
 
     std::swap(romberg_, rombergY_);
+    std::swap(neville_, nevilleY_);
     std::swap(relative_, relativeY_);
 
     if (result < xmin_)
@@ -542,10 +616,10 @@ double Interpolant::FindLimit(double x1, double y)
 
         for (i = start; i < start + romberg_; i++)
         {
-            if (Interpolant_.at(i)->precision_ > aux)
+            if (Row(i)->precision_ > aux)
             {
-                aux  = Interpolant_.at(i)->precision_;
-                aux2 = Interpolant_.at(i)->worstX_;
+                aux  = Row(i)->precision_;
+                aux2 = Row(i)->worstX_;
             }
         }
 
@@ -558,12 +632,202 @@ double Interpolant::FindLimit(double x1, double y)
 
     if (isLog_)
     {
-        result = std::exp(result);
+        result = fastExp(result);
     }
 
     return result;
 }
 
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
+void Interpolant::Scale(double factor)
+{
+    if (factor == 1.)
+    {
+        return;
+    }
+
+    if (flat_row_ != NULL)
+    {
+        if (!flat_values_float_.empty())
+        {
+            flat_values_.assign(flat_values_float_.begin(), flat_values_float_.end());
+            flat_values_float_.clear();
+            flat_values_float_.shrink_to_fit();
+        }
+
+        for (auto& y : flat_values_)
+        {
+            if (flat_row_->logSubst_)
+            {
+                if (y != bigNumber_)
+                {
+                    y += std::log(factor);
+                }
+            } else
+            {
+                y *= factor;
+            }
+        }
+
+        // the rescaled values are rounded again
+        StoreFlatValues();
+        return;
+    }
+
+    // 2d interpolants keep their values in the interpolants of every row
+    if (!Interpolant_.empty())
+    {
+        for (auto interpolant : Interpolant_)
+        {
+            interpolant->Scale(factor);
+        }
+        return;
+    }
+
+    for (auto& y : iY_)
+    {
+        if (logSubst_)
+        {
+            if (y != bigNumber_)
+            {
+                y += std::log(factor);
+            }
+        } else
+        {
+            y *= factor;
+        }
+    }
+
+    for (auto& row : iY2_)
+    {
+        for (auto& y : row)
+        {
+            y *= factor;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
+void Interpolant::Append(const Interpolant& extension)
+{
+    if (flat_row_ != NULL || extension.flat_row_ != NULL)
+    {
+        log_fatal("Compacted interpolants can not be extended!");
+    }
+
+    if (Interpolant_.size() != extension.Interpolant_.size())
+    {
+        log_fatal("Can not append an interpolant of different dimension or number of rows!");
+    }
+
+    // 2d interpolants keep the x1 grid in the interpolants of every row
+    if (!Interpolant_.empty())
+    {
+        for (unsigned int i = 0; i < Interpolant_.size(); ++i)
+        {
+            Interpolant_[i]->Append(*extension.Interpolant_[i]);
+        }
+        return;
+    }
+
+    bool uniform = lookup_.empty() && extension.lookup_.empty();
+    int first    = 0;
+
+    if (uniform)
+    {
+        if (isLog_ != extension.isLog_ || logSubst_ != extension.logSubst_ ||
+            std::abs(extension.step_ - step_) > 1e-6 * std::abs(step_) ||
+            std::abs(extension.xmin_ - xmax_) > 1e-6 * std::abs(step_))
+        {
+            log_fatal("The appended interpolant does not continue the grid of the interpolant!");
+        }
+    } else
+    {
+        // adaptive grids include the boundaries, so the first node of the
+        // extension may coincide with the last one of this interpolant
+        while (first < extension.max_ && extension.iX_[first] <= iX_.back())
+        {
+            ++first;
+        }
+
+        if (isLog_ != extension.isLog_ || logSubst_ != extension.logSubst_ || first == extension.max_)
+        {
+            log_fatal("The appended interpolant does not continue the grid of the interpolant!");
+        }
+    }
+
+    iX_.insert(iX_.end(), extension.iX_.begin() + first, extension.iX_.end());
+    iY_.insert(iY_.end(), extension.iY_.begin() + first, extension.iY_.end());
+
+    max_ += extension.max_ - first;
+    xmax_ = extension.xmax_;
+    flag_ = (std::log(max_) / std::log(2) + romberg_) < max_;
+
+    if (!uniform)
+    {
+        step_ = (xmax_ - xmin_) / max_;
+        InitLookup();
+    }
+}
+
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
+bool Interpolant::Compact(double precision)
+{
+    if (Interpolant_.empty())
+    {
+        return false;
+    }
+
+    const Interpolant& first = *Interpolant_.front();
+
+    for (auto row : Interpolant_)
+    {
+        if (row->iX_ != first.iX_ || row->romberg_ != first.romberg_ || row->rombergY_ != first.rombergY_ ||
+            row->rational_ != first.rational_ || row->relative_ != first.relative_ || row->isLog_ != first.isLog_ ||
+            row->logSubst_ != first.logSubst_ || row->fast_ != first.fast_ || row->self_ != first.self_)
+        {
+            log_debug("The rows do not share their grid, the table is not compacted.");
+            return false;
+        }
+    }
+
+    int nodes = first.max_;
+
+    flat_values_.clear();
+    flat_values_.reserve(max_ * nodes);
+
+    for (auto row : Interpolant_)
+    {
+        flat_values_.insert(flat_values_.end(), row->iY_.begin(), row->iY_.end());
+    }
+
+    flat_row_ = new Interpolant(first);
+    flat_row_->iY_.clear();
+    flat_row_->iY_.shrink_to_fit();
+    flat_row_->function1d_ = NULL;
+    flat_row_->function2d_ = NULL;
+
+    for (auto row : Interpolant_)
+    {
+        delete row;
+    }
+
+    Interpolant_.clear();
+    Interpolant_.shrink_to_fit();
+
+    storage_precision_ = precision;
+    storage_error_     = 0;
+    StoreFlatValues();
+
+    return true;
+}
+
 //----------------------------------------------------------------------------//
 //----------------------------------------------------------------------------//
 //--------------------------------Save and Load-------------------------------//
@@ -652,7 +916,7 @@ bool Interpolant::Save(std::ofstream& out, bool binary_tables)
             for (int i = 0; i < max_; i++)
             {
                 out.write(reinterpret_cast<char*>(&iX_.at(i)), sizeof iX_.at(i));
-                Interpolant_.at(i)->Save(out, binary_tables);
+                Row(i)->Save(out, binary_tables);
             }
         } else
         {
@@ -682,8 +946,10 @@ bool Interpolant::Save(std::ofstream& out, bool binary_tables)
 
             for (int i = 0; i < max_; i++)
             {
+                double y = Value(i);
+
                 out.write(reinterpret_cast<char*>(&iX_.at(i)), sizeof iX_.at(i));
-                out.write(reinterpret_cast<char*>(&iY_.at(i)), sizeof iY_.at(i));
+                out.write(reinterpret_cast<char*>(&y), sizeof y);
             }
         }
     } else
@@ -705,7 +971,7 @@ bool Interpolant::Save(std::ofstream& out, bool binary_tables)
             for (int i = 0; i < max_; i++)
             {
                 out << iX_.at(i) << std::endl;
-                Interpolant_.at(i)->Save(out, binary_tables);
+                Row(i)->Save(out, binary_tables);
             }
         } else
         {
@@ -721,7 +987,7 @@ bool Interpolant::Save(std::ofstream& out, bool binary_tables)
 
             for (int i = 0; i < max_; i++)
             {
-                out << iX_.at(i) << "\t" << iY_.at(i) << std::endl;
+                out << iX_.at(i) << "\t" << Value(i) << std::endl;
             }
         }
     }
@@ -876,6 +1142,11 @@ bool Interpolant::Load(std::ifstream& in, bool binary_tables)
             }
         }
     }
+
+    // the file format is the same for all grids, the nodes tell whether the
+    // grid is equidistant
+    InitLookup();
+
     return 1;
 }
 
@@ -919,7 +1190,19 @@ Interpolant::Interpolant()
     , fast_(true)
     , x_save_(0)
     , y_save_(0)
+    , lookup_()
+    , lookup_scale_(0)
+    , flat_row_(NULL)
+    , flat_values_()
+    , flat_values_float_()
+    , storage_precision_(0)
+    , storage_error_(0)
+    , values_(NULL)
+    , values_float_(NULL)
+    , neville_(NULL)
+    , nevilleY_(NULL)
 {
+    InitNeville();
 }
 
 //----------------------------------------------------------------------------//
@@ -956,6 +1239,17 @@ Interpolant::Interpolant(const Interpolant& interpolant)
     , fast_(interpolant.fast_)
     , x_save_(interpolant.x_save_)
     , y_save_(interpolant.y_save_)
+    , lookup_(interpolant.lookup_)
+    , lookup_scale_(interpolant.lookup_scale_)
+    , flat_row_(NULL)
+    , flat_values_(interpolant.flat_values_)
+    , flat_values_float_(interpolant.flat_values_float_)
+    , storage_precision_(interpolant.storage_precision_)
+    , storage_error_(interpolant.storage_error_)
+    , values_(NULL)
+    , values_float_(NULL)
+    , neville_(interpolant.neville_)
+    , nevilleY_(interpolant.nevilleY_)
 
 {
     Interpolant_.resize(interpolant.Interpolant_.size());
@@ -965,6 +1259,11 @@ Interpolant::Interpolant(const Interpolant& interpolant)
         Interpolant_.at(i) = new Interpolant(*interpolant.Interpolant_.at(i));
     }
 
+    if (interpolant.flat_row_ != NULL)
+    {
+        flat_row_ = new Interpolant(*interpolant.flat_row_);
+    }
+
     function1d_ = std::ref(interpolant.function1d_);
     function2d_ = std::ref(interpolant.function2d_);
 }
@@ -1017,6 +1316,17 @@ Interpolant::Interpolant(int max,
     , fast_(true)
     , x_save_(1)
     , y_save_(0)
+    , lookup_()
+    , lookup_scale_(0)
+    , flat_row_(NULL)
+    , flat_values_()
+    , flat_values_float_()
+    , storage_precision_(0)
+    , storage_error_(0)
+    , values_(NULL)
+    , values_float_(NULL)
+    , neville_(NULL)
+    , nevilleY_(NULL)
 {
     InitInterpolant(max, xmin, xmax, romberg, rational, relative, isLog, rombergY, rationalY, relativeY, logSubst);
 
@@ -1105,6 +1415,17 @@ Interpolant::Interpolant(int max1,
     , fast_(true)
     , x_save_(1)
     , y_save_(0)
+    , lookup_()
+    , lookup_scale_(0)
+    , flat_row_(NULL)
+    , flat_values_()
+    , flat_values_float_()
+    , storage_precision_(0)
+    , storage_error_(0)
+    , values_(NULL)
+    , values_float_(NULL)
+    , neville_(NULL)
+    , nevilleY_(NULL)
 {
     InitInterpolant(
         max2, x2min, x2max, romberg2, rational2, relative2, isLog2, rombergY, rationalY, relativeY, logSubst);
@@ -1144,7 +1465,19 @@ Interpolant::Interpolant(int max1,
 //----------------------------------------------------------------------------//
 //----------------------------------------------------------------------------//
 
-Interpolant::Interpolant(std::vector<double> x, std::vector<double> y, int romberg, bool rational, bool relative)
+Interpolant::Interpolant(int max,
+                         double xmin,
+                         double xmax,
+                         std::function<double(double)> function1d,
+                         int romberg,
+                         bool rational,
+                         bool relative,
+                         bool isLog,
+                         int rombergY,
+                         bool rationalY,
+                         bool relativeY,
+                         bool logSubst,
+                         double precision)
     : romberg_(1.)
     , rombergY_(1.)
     , iX_()
@@ -1178,117 +1511,494 @@ Interpolant::Interpolant(std::vector<double> x, std::vector<double> y, int rombe
     , fast_(true)
     , x_save_(1)
     , y_save_(0)
+    , lookup_()
+    , lookup_scale_(0)
+    , flat_row_(NULL)
+    , flat_values_()
+    , flat_values_float_()
+    , storage_precision_(0)
+    , storage_error_(0)
+    , values_(NULL)
+    , values_float_(NULL)
+    , neville_(NULL)
+    , nevilleY_(NULL)
 {
-    InitInterpolant(std::min(x.size(), y.size()),
-                    x.at(0),
-                    x.at(x.size() - 1),
-                    romberg,
-                    rational,
-                    relative,
-                    false,
-                    romberg,
-                    rational,
-                    relative,
-                    false);
-
-    if (x.size() != y.size())
-    {
-        log_fatal("size of x(%i) and y(%i) do not match!", (int)(x.size()), (int)(y.size()));
-    }
+    InitInterpolant(max, xmin, xmax, romberg, rational, relative, isLog, rombergY, rationalY, relativeY, logSubst);
 
-    for (int i = 0; i < (int)x.size(); i++)
-    {
-        iX_.at(i) = x.at(i);
-    }
+    function1d_ = function1d;
 
-    for (int i = 0; i < (int)y.size(); i++)
-    {
-        iY_.at(i) = y.at(i);
-    }
-}
+    // function value as stored in iY_
+    auto value = [this](double x) {
+        double y = function1d_(isLog_ ? std::exp(x) : x);
+        return logSubst_ ? Log(y) : y;
+    };
 
-//----------------------------------------------------------------------------//
-//----------------------------------------------------------------------------//
+    int max_nodes = max_;
+    int nodes     = StartNodes(max_nodes, romberg_);
+    double width  = xmax_ - xmin_;
 
-Interpolant::Interpolant(std::vector<double> x1, std::vector<double> x2, std::vector< std::vector<double> > y, int romberg1, bool rational1, bool relative1 , int romberg2, bool rational2, bool relative2)
-        : romberg_(1.)
-        , rombergY_(1.)
-        , iX_()
-        , iY_()
-        , iY2_()
-        , c_()
-        , d_()
-        , max_(1.)
-        , xmin_(1.)
-        , xmax_(1.)
-        , step_(0)
-        , rational_(false)
-        , relative_(false)
-        , function1d_(NULL)
-        , function2d_(NULL)
-        , Interpolant_()
-        , row_(0)
-        , starti_(0)
-        , rationalY_(false)
-        , relativeY_(false)
-        , reverse_(false)
-        , self_(true)
-        , flag_(false)
-        , isLog_(false)
-        , logSubst_(false)
-        , precision_(0)
-        , worstX_(0)
-        , precision2_(0)
-        , worstX2_(0)
-        , precisionY_(0)
-        , worstY_(0)
-        , fast_(true)
-        , x_save_(1)
-        , y_save_(0)
-{
+    std::vector<double> x(nodes), y(nodes);
 
-    //TODO: Not sure what is happening in the romberg=0 case
-    if (romberg1 <= 0)
+    for (int i = 0; i < nodes; i++)
     {
-        log_warn("romberg1 = %i must be > 0! setting to 1!", romberg1);
-        romberg1 = 1;
+        x[i] = (nodes > 1) ? xmin_ + i * width / (nodes - 1) : xmin_;
+        y[i] = value(x[i]);
     }
 
-    if (romberg2 <= 0)
-    {
-        log_warn("romberg2 = %i must be > 0! setting to 1!", romberg2);
-        romberg2 = 1;
-    }
+    double min_width = min_interval_fraction * width / max_nodes;
 
-    InitInterpolant(std::min(x1.size(), y.size()),
-                    x1.at(0),
-                    x1.at(x1.size() - 1),
-                    romberg1,
-                    rational1,
-                    relative1,
-                    false,
-                    romberg1,
-                    rational1,
-                    relative1,
-                    false);
+    // function is zero below thresholds, where no relative error is defined
+    double zero = logSubst_ ? bigNumber_ : 0;
 
-    if (x2.size() != y[0].size())
-    {
-        log_fatal("size of x2(%i) and y(%i) do not match!", (int)(x2.size()), (int)(y[0].size()));
-    }
+    // exact values at the centers of the intervals, NAN if not known yet
+    std::vector<double> center_y(nodes - 1, NAN);
 
-    if (x1.size() != y.size())
+    while (true)
     {
-        log_fatal("size of x1(%i) and y(%i) do not match!", (int)(x1.size()), (int)(y.size()));
-    }
+        SetGrid(x, y);
 
+        std::vector<double> ratios(nodes - 1, 0);
 
-    Interpolant_.resize((int)x1.size());
+        for (int k = 0; k < nodes - 1; k++)
+        {
+            if (x[k + 1] - x[k] <= min_width)
+            {
+                continue;
+            }
 
-    iY2_.resize(y.size());
-    for (int i = 0; i < (int)iY2_.size(); i++)
-    {
-        iY2_[i].resize(y[i].size());
+            double center = 0.5 * (x[k] + x[k + 1]);
+
+            if (std::isnan(center_y[k]))
+            {
+                center_y[k] = value(center);
+            }
+
+            if (center_y[k] != zero)
+            {
+                double exact = logSubst_ ? Exp(center_y[k]) : center_y[k];
+                ratios[k]    = ErrorRatio(Interpolate(isLog_ ? std::exp(center) : center), exact, precision);
+            }
+        }
+
+        std::vector<int> intervals = SelectIntervals(ratios, max_nodes - nodes);
+
+        if (intervals.empty())
+        {
+            if (!ratios.empty() && *std::max_element(ratios.begin(), ratios.end()) > 1)
+            {
+                log_debug("Interpolation precision %g not reached with %i nodes!", precision, nodes);
+            }
+            break;
+        }
+
+        std::vector<double> x_new, y_new, center_y_new;
+        unsigned int next = 0;
+
+        for (int k = 0; k < nodes; k++)
+        {
+            x_new.push_back(x[k]);
+            y_new.push_back(y[k]);
+
+            if (k == nodes - 1)
+            {
+                break;
+            }
+
+            if (next < intervals.size() && intervals[next] == k)
+            {
+                x_new.push_back(0.5 * (x[k] + x[k + 1]));
+                y_new.push_back(center_y[k]);
+                center_y_new.push_back(NAN);
+                center_y_new.push_back(NAN);
+                ++next;
+            } else
+            {
+                center_y_new.push_back(center_y[k]);
+            }
+        }
+
+        x.swap(x_new);
+        y.swap(y_new);
+        center_y.swap(center_y_new);
+        nodes = x.size();
+    }
+}
+
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
+Interpolant::Interpolant(int max1,
+                         double x1min,
+                         double x1max,
+                         int max2,
+                         double x2min,
+                         double x2max,
+                         std::function<double(double, double)> function2d,
+                         int romberg1,
+                         bool rational1,
+                         bool relative1,
+                         bool isLog1,
+                         int romberg2,
+                         bool rational2,
+                         bool relative2,
+                         bool isLog2,
+                         int rombergY,
+                         bool rationalY,
+                         bool relativeY,
+                         bool logSubst,
+                         double precision)
+    : romberg_(1.)
+    , rombergY_(1.)
+    , iX_()
+    , iY_()
+    , c_()
+    , d_()
+    , max_(1.)
+    , xmin_(1.)
+    , xmax_(1.)
+    , step_(0)
+    , rational_(false)
+    , relative_(false)
+    , function1d_(NULL)
+    , function2d_(NULL)
+    , Interpolant_()
+    , row_(0)
+    , starti_(0)
+    , rationalY_(false)
+    , relativeY_(false)
+    , reverse_(false)
+    , self_(true)
+    , flag_(false)
+    , isLog_(false)
+    , logSubst_(false)
+    , precision_(0)
+    , worstX_(0)
+    , precision2_(0)
+    , worstX2_(0)
+    , precisionY_(0)
+    , worstY_(0)
+    , fast_(true)
+    , x_save_(1)
+    , y_save_(0)
+    , lookup_()
+    , lookup_scale_(0)
+    , flat_row_(NULL)
+    , flat_values_()
+    , flat_values_float_()
+    , storage_precision_(0)
+    , storage_error_(0)
+    , values_(NULL)
+    , values_float_(NULL)
+    , neville_(NULL)
+    , nevilleY_(NULL)
+{
+    InitInterpolant(
+        max2, x2min, x2max, romberg2, rational2, relative2, isLog2, rombergY, rationalY, relativeY, logSubst);
+
+    function2d_ = function2d;
+    function1d_ = std::bind(&Interpolant::Get2dFunctionFixedY, this, std::placeholders::_1);
+
+    // adaptive row at the (log substituted) x2
+    auto row = [&](double x2) {
+        double x2aux = isLog_ ? std::exp(x2) : x2;
+
+        return new Interpolant(max1,
+                               x1min,
+                               x1max,
+                               [this, x2aux](double x1) { return function2d_(x1, x2aux); },
+                               romberg1,
+                               rational1,
+                               relative1,
+                               isLog1,
+                               rombergY,
+                               rationalY,
+                               relativeY,
+                               logSubst_,
+                               precision);
+    };
+
+    int max_nodes = max_;
+    int nodes     = StartNodes(max_nodes, romberg_);
+    double width  = xmax_ - xmin_;
+
+    std::vector<double> x(nodes);
+    std::vector<Interpolant*> rows(nodes);
+
+    for (int i = 0; i < nodes; i++)
+    {
+        x[i]           = (nodes > 1) ? xmin_ + i * width / (nodes - 1) : xmin_;
+        rows[i]        = row(x[i]);
+        rows[i]->self_ = false;
+    }
+
+    double min_width = min_interval_fraction * width / max_nodes;
+
+    // rows at the centers of the intervals, NULL if not built yet
+    std::vector<Interpolant*> center_rows(nodes - 1, NULL);
+
+    while (true)
+    {
+        // iY_ is only the workspace for the values of the rows
+        Interpolant_ = rows;
+        SetGrid(x, std::vector<double>(nodes, 0));
+
+        std::vector<double> ratios(nodes - 1, 0);
+
+        for (int k = 0; k < nodes - 1; k++)
+        {
+            if (x[k + 1] - x[k] <= min_width)
+            {
+                continue;
+            }
+
+            double center = 0.5 * (x[k] + x[k + 1]);
+
+            if (center_rows[k] == NULL)
+            {
+                center_rows[k] = row(center);
+            }
+
+            // the nodes of the new row are exact values along x1
+            Interpolant* check = center_rows[k];
+            int samples        = std::min(check->max_, 8);
+
+            for (int j = 0; j < samples; j++)
+            {
+                int n        = (samples > 1) ? j * (check->max_ - 1) / (samples - 1) : 0;
+                double x1    = check->isLog_ ? std::exp(check->iX_[n]) : check->iX_[n];
+                double exact = logSubst_ ? Exp(check->iY_[n]) : check->iY_[n];
+
+                if (exact != 0)
+                {
+                    ratios[k] = std::max(
+                        ratios[k], ErrorRatio(Interpolate(x1, isLog_ ? std::exp(center) : center), exact, precision));
+                }
+            }
+        }
+
+        std::vector<int> intervals = SelectIntervals(ratios, max_nodes - nodes);
+
+        if (intervals.empty())
+        {
+            if (!ratios.empty() && *std::max_element(ratios.begin(), ratios.end()) > 1)
+            {
+                log_debug("Interpolation precision %g not reached with %i rows!", precision, nodes);
+            }
+            break;
+        }
+
+        std::vector<double> x_new;
+        std::vector<Interpolant*> rows_new, center_rows_new;
+        unsigned int next = 0;
+
+        for (int k = 0; k < nodes; k++)
+        {
+            x_new.push_back(x[k]);
+            rows_new.push_back(rows[k]);
+
+            if (k == nodes - 1)
+            {
+                break;
+            }
+
+            if (next < intervals.size() && intervals[next] == k)
+            {
+                x_new.push_back(0.5 * (x[k] + x[k + 1]));
+                rows_new.push_back(center_rows[k]);
+                rows_new.back()->self_ = false;
+                center_rows_new.push_back(NULL);
+                center_rows_new.push_back(NULL);
+                ++next;
+            } else
+            {
+                center_rows_new.push_back(center_rows[k]);
+            }
+        }
+
+        x.swap(x_new);
+        rows.swap(rows_new);
+        center_rows.swap(center_rows_new);
+        nodes = x.size();
+    }
+
+    for (auto center_row : center_rows)
+    {
+        delete center_row;
+    }
+
+    precision2_ = 0;
+}
+
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
+Interpolant::Interpolant(std::vector<double> x, std::vector<double> y, int romberg, bool rational, bool relative)
+    : romberg_(1.)
+    , rombergY_(1.)
+    , iX_()
+    , iY_()
+    , c_()
+    , d_()
+    , max_(1.)
+    , xmin_(1.)
+    , xmax_(1.)
+    , step_(0)
+    , rational_(false)
+    , relative_(false)
+    , function1d_(NULL)
+    , function2d_(NULL)
+    , Interpolant_()
+    , row_(0)
+    , starti_(0)
+    , rationalY_(false)
+    , relativeY_(false)
+    , reverse_(false)
+    , self_(true)
+    , flag_(false)
+    , isLog_(false)
+    , logSubst_(false)
+    , precision_(0)
+    , worstX_(0)
+    , precision2_(0)
+    , worstX2_(0)
+    , precisionY_(0)
+    , worstY_(0)
+    , fast_(true)
+    , x_save_(1)
+    , y_save_(0)
+    , lookup_()
+    , lookup_scale_(0)
+    , flat_row_(NULL)
+    , flat_values_()
+    , flat_values_float_()
+    , storage_precision_(0)
+    , storage_error_(0)
+    , values_(NULL)
+    , values_float_(NULL)
+    , neville_(NULL)
+    , nevilleY_(NULL)
+{
+    InitInterpolant(std::min(x.size(), y.size()),
+                    x.at(0),
+                    x.at(x.size() - 1),
+                    romberg,
+                    rational,
+                    relative,
+                    false,
+                    romberg,
+                    rational,
+                    relative,
+                    false);
+
+    if (x.size() != y.size())
+    {
+        log_fatal("size of x(%i) and y(%i) do not match!", (int)(x.size()), (int)(y.size()));
+    }
+
+    for (int i = 0; i < (int)x.size(); i++)
+    {
+        iX_.at(i) = x.at(i);
+    }
+
+    for (int i = 0; i < (int)y.size(); i++)
+    {
+        iY_.at(i) = y.at(i);
+    }
+}
+
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
+Interpolant::Interpolant(std::vector<double> x1, std::vector<double> x2, std::vector< std::vector<double> > y, int romberg1, bool rational1, bool relative1 , int romberg2, bool rational2, bool relative2)
+        : romberg_(1.)
+        , rombergY_(1.)
+        , iX_()
+        , iY_()
+        , iY2_()
+        , c_()
+        , d_()
+        , max_(1.)
+        , xmin_(1.)
+        , xmax_(1.)
+        , step_(0)
+        , rational_(false)
+        , relative_(false)
+        , function1d_(NULL)
+        , function2d_(NULL)
+        , Interpolant_()
+        , row_(0)
+        , starti_(0)
+        , rationalY_(false)
+        , relativeY_(false)
+        , reverse_(false)
+        , self_(true)
+        , flag_(false)
+        , isLog_(false)
+        , logSubst_(false)
+        , precision_(0)
+        , worstX_(0)
+        , precision2_(0)
+        , worstX2_(0)
+        , precisionY_(0)
+        , worstY_(0)
+        , fast_(true)
+        , x_save_(1)
+        , y_save_(0)
+        , lookup_()
+        , lookup_scale_(0)
+        , flat_row_(NULL)
+        , flat_values_()
+        , flat_values_float_()
+        , storage_precision_(0)
+        , storage_error_(0)
+        , values_(NULL)
+        , values_float_(NULL)
+        , neville_(NULL)
+        , nevilleY_(NULL)
+{
+
+    //TODO: Not sure what is happening in the romberg=0 case
+    if (romberg1 <= 0)
+    {
+        log_warn("romberg1 = %i must be > 0! setting to 1!", romberg1);
+        romberg1 = 1;
+    }
+
+    if (romberg2 <= 0)
+    {
+        log_warn("romberg2 = %i must be > 0! setting to 1!", romberg2);
+        romberg2 = 1;
+    }
+
+    InitInterpolant(std::min(x1.size(), y.size()),
+                    x1.at(0),
+                    x1.at(x1.size() - 1),
+                    romberg1,
+                    rational1,
+                    relative1,
+                    false,
+                    romberg1,
+                    rational1,
+                    relative1,
+                    false);
+
+    if (x2.size() != y[0].size())
+    {
+        log_fatal("size of x2(%i) and y(%i) do not match!", (int)(x2.size()), (int)(y[0].size()));
+    }
+
+    if (x1.size() != y.size())
+    {
+        log_fatal("size of x1(%i) and y(%i) do not match!", (int)(x1.size()), (int)(y.size()));
+    }
+
+
+    Interpolant_.resize((int)x1.size());
+
+    iY2_.resize(y.size());
+    for (int i = 0; i < (int)iY2_.size(); i++)
+    {
+        iY2_[i].resize(y[i].size());
         for(int j=0; j < (int)iY2_[i].size(); j++){
             iY2_.at(i).at(j) = y.at(i).at(j);
         }
@@ -1348,6 +2058,17 @@ Interpolant::Interpolant(std::vector<double> x1, std::vector< std::vector<double
         , fast_(true)
         , x_save_(1)
         , y_save_(0)
+        , lookup_()
+        , lookup_scale_(0)
+        , flat_row_(NULL)
+        , flat_values_()
+        , flat_values_float_()
+        , storage_precision_(0)
+        , storage_error_(0)
+        , values_(NULL)
+        , values_float_(NULL)
+        , neville_(NULL)
+        , nevilleY_(NULL)
 {
 
     //TODO: Not sure what is happening in the romberg=0 case
@@ -1532,6 +2253,14 @@ bool Interpolant::operator==(const Interpolant& interpolant) const
         if (*Interpolant_.at(i) != *interpolant.Interpolant_.at(i))
             return false;
     }
+    if ((flat_row_ == NULL) != (interpolant.flat_row_ == NULL))
+        return false;
+    if (flat_row_ != NULL && *flat_row_ != *interpolant.flat_row_)
+        return false;
+    if (flat_values_ != interpolant.flat_values_)
+        return false;
+    if (flat_values_float_ != interpolant.flat_values_float_)
+        return false;
     // else
     return true;
 }
@@ -1578,6 +2307,14 @@ void Interpolant::swap(Interpolant& interpolant)
     swap(fast_, interpolant.fast_);
     swap(x_save_, interpolant.x_save_);
     swap(y_save_, interpolant.y_save_);
+    swap(lookup_scale_, interpolant.lookup_scale_);
+    swap(flat_row_, interpolant.flat_row_);
+    swap(storage_precision_, interpolant.storage_precision_);
+    swap(storage_error_, interpolant.storage_error_);
+    swap(values_, interpolant.values_);
+    swap(values_float_, interpolant.values_float_);
+    swap(neville_, interpolant.neville_);
+    swap(nevilleY_, interpolant.nevilleY_);
 
     iX_.swap(interpolant.iX_);
     iY_.swap(interpolant.iY_);
@@ -1586,6 +2323,11 @@ void Interpolant::swap(Interpolant& interpolant)
     d_.swap(interpolant.d_);
 
     Interpolant_.swap(interpolant.Interpolant_);
+
+    lookup_.swap(interpolant.lookup_);
+
+    flat_values_.swap(interpolant.flat_values_);
+    flat_values_float_.swap(interpolant.flat_values_float_);
 }
 
 //----------------------------------------------------------------------------//
@@ -1705,6 +2447,8 @@ void Interpolant::InitInterpolant(int max,
     this->relative_  = relative;
     this->rationalY_ = rationalY;
     this->relativeY_ = relativeY;
+
+    InitNeville();
 }
 
 //----------------------------------------------------------------------------//
@@ -1724,12 +2468,184 @@ double Interpolant::Get2dFunctionFixedY(double x)
 //----------------------------------------------------------------------------//
 //----------------------------------------------------------------------------//
 
+double Interpolant::GridPosition(double x)
+{
+    if (lookup_.empty())
+    {
+        return (x - xmin_) / step_;
+    }
+
+    int buckets   = lookup_.size() - 1;
+    double bucket = (x - iX_.front()) * lookup_scale_;
+    int b;
+
+    if (bucket <= 0)
+    {
+        b = 0;
+    } else if (bucket >= buckets)
+    {
+        b = buckets - 1;
+    } else
+    {
+        b = static_cast<int>(bucket);
+    }
+
+    // the last node below x lies between the ones of the bucket boundaries
+    int i = lookup_[b];
+    int j = lookup_[b + 1];
+
+    while (i < j)
+    {
+        int m = (i + j + 1) / 2;
+
+        if (iX_[m] <= x)
+        {
+            i = m;
+        } else
+        {
+            j = m - 1;
+        }
+    }
+
+    return i + 0.5 + (x - iX_[i]) / (iX_[i + 1] - iX_[i]);
+}
+
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
+void Interpolant::InitLookup()
+{
+    lookup_.clear();
+    lookup_scale_ = 0;
+
+    if (max_ < 2 || static_cast<int>(iX_.size()) != max_)
+    {
+        return;
+    }
+
+    bool uniform = true;
+
+    for (int i = 0; i < max_ && uniform; i++)
+    {
+        uniform = std::abs(iX_[i] - (xmin_ + (i + 0.5) * step_)) <= 1e-6 * std::abs(step_);
+    }
+
+    if (uniform)
+    {
+        return;
+    }
+
+    // twice as many buckets as nodes, so most of the searches are done
+    // after one or two comparisons
+    int buckets   = 2 * max_;
+    lookup_scale_ = buckets / (iX_.back() - iX_.front());
+    lookup_.resize(buckets + 1);
+
+    int i = 0;
+
+    for (int b = 0; b <= buckets; b++)
+    {
+        double edge = iX_.front() + b / lookup_scale_;
+
+        while (i + 2 < max_ && iX_[i + 1] <= edge)
+        {
+            ++i;
+        }
+
+        lookup_[b] = i;
+    }
+}
+
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
+void Interpolant::SetGrid(const std::vector<double>& x, const std::vector<double>& y)
+{
+    iX_   = x;
+    iY_   = y;
+    max_  = x.size();
+    xmin_ = x.front();
+    xmax_ = x.back();
+    step_ = (xmax_ - xmin_) / max_;
+    flag_ = (std::log(max_) / std::log(2) + romberg_) < max_;
+
+    InitLookup();
+}
+
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
+Interpolant* Interpolant::Row(int i)
+{
+    if (flat_row_ == NULL)
+    {
+        return Interpolant_.at(i);
+    }
+
+    if (flat_values_float_.empty())
+    {
+        flat_row_->values_       = &flat_values_.at(i * flat_row_->max_);
+        flat_row_->values_float_ = NULL;
+    } else
+    {
+        flat_row_->values_       = NULL;
+        flat_row_->values_float_ = &flat_values_float_.at(i * flat_row_->max_);
+    }
+
+    return flat_row_;
+}
+
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
+void Interpolant::StoreFlatValues()
+{
+    if (storage_precision_ <= 0 || flat_values_.empty())
+    {
+        return;
+    }
+
+    // relative error of the function values, the log substituted values
+    // are rounded absolutely
+    double error = 0;
+
+    for (double y : flat_values_)
+    {
+        double rounded = static_cast<float>(y);
+
+        if (flat_row_->logSubst_)
+        {
+            error = std::max(error, std::abs(std::expm1(rounded - y)));
+        } else if (y != 0)
+        {
+            error = std::max(error, std::abs(rounded - y) / std::abs(y));
+        }
+    }
+
+    if (!(storage_error_ + error <= storage_precision_))
+    {
+        log_debug("Single precision error %g exceeds the storage precision %g, the table is kept in double precision.",
+                  storage_error_ + error,
+                  storage_precision_);
+        return;
+    }
+
+    storage_error_ += error;
+
+    flat_values_float_.assign(flat_values_.begin(), flat_values_.end());
+    flat_values_.clear();
+    flat_values_.shrink_to_fit();
+}
+
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
 double Interpolant::Interpolate(double x, int start)
 {
     int num, i, k;
     bool dd, doLog;
     double error = 0, result = 0;
-    double aux, aux2, dx1, dx2;
+    double aux, aux2;
 
     doLog = false;
 
@@ -1739,7 +2655,7 @@ double Interpolant::Interpolate(double x, int start)
         {
             for (i = 0; i < romberg_; i++)
             {
-                if (iY_.at(start + i) == bigNumber_)
+                if (Value(start + i) == bigNumber_)
                 {
                     doLog = true;
                     break;
@@ -1754,23 +2670,7 @@ double Interpolant::Interpolate(double x, int start)
 
         if (x == iX_.at(starti_))
         {
-            return iY_.at(starti_);
-        }
-
-        if (doLog)
-        {
-            for (i = 0; i < romberg_; i++)
-            {
-                c_.at(i) = Exp(iY_.at(start + i));
-                d_.at(i) = c_.at(i);
-            }
-        } else
-        {
-            for (i = 0; i < romberg_; i++)
-            {
-                c_.at(i) = iY_.at(start + i);
-                d_.at(i) = c_.at(i);
-            }
+            return Value(starti_);
         }
     } else
     {
@@ -1783,7 +2683,7 @@ double Interpolant::Interpolate(double x, int start)
 
             if (aux2 == 0)
             {
-                return iY_.at(start + i);
+                return Value(start + i);
             }
 
             if (aux2 < aux)
@@ -1791,16 +2691,6 @@ double Interpolant::Interpolate(double x, int start)
                 num = i;
                 aux = aux2;
             }
-
-            if (doLog)
-            {
-                c_.at(i) = Exp(iY_.at(start + i));
-                d_.at(i) = c_.at(i);
-            } else
-            {
-                c_.at(i) = iY_.at(start + i);
-                d_.at(i) = c_.at(i);
-            }
         }
     }
 
@@ -1837,50 +2727,104 @@ double Interpolant::Interpolate(double x, int start)
         }
     }
 
-    result = iY_.at(start + num);
+    result = (this->*neville_)(x, start, num, dd, doLog, error);
+
+    if (!fast_)
+    {
+        if (relative_)
+        {
+            if (result != 0)
+            {
+                aux = std::abs(error / result);
+            } else
+            {
+                aux = 0;
+            }
+        } else
+        {
+            aux = std::abs(error);
+        }
+
+        if (aux > precision_)
+        {
+            precision_ = aux;
+            worstX_    = x;
+        }
+    }
 
     if (doLog)
     {
-        result = Exp(result);
+        result = Log(result);
+    }
+
+    return result;
+}
+
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
+template <int N, bool Rational>
+double Interpolant::Neville(double x, int start, int num, bool dd, bool doLog, double& error)
+{
+    // with N fixed the tableau lives on the stack and the loops have constant
+    // bounds, otherwise the workspace c_, d_ is used
+    const int romberg = N > 0 ? N : romberg_;
+
+    double c_fixed[N > 0 ? N : 1], d_fixed[N > 0 ? N : 1];
+    double* c = N > 0 ? c_fixed : c_.data();
+    double* d = N > 0 ? d_fixed : d_.data();
+
+    const double* nodes = &iX_.at(start);
+
+    int i, k;
+    double aux, aux2, dx1, dx2, result;
+
+    for (i = 0; i < romberg; i++)
+    {
+        c[i] = doLog ? Exp(Value(start + i)) : Value(start + i);
+        d[i] = c[i];
     }
 
-    for (k = 1; k < romberg_; k++)
+    // num may lie outside the nodes for romberg = 1
+    result = doLog ? Exp(Value(start + num)) : Value(start + num);
+
+    for (k = 1; k < romberg; k++)
     {
-        for (i = 0; i < romberg_ - k; i++)
+        for (i = 0; i < romberg - k; i++)
         {
-            if (rational_)
+            if (Rational)
             {
-                aux  = c_.at(i + 1) - d_.at(i);
-                dx2  = iX_.at(start + i + k) - x;
-                dx1  = d_.at(i) * (iX_.at(start + i) - x) / dx2;
-                aux2 = dx1 - c_.at(i + 1);
+                aux  = c[i + 1] - d[i];
+                dx2  = nodes[i + k] - x;
+                dx1  = d[i] * (nodes[i] - x) / dx2;
+                aux2 = dx1 - c[i + 1];
 
                 if (aux2 != 0)
                 {
-                    aux      = aux / aux2;
-                    d_.at(i) = c_.at(i + 1) * aux;
-                    c_.at(i) = dx1 * aux;
+                    aux  = aux / aux2;
+                    d[i] = c[i + 1] * aux;
+                    c[i] = dx1 * aux;
                 } else
                 {
-                    c_.at(i) = 0;
-                    d_.at(i) = 0;
+                    c[i] = 0;
+                    d[i] = 0;
                 }
             } else
             {
-                dx1  = iX_.at(start + i) - x;
-                dx2  = iX_.at(start + i + k) - x;
-                aux  = c_.at(i + 1) - d_.at(i);
+                dx1  = nodes[i] - x;
+                dx2  = nodes[i + k] - x;
+                aux  = c[i + 1] - d[i];
                 aux2 = dx1 - dx2;
 
                 if (aux2 != 0)
                 {
-                    aux      = aux / aux2;
-                    c_.at(i) = dx1 * aux;
-                    d_.at(i) = dx2 * aux;
+                    aux  = aux / aux2;
+                    c[i] = dx1 * aux;
+                    d[i] = dx2 * aux;
                 } else
                 {
-                    c_.at(i) = 0;
-                    d_.at(i) = 0;
+                    c[i] = 0;
+                    d[i] = 0;
                 }
             }
         }
@@ -1890,58 +2834,59 @@ double Interpolant::Interpolate(double x, int start)
             dd = true;
         }
 
-        if (num == romberg_ - k)
+        if (num == romberg - k)
         {
             dd = false;
         }
 
         if (dd)
         {
-            error = c_.at(num);
+            error = c[num];
         } else
         {
             num--;
-            error = d_.at(num);
+            error = d[num];
         }
 
         dd = !dd;
         result += error;
     }
 
-    if (!fast_)
-    {
-        if (relative_)
-        {
-            if (result != 0)
-            {
-                aux = std::abs(error / result);
-            } else
-            {
-                aux = 0;
-            }
-        } else
-        {
-            aux = std::abs(error);
-        }
+    return result;
+}
 
-        if (aux > precision_)
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
+void Interpolant::InitNeville()
+{
+    // the orders in practical use have their own instantiation
+    auto select = [](int romberg, bool rational) -> NevilleKernel {
+        switch (romberg)
         {
-            precision_ = aux;
-            worstX_    = x;
+            case 3:
+                return rational ? &Interpolant::Neville<3, true> : &Interpolant::Neville<3, false>;
+            case 4:
+                return rational ? &Interpolant::Neville<4, true> : &Interpolant::Neville<4, false>;
+            case 5:
+                return rational ? &Interpolant::Neville<5, true> : &Interpolant::Neville<5, false>;
+            default:
+                return rational ? &Interpolant::Neville<0, true> : &Interpolant::Neville<0, false>;
         }
-    }
+    };
 
-    if (doLog)
-    {
-        result = Log(result);
-    }
+    neville_ = select(romberg_, rational_);
 
-    return result;
+    // FindLimit only switches to rationalY_ if the interpolation is not fast
+    nevilleY_ = select(rombergY_, fast_ ? rational_ : rationalY_);
 }
 
 //----------------------------------------------------------------------------//
 //----------------------------------------------------------------------------//
 
+//----------------------------------------------------------------------------//
+//----------------------------------------------------------------------------//
+
 double Interpolant::Exp(double x)
 {
     if (x <= aBigNumber_)
@@ -1949,7 +2894,7 @@ double Interpolant::Exp(double x)
         return 0;
     } else
     {
-        return std::exp(x);
+        return fastExp(x);
     }
 }
 
@@ -1963,7 +2908,7 @@ double Interpolant::Log(double x)
         return bigNumber_;
     } else
     {
-        return std::log(x);
+        return fastLog(x);
     }
 }
 
@@ -1993,11 +2938,13 @@ double Interpolant::Slog(double x)
 void Interpolant::SetRombergY(int rombergY)
 {
     rombergY_ = rombergY;
+    InitNeville();
 }
 
 void Interpolant::SetRomberg(int romberg)
 {
     romberg_ = romberg;
+    InitNeville();
 }
 
 void Interpolant::SetIX(const std::vector<double>& iX)
@@ -2048,6 +2995,7 @@ void Interpolant::SetRelative(bool relative)
 void Interpolant::SetRational(bool rational)
 {
     rational_ = rational;
+    InitNeville();
 }
 
 void Interpolant::SetRow(int row)
@@ -2063,6 +3011,7 @@ void Interpolant::SetStarti(int starti)
 void Interpolant::SetRationalY(bool rationalY)
 {
     rationalY_ = rationalY;
+    InitNeville();
 }
 
 void Interpolant::SetRelativeY(bool relativeY)
@@ -2123,6 +3072,7 @@ void Interpolant::SetPrecisionY(double precisionY)
 void Interpolant::SetFast(bool fast)
 {
     fast_ = fast;
+    InitNeville();
 }
 
 void Interpolant::SetX_save(double x_save)
@@ -2154,4 +3104,6 @@ Interpolant::~Interpolant()
     }
 
     Interpolant_.clear();
+
+    delete flat_row_;
 }
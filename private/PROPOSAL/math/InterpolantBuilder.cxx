@@ -1,9 +1,31 @@
 
+#include <algorithm>
+#include <cmath>
+
 #include "PROPOSAL/math/InterpolantBuilder.h"
 #include "PROPOSAL/math/Interpolant.h"
 
 using namespace PROPOSAL;
 
+namespace {
+
+// Number of nodes continuing the logarithmic grid of max nodes between xmin
+// and xmax up to new_upper. Zero if the grid does not end at upper.
+int ExtensionNodes(bool isLog, int max, double xmin, double xmax, double upper, double new_upper)
+{
+    if (!isLog || xmin <= 0 || std::abs(xmax - upper) > 1e-10 * upper || new_upper <= xmax)
+    {
+        return 0;
+    }
+
+    double step = std::log(xmax / xmin) / max;
+
+    // the tolerance avoids an additional node due to rounding
+    return std::max(1, static_cast<int>(std::ceil(std::log(new_upper / xmax) / step - 1e-6)));
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------- //
 // Defaults for InterpolantBuilder
 // ------------------------------------------------------------------------- //
@@ -22,6 +44,8 @@ const bool InterpolantBuilder::default_rationalY = false;
 const bool InterpolantBuilder::default_relativeY = false;
 const bool InterpolantBuilder::default_logSubst  = false;
 
+const double InterpolantBuilder::default_precision = 0;
+
 const Interpolant1DBuilder::Function1D Interpolant1DBuilder::default_function1d = NULL;
 const Interpolant2DBuilder::Function2D Interpolant2DBuilder::default_function2d = NULL;
 
@@ -43,6 +67,7 @@ Interpolant1DBuilder::Interpolant1DBuilder()
     , rationalY(default_rationalY)
     , relativeY(default_relativeY)
     , logSubst(default_logSubst)
+    , precision(default_precision)
 {
 }
 
@@ -59,15 +84,52 @@ Interpolant1DBuilder::Interpolant1DBuilder(const Interpolant1DBuilder& builder)
     , rationalY(builder.rationalY)
     , relativeY(builder.relativeY)
     , logSubst(builder.logSubst)
+    , precision(builder.precision)
 {
 }
 
 Interpolant* Interpolant1DBuilder::build()
 {
+    if (precision > 0)
+    {
+        return new Interpolant(max,
+                               xmin,
+                               xmax,
+                               function1d,
+                               romberg,
+                               rational,
+                               relative,
+                               isLog,
+                               rombergY,
+                               rationalY,
+                               relativeY,
+                               logSubst,
+                               precision);
+    }
+
     return new Interpolant(
         max, xmin, xmax, function1d, romberg, rational, relative, isLog, rombergY, rationalY, relativeY, logSubst);
 }
 
+InterpolantBuilder* Interpolant1DBuilder::CreateExtensionBuilder(double upper, double new_upper) const
+{
+    int nodes = ExtensionNodes(isLog, max, xmin, xmax, upper, new_upper);
+
+    if (nodes == 0)
+    {
+        return NULL;
+    }
+
+    Interpolant1DBuilder* builder = new Interpolant1DBuilder(*this);
+    builder->SetMax(nodes)
+        .SetXMin(xmax)
+        .SetXMax(xmax * std::pow(xmax / xmin, static_cast<double>(nodes) / max))
+        .SetRomberg(std::min(romberg, nodes))
+        .SetRombergY(std::min(rombergY, nodes));
+
+    return builder;
+}
+
 // ------------------------------------------------------------------------- //
 // Interpolant2D Builder
 // ------------------------------------------------------------------------- //
@@ -93,6 +155,7 @@ Interpolant2DBuilder::Interpolant2DBuilder()
     , rationalY(default_rationalY)
     , relativeY(default_relativeY)
     , logSubst(default_logSubst)
+    , precision(default_precision)
 {
 }
 
@@ -116,6 +179,7 @@ Interpolant2DBuilder::Interpolant2DBuilder(const Interpolant2DBuilder& builder)
     , rationalY(builder.rationalY)
     , relativeY(builder.relativeY)
     , logSubst(builder.logSubst)
+    , precision(builder.precision)
 {
 }
 
@@ -145,6 +209,30 @@ Interpolant2DBuilder_array_as::Interpolant2DBuilder_array_as(const Interpolant2D
 
 Interpolant* Interpolant2DBuilder::build()
 {
+    if (precision > 0)
+    {
+        return new Interpolant(max1,
+                               x1min,
+                               x1max,
+                               max2,
+                               x2min,
+                               x2max,
+                               function2d,
+                               romberg1,
+                               rational1,
+                               relative1,
+                               isLog1,
+                               romberg2,
+                               rational2,
+                               relative2,
+                               isLog2,
+                               rombergY,
+                               rationalY,
+                               relativeY,
+                               logSubst,
+                               precision);
+    }
+
     return new Interpolant(max1,
                            x1min,
                            x1max,
@@ -166,6 +254,27 @@ Interpolant* Interpolant2DBuilder::build()
                            logSubst);
 }
 
+InterpolantBuilder* Interpolant2DBuilder::CreateExtensionBuilder(double upper, double new_upper) const
+{
+    // the rows of the 2d interpolants are extended along x1, the rows of
+    // adaptive tables would differ for the range of the extension
+    int nodes = ExtensionNodes(isLog1, max1, x1min, x1max, upper, new_upper);
+
+    if (nodes == 0 || precision > 0)
+    {
+        return NULL;
+    }
+
+    Interpolant2DBuilder* builder = new Interpolant2DBuilder(*this);
+    builder->SetMax1(nodes)
+        .SetX1Min(x1max)
+        .SetX1Max(x1max * std::pow(x1max / x1min, static_cast<double>(nodes) / max1))
+        .SetRomberg1(std::min(romberg1, nodes))
+        .SetRombergY(std::min(rombergY, nodes));
+
+    return builder;
+}
+
 Interpolant* Interpolant2DBuilder_array_as::build()
 {
     return new Interpolant(x1,
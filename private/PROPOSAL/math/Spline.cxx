@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <iterator>
@@ -13,7 +15,8 @@
 
 using namespace PROPOSAL;
 
-Spline::Spline(std::vector<double> x, std::vector<double> y) : x_(x), y_(y) {
+Spline::Spline(std::vector<double> x, std::vector<double> y)
+    : x_(x), y_(y), grid_index_(), grid_min_(0), grid_inverse_width_(0) {
     if (x.size() != y.size())
         log_error(
             "CalculateSpline: x and y (abscissa and ordinate) must have same "
@@ -23,14 +26,23 @@ Spline::Spline(std::vector<double> x, std::vector<double> y) : x_(x), y_(y) {
 Spline::Spline(std::vector<Polynom> splines, std::vector<double> subintervall)
     : splines_(splines),
       subintervall_(subintervall),
-      n_subintervalls_(subintervall_.size()) {}
+      n_subintervalls_(subintervall_.size()),
+      grid_index_(),
+      grid_min_(0),
+      grid_inverse_width_(0) {
+    BuildIndex();
+}
 
 Spline::Spline(const Spline& spline)
     : splines_(spline.splines_),
       subintervall_(spline.subintervall_),
-      n_subintervalls_(spline.n_subintervalls_) {}
+      n_subintervalls_(spline.n_subintervalls_),
+      grid_index_(spline.grid_index_),
+      grid_min_(spline.grid_min_),
+      grid_inverse_width_(spline.grid_inverse_width_) {}
 
-Spline::Spline(std::string path, bool binary) {
+Spline::Spline(std::string path, bool binary)
+    : grid_index_(), grid_min_(0), grid_inverse_width_(0) {
     Table_read reader(path, binary);
     reader.jump(2);
 
@@ -51,21 +63,70 @@ bool Spline::operator!=(const Spline& spline) const {
     return !(*this == spline);
 }
 
-double Spline::evaluate(double x) {
-    for (unsigned int i = 0; i < n_subintervalls_; ++i) {
-        if (subintervall_[i] <= x && x <= subintervall_[i + 1])
-            return splines_[i].evaluate(x);
+void Spline::BuildIndex() {
+    grid_index_.clear();
+
+    size_t n = std::min(splines_.size(), subintervall_.size() - 1);
+    if (subintervall_.empty() || n < 2)
+        return;
+
+    double width = (subintervall_[n] - subintervall_[0]) / n;
+    if (!(width > 0))
+        return;
+
+    grid_min_ = subintervall_[0];
+    grid_inverse_width_ = 1. / width;
+
+    // first subintervall reaching into each cell, one more entry closes the
+    // last cell
+    grid_index_.resize(n + 1);
+    unsigned int i = 0;
+    for (size_t cell = 0; cell <= n; ++cell) {
+        double lower = grid_min_ + cell * width;
+        while (i < n - 1 && subintervall_[i + 1] < lower)
+            ++i;
+        grid_index_[cell] = i;
+    }
+}
+
+unsigned int Spline::FindSubintervall(double x) const {
+    // the first subintervall whose upper node is not below x, like the
+    // linear scan this picks the left subintervall on a node
+    unsigned int n = std::min(splines_.size(), subintervall_.size() - 1);
+    unsigned int first = 0;
+    unsigned int last = n - 1;
+
+    if (!grid_index_.empty()) {
+        double position = (x - grid_min_) * grid_inverse_width_;
+        if (position <= 0)
+            return 0;
+
+        // one cell of slack for the rounding of position
+        unsigned int cell = position < n ? static_cast<unsigned int>(position) : n - 1;
+        first = grid_index_[cell] > 0 ? grid_index_[cell] - 1 : 0;
+        last = std::min(grid_index_[cell + 1] + 1, n - 1);
     }
 
-    // logger warining
-    if (x > subintervall_.back())
-        return splines_[n_subintervalls_ - 1].evaluate(x);
-    else
-        return splines_[0].evaluate(x);
+    auto lower = std::lower_bound(subintervall_.begin() + first + 1,
+                                  subintervall_.begin() + last + 1, x);
+    return lower - subintervall_.begin() - 1;
+}
+
+double Spline::evaluate(double x) {
+    return splines_[FindSubintervall(x)].evaluate(x);
+}
+
+void Spline::BatchEvaluate(const double* x, double* result, size_t n) {
+    unsigned int i = 0;
+    for (size_t k = 0; k < n; ++k) {
+        if (!(subintervall_[i] < x[k] && x[k] <= subintervall_[i + 1]))
+            i = FindSubintervall(x[k]);
+        result[k] = splines_[i].evaluate(x[k]);
+    }
 }
 
 void Spline::Derivative() {
-    for (auto spline : splines_)
+    for (auto& spline : splines_)
         spline = spline.GetDerivative();
 }
 
@@ -133,6 +194,7 @@ std::istream& operator>>(std::istream& is, Spline& s) {
         container.coeff.clear();
     }
     s.subintervall_.push_back(container.domain.second);
+    s.BuildIndex();
     return is;
 }
 
@@ -191,6 +253,7 @@ void Linear_Spline::calculate_splines(std::vector<double> x,
 
     n_subintervalls_ = n;
     subintervall_ = x;
+    BuildIndex();
 }
 
 //----------------------------------------------------------------------------//
@@ -271,4 +334,5 @@ void Cubic_Spline::calculate_splines(std::vector<double> x,
     }
     subintervall_.push_back(x.back());
     n_subintervalls_ = n;
+    BuildIndex();
 }
@@ -1,5 +1,9 @@
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include "PROPOSAL/Constants.h"
 #include "PROPOSAL/Logging.h"
 #include "PROPOSAL/medium/density_distr/density_distr.h"
 
@@ -67,7 +71,7 @@ double RadialAxis::GetEffectiveDistance(const Vector3D& xi, const Vector3D& dire
     Vector3D aux{xi - fp0_};
     aux.normalise();
 
-    return -aux * direction;
+    return aux * direction;
 }
 
 // %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -91,3 +95,76 @@ double CartesianAxis::GetEffectiveDistance(const Vector3D& xi,
 
     return fAxis_ * direction;
 }
+
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+// %%%%%%%%%%%%%%%%%%%     DepthIntegral      %%%%%%%%%%%%%%%%
+// %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+DepthIntegral::DepthIntegral() : depths_(), integrals_() {}
+
+DepthIntegral::DepthIntegral(const std::vector<double>& depths,
+                             const std::function<double(double)>& antiderivative)
+    : depths_(depths), integrals_(depths.size()) {
+    for (unsigned int i = 0; i < depths_.size(); ++i)
+        integrals_[i] = antiderivative(depths_[i]);
+
+    // the inversion needs a non-negative density, otherwise the root
+    // finding of the density distribution is used
+    if (depths_.size() < 2 || !std::is_sorted(integrals_.begin(), integrals_.end())) {
+        depths_.clear();
+        integrals_.clear();
+    }
+}
+
+bool DepthIntegral::operator==(const DepthIntegral& depth_integral) const {
+    return depths_ == depth_integral.depths_ && integrals_ == depth_integral.integrals_;
+}
+
+bool DepthIntegral::operator!=(const DepthIntegral& depth_integral) const {
+    return !(*this == depth_integral);
+}
+
+double DepthIntegral::Invert(double integral,
+                             const std::function<double(double)>& density,
+                             const std::function<double(double)>& antiderivative) const {
+    if (depths_.empty() || !(integral >= integrals_.front() && integral <= integrals_.back()))
+        return std::numeric_limits<double>::quiet_NaN();
+
+    auto upper = std::upper_bound(integrals_.begin(), integrals_.end() - 1, integral);
+    unsigned int i = std::max<long>(upper - integrals_.begin(), 1) - 1;
+
+    double low = depths_[i];
+    double high = depths_[i + 1];
+    double range = integrals_[i + 1] - integrals_[i];
+
+    if (range <= 0)
+        return low;
+
+    double depth = low + (integral - integrals_[i]) / range * (high - low);
+    double accuracy = 4 * std::numeric_limits<double>::epsilon() * std::max(std::abs(low), std::abs(high));
+
+    for (int step = 0; step < 20; ++step) {
+        double f = antiderivative(depth) - integral;
+
+        if (f < 0)
+            low = depth;
+        else if (f > 0)
+            high = depth;
+        else
+            return depth;
+
+        double rho = density(depth);
+        double next = depth - f / rho;
+
+        // bisection if the Newton step leaves the bracket
+        if (!(rho > 0) || !(next > low && next < high))
+            next = 0.5 * (low + high);
+
+        if (std::abs(next - depth) <= accuracy || high - low <= accuracy)
+            return next;
+
+        depth = next;
+    }
+
+    return depth;
+}
@@ -3,6 +3,8 @@
 #include <cmath>
 #include <functional>
 #include <iostream>
+#include <limits>
+#include "PROPOSAL/Constants.h"
 #include "PROPOSAL/math/MathMethods.h"
 #include "PROPOSAL/medium/density_distr/density_polynomial.h"
 
@@ -16,14 +18,31 @@ Density_polynomial::Density_polynomial(const Axis& axis, const Polynom& polynom)
       polynom_(polynom),
       Polynom_(polynom_.GetAntiderivative(0)),
       density_distribution(polynom_.GetFunction()),
-      antiderived_density_distribution(Polynom_.GetFunction()) {}
+      antiderived_density_distribution(Polynom_.GetFunction()),
+      depth_integral_() {}
+
+Density_polynomial::Density_polynomial(const Axis& axis,
+                                       const Polynom& polynom,
+                                       double depth_min,
+                                       double depth_max)
+    : Density_polynomial(axis, polynom) {
+    if (!(depth_min < depth_max))
+        throw DensityException("Depth range of the density table is empty.");
+
+    std::vector<double> depths(101);
+    for (unsigned int i = 0; i < depths.size(); ++i)
+        depths[i] = depth_min + (depth_max - depth_min) * i / (depths.size() - 1);
+
+    depth_integral_ = DepthIntegral(depths, antiderived_density_distribution);
+}
 
 Density_polynomial::Density_polynomial(const Density_polynomial& dens)
     : Density_distr(dens),
       polynom_(dens.polynom_),
       Polynom_(dens.Polynom_),
       density_distribution(polynom_.GetFunction()),
-      antiderived_density_distribution(Polynom_.GetFunction()) {}
+      antiderived_density_distribution(Polynom_.GetFunction()),
+      depth_integral_(dens.depth_integral_) {}
 
 Density_polynomial::~Density_polynomial() {}
 
@@ -33,6 +52,8 @@ bool Density_polynomial::compare(const Density_distr& dens_distr) const {
         return false;
     if( polynom_ != dens_poly->polynom_ )
         return false;
+    if( depth_integral_ != dens_poly->depth_integral_ )
+        return false;
     return true;
 }
 
@@ -49,13 +70,38 @@ double Density_polynomial::helper_function(const Vector3D& xi,
                                            double l) const {
     (void)res;
 
-    return Evaluate(xi) - Evaluate(xi + l * direction);
+    return -Evaluate(xi + l * direction);
 }
 
 double Density_polynomial::Correct(const Vector3D& xi,
                                    const Vector3D& direction,
                                    double res,
                                    double distance_to_border) const {
+    double delta = axis_->GetEffectiveDistance(xi, direction);
+    double depth = axis_->GetDepth(xi);
+
+    // the density hardly changes if the track runs almost perpendicular to
+    // the axis
+    double rho = density_distribution(depth);
+    if (delta == 0 && !(rho > 0))
+        throw DensityException("Next interaction point lies in infinite.");
+
+    double distance = std::numeric_limits<double>::quiet_NaN();
+    if (rho > 0 && std::abs(res / rho * delta) < PARTICLE_POSITION_RESOLUTION) {
+        distance = res / density_distribution(depth + 0.5 * res / rho * delta);
+    } else {
+        double final_depth = depth_integral_.Invert(
+            antiderived_density_distribution(depth) + res * delta,
+            density_distribution, antiderived_density_distribution);
+        distance = (final_depth - depth) / delta;
+    }
+
+    // like the root finding below, only distances up to the border are valid
+    if (distance > distance_to_border)
+        throw DensityException("Next interaction point lies behind the border.");
+    if (!std::isnan(distance))
+        return distance;
+
     std::function<double(double)> F =
         std::bind(&Density_polynomial::Helper_function, this, xi, direction,
                   res, std::placeholders::_1);
@@ -83,12 +129,16 @@ double Density_polynomial::Integrate(const Vector3D& xi,
     double delta = axis_->GetEffectiveDistance(xi, direction);
 
     return antiderived_density_distribution(axis_->GetDepth(xi) + l * delta) /
-           (delta * delta);
+           delta;
 }
 
 double Density_polynomial::Calculate(const Vector3D& xi,
                                      const Vector3D& direction,
                                      double distance) const {
+    double delta = axis_->GetEffectiveDistance(xi, direction);
+    if (std::abs(distance * delta) < PARTICLE_POSITION_RESOLUTION)
+        return distance * density_distribution(axis_->GetDepth(xi) + 0.5 * distance * delta);
+
     return Integrate(xi, direction, distance) - Integrate(xi, direction, 0);
 }
 
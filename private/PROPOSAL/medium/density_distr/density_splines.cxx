@@ -1,7 +1,10 @@
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
 #include <iostream>
+#include <limits>
+#include "PROPOSAL/Constants.h"
 #include "PROPOSAL/medium/density_distr/density_splines.h"
 
 using namespace PROPOSAL;
@@ -11,12 +14,26 @@ Density_splines::Density_splines(const Axis& axis, const Spline& splines)
       spline_(splines.clone()),
       integrated_spline_(splines.clone()) {
     integrated_spline_->Antiderivative(0);
+
+    Spline* spline = spline_;
+    Spline* integrated_spline = integrated_spline_;
+    density_distribution = [spline](double x) { return spline->evaluate(x); };
+    antiderived_density_distribution = [integrated_spline](double x) {
+        return integrated_spline->evaluate(x);
+    };
+
+    // the antiderivative is a polynomial between the nodes of the spline
+    depth_integral_ = DepthIntegral(spline_->GetSubintervalls(),
+                                    antiderived_density_distribution);
 }
 
 Density_splines::Density_splines(const Density_splines& dens_splines)
     : Density_distr(dens_splines),
       spline_(dens_splines.spline_),
-      integrated_spline_(dens_splines.integrated_spline_) {}
+      integrated_spline_(dens_splines.integrated_spline_),
+      density_distribution(dens_splines.density_distribution),
+      antiderived_density_distribution(dens_splines.antiderived_density_distribution),
+      depth_integral_(dens_splines.depth_integral_) {}
 
 bool Density_splines::compare(const Density_distr& dens_distr) const {
     const Density_splines* dens_splines= dynamic_cast<const Density_splines*>(&dens_distr);
@@ -41,13 +58,38 @@ double Density_splines::helper_function(const Vector3D& xi,
                                         double res,
                                         double l) const {
     (void)res;
-    return Evaluate(xi) - Evaluate(xi + l * direction);
+    return -Evaluate(xi + l * direction);
 }
 
 double Density_splines::Correct(const Vector3D& xi,
                                 const Vector3D& direction,
                                 double res,
                                 double distance_to_border) const {
+    double delta = axis_->GetEffectiveDistance(xi, direction);
+    double depth = axis_->GetDepth(xi);
+
+    // the density hardly changes if the track runs almost perpendicular to
+    // the axis
+    double rho = density_distribution(depth);
+    if (delta == 0 && !(rho > 0))
+        throw DensityException("Next interaction point lies in infinite.");
+
+    double distance = std::numeric_limits<double>::quiet_NaN();
+    if (rho > 0 && std::abs(res / rho * delta) < PARTICLE_POSITION_RESOLUTION) {
+        distance = res / density_distribution(depth + 0.5 * res / rho * delta);
+    } else {
+        double final_depth = depth_integral_.Invert(
+            antiderived_density_distribution(depth) + res * delta,
+            density_distribution, antiderived_density_distribution);
+        distance = (final_depth - depth) / delta;
+    }
+
+    // like the root finding below, only distances up to the border are valid
+    if (distance > distance_to_border)
+        throw DensityException("Next interaction point lies behind the border.");
+    if (!std::isnan(distance))
+        return distance;
+
     std::function<double(double)> F =
         std::bind(&Density_splines::Helper_function, this, xi, direction, res,
                   std::placeholders::_1);
@@ -71,13 +113,16 @@ double Density_splines::Integrate(const Vector3D& xi,
                                   double l) const {
     double delta = axis_->GetEffectiveDistance(xi, direction);
 
-    return 1 / (delta * delta) *
-           integrated_spline_->evaluate(axis_->GetDepth(xi) + l * delta);
+    return integrated_spline_->evaluate(axis_->GetDepth(xi) + l * delta) / delta;
 }
 
 double Density_splines::Calculate(const Vector3D& xi,
                                   const Vector3D& direction,
                                   double distance) const {
+    double delta = axis_->GetEffectiveDistance(xi, direction);
+    if (std::abs(distance * delta) < PARTICLE_POSITION_RESOLUTION)
+        return distance * density_distribution(axis_->GetDepth(xi) + 0.5 * distance * delta);
+
     return Integrate(xi, direction, distance) - Integrate(xi, direction, 0);
 }
 
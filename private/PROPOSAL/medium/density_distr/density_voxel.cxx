@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "PROPOSAL/medium/density_distr/density_voxel.h"
+
+using namespace PROPOSAL;
+
+Density_voxel::Density_voxel(const Vector3D& origin,
+                             const Vector3D& voxel_size,
+                             const std::array<unsigned int, 3>& voxel_number,
+                             const std::vector<double>& densities,
+                             double outside)
+    : Density_distr(),
+      origin_(origin),
+      voxel_size_{{voxel_size.GetX(), voxel_size.GetY(), voxel_size.GetZ()}},
+      voxel_number_(voxel_number),
+      densities_(densities),
+      outside_(outside) {
+    for (int i = 0; i < 3; ++i) {
+        if (voxel_size_[i] <= 0)
+            throw DensityException("Voxel size must be positive.");
+        if (voxel_number_[i] == 0)
+            throw DensityException("Voxel grid must not be empty.");
+    }
+
+    if (densities_.size() !=
+        static_cast<size_t>(voxel_number_[0]) * voxel_number_[1] * voxel_number_[2])
+        throw DensityException("Number of densities does not match the voxel grid.");
+
+    if (outside_ < 0 ||
+        std::any_of(densities_.begin(), densities_.end(), [](double density) { return !(density >= 0); }))
+        throw DensityException("Voxel densities must not be negative.");
+}
+
+Density_voxel::Density_voxel(const Density_voxel& dens_distr)
+    : Density_distr(dens_distr),
+      origin_(dens_distr.origin_),
+      voxel_size_(dens_distr.voxel_size_),
+      voxel_number_(dens_distr.voxel_number_),
+      densities_(dens_distr.densities_),
+      outside_(dens_distr.outside_) {}
+
+bool Density_voxel::compare(const Density_distr& dens_distr) const {
+    const Density_voxel* dens_voxel = dynamic_cast<const Density_voxel*>(&dens_distr);
+    if(!dens_voxel)
+        return false;
+    if(origin_ != dens_voxel->origin_)
+        return false;
+    if(voxel_size_ != dens_voxel->voxel_size_ || voxel_number_ != dens_voxel->voxel_number_)
+        return false;
+    if(densities_ != dens_voxel->densities_ || outside_ != dens_voxel->outside_)
+        return false;
+    return true;
+}
+
+double Density_voxel::Traverse(const Vector3D& xi,
+                               const Vector3D& direction,
+                               double max_distance,
+                               double max_grammage,
+                               double& distance) const {
+    const double inf = std::numeric_limits<double>::infinity();
+    const double p[3] = {xi.GetX() - origin_.GetX(), xi.GetY() - origin_.GetY(), xi.GetZ() - origin_.GetZ()};
+    const double u[3] = {direction.GetX(), direction.GetY(), direction.GetZ()};
+
+    double grammage = 0;
+    distance = 0;
+
+    // advances through a region of constant density, returns true as soon as
+    // one of the limits is reached
+    auto advance = [&](double length, double density) {
+        length = std::min(length, max_distance - distance);
+        if (density * length >= max_grammage - grammage) {
+            if (density > 0)
+                distance += (max_grammage - grammage) / density;
+            grammage = max_grammage;
+            return true;
+        }
+        grammage += density * length;
+        distance += length;
+        return distance >= max_distance;
+    };
+
+    // part of the trajectory inside the grid
+    double t_enter = 0;
+    double t_exit = inf;
+    for (int i = 0; i < 3; ++i) {
+        double extent = voxel_number_[i] * voxel_size_[i];
+        if (u[i] != 0) {
+            double t_0 = -p[i] / u[i];
+            double t_1 = (extent - p[i]) / u[i];
+            t_enter = std::max(t_enter, std::min(t_0, t_1));
+            t_exit = std::min(t_exit, std::max(t_0, t_1));
+        } else if (p[i] < 0 || p[i] >= extent) {
+            t_exit = -inf;
+        }
+    }
+
+    if (t_enter < t_exit) {
+        if (t_enter > 0 && advance(t_enter, outside_))
+            return grammage;
+
+        unsigned int index[3];
+        int step[3];
+        double t_max[3];
+        for (int i = 0; i < 3; ++i) {
+            double position = std::floor((p[i] + t_enter * u[i]) / voxel_size_[i]);
+            index[i] = static_cast<unsigned int>(
+                std::min(std::max(position, 0.), voxel_number_[i] - 1.));
+            step[i] = u[i] > 0 ? 1 : -1;
+            if (u[i] != 0)
+                t_max[i] = ((index[i] + (step[i] > 0)) * voxel_size_[i] - p[i]) / u[i];
+            else
+                t_max[i] = inf;
+        }
+
+        double t = t_enter;
+        while (true) {
+            int axis = t_max[0] < t_max[1] ? (t_max[0] < t_max[2] ? 0 : 2)
+                                           : (t_max[1] < t_max[2] ? 1 : 2);
+            double t_next = std::min(t_max[axis], t_exit);
+            double density =
+                densities_[index[0] + voxel_number_[0] * (index[1] + voxel_number_[1] * index[2])];
+
+            if (advance(t_next - t, density))
+                return grammage;
+
+            t = t_next;
+            if (t >= t_exit)
+                break;
+
+            // the unsigned index wraps around when stepping below zero
+            index[axis] += step[axis];
+            if (index[axis] >= voxel_number_[axis])
+                break;
+            t_max[axis] = ((index[axis] + (step[axis] > 0)) * voxel_size_[axis] - p[axis]) / u[axis];
+        }
+    }
+
+    // the rest of the trajectory leaves the grid
+    if (outside_ <= 0 && max_distance == inf) {
+        if (grammage < max_grammage)
+            throw DensityException("Next interaction point lies in infinite.");
+        return grammage;
+    }
+
+    advance(max_distance - distance, outside_);
+    return grammage;
+}
+
+double Density_voxel::Correct(const Vector3D& xi,
+                              const Vector3D& direction,
+                              double res,
+                              double distance_to_border) const {
+    (void)distance_to_border;
+
+    double distance;
+    if (res < 0) {
+        Traverse(xi, -direction, std::numeric_limits<double>::infinity(), -res, distance);
+        return -distance;
+    }
+
+    Traverse(xi, direction, std::numeric_limits<double>::infinity(), res, distance);
+    return distance;
+}
+
+double Density_voxel::Integrate(const Vector3D& xi,
+                                const Vector3D& direction,
+                                double l) const {
+    double distance;
+    if (l < 0)
+        return -Traverse(xi, -direction, -l, std::numeric_limits<double>::infinity(), distance);
+
+    return Traverse(xi, direction, l, std::numeric_limits<double>::infinity(), distance);
+}
+
+double Density_voxel::Calculate(const Vector3D& xi,
+                                const Vector3D& direction,
+                                double distance) const {
+    return Integrate(xi, direction, distance) - Integrate(xi, direction, 0);
+}
+
+double Density_voxel::Evaluate(const Vector3D& xi) const {
+    const double p[3] = {xi.GetX() - origin_.GetX(), xi.GetY() - origin_.GetY(), xi.GetZ() - origin_.GetZ()};
+
+    unsigned int index[3];
+    for (int i = 0; i < 3; ++i) {
+        double position = std::floor(p[i] / voxel_size_[i]);
+        if (!(position >= 0 && position < voxel_number_[i]))
+            return outside_;
+        index[i] = static_cast<unsigned int>(position);
+    }
+
+    return densities_[index[0] + voxel_number_[0] * (index[1] + voxel_number_[1] * index[2])];
+}
@@ -12,9 +12,12 @@
 #include <climits> // for PATH_MAX
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <sys/stat.h>
 #include <unistd.h>  // check for write permissions
 #include <wordexp.h> // Used to expand path with environment variables
@@ -35,10 +38,15 @@ InterpolationDef::InterpolationDef(const nlohmann::json& config)
     nodes_continous_randomization
         = config.value("nodes_continous_randomization", 200);
     nodes_cross_section = config.value("nodes_cross_section", 100);
+    interpolation_precision = config.value("interpolation_precision", 0.);
+    storage_precision = config.value("storage_precision", 0.);
     max_node_energy = config.value("max_node_energy", 1e14);
+    extended_max_node_energy = config.value("extended_max_node_energy", 0.);
     do_binary_tables = config.value("do_binary_tables", true);
     just_use_readonly_path = config.value("just_use_readonly_path", false);
     order_of_interpolation = config.value("order_of_interpolation", 5);
+    do_async_build = config.value("do_async_build", false);
+    do_cut_independent_dndx = config.value("do_cut_independent_dndx", false);
 
     if (!(nodes_propagate > 3))
         throw std::invalid_argument(
@@ -52,6 +60,16 @@ InterpolationDef::InterpolationDef(const nlohmann::json& config)
     if (!(max_node_energy > 0))
         throw std::invalid_argument("max_node_energy must be larger than "
                                     "highest primary particle energy.");
+    if (extended_max_node_energy != 0
+        && !(extended_max_node_energy > max_node_energy))
+        throw std::invalid_argument("extended_max_node_energy must be larger "
+                                    "than max_node_energy.");
+    if (interpolation_precision < 0)
+        throw std::invalid_argument(
+            "interpolation_precision must not be negative.");
+    if (storage_precision < 0)
+        throw std::invalid_argument(
+            "storage_precision must not be negative.");
     if (!(order_of_interpolation > 1))
         throw std::invalid_argument(
             "Order of interpolation must be larger than one.");
@@ -109,6 +127,10 @@ size_t InterpolationDef::GetHash() const
     hash_combine(seed, order_of_interpolation, max_node_energy,
         nodes_cross_section, nodes_continous_randomization, nodes_propagate);
 
+    // equidistant tables keep their names
+    if (interpolation_precision > 0)
+        hash_combine(seed, interpolation_precision);
+
     return seed;
 }
 
@@ -235,6 +257,23 @@ namespace Helper {
         }
     }
 
+    // -------------------------------------------------------------------------
+    // //
+    std::mutex& TableMutex(const std::string& table)
+    {
+        // Sectors building their tables in the background must not read a
+        // table file while another thread is still writing it.
+        static std::mutex map_mutex;
+        static std::unordered_map<std::string, std::unique_ptr<std::mutex>> table_mutexes;
+
+        std::lock_guard<std::mutex> lock(map_mutex);
+        auto& table_mutex = table_mutexes[table];
+        if (!table_mutex) {
+            table_mutex.reset(new std::mutex());
+        }
+        return *table_mutex;
+    }
+
     // -------------------------------------------------------------------------
     // //
     void InitializeInterpolation(const std::string name,
@@ -242,8 +281,6 @@ namespace Helper {
         const std::vector<Parametrization*>& parametrizations,
         const InterpolationDef interpolation_def)
     {
-        log_debug("Initialize %s interpolation.", name.c_str());
-
         // ---------------------------------------------------------------------
         // // Create hash for the file name
         // ---------------------------------------------------------------------
@@ -264,7 +301,50 @@ namespace Helper {
                     parametrizations[0]->GetParticleDef().lifetime);
             }
         }
-        hash_combine(hash_digest, interpolation_def.GetHash());
+
+        InitializeInterpolation(
+            name, builder_container, hash_digest, interpolation_def);
+    }
+
+namespace {
+
+    // -------------------------------------------------------------------------
+    // //
+    // Builds the extension of a table and appends it right away, since the
+    // following builders might already need the extended interpolants.
+    class ExtensionBuilder : public InterpolantBuilder {
+    public:
+        ExtensionBuilder(InterpolantBuilder* builder, Interpolant** interpolant)
+            : builder_(builder)
+            , interpolant_(interpolant)
+            , appended_(false)
+        {
+        }
+
+        Interpolant* build()
+        {
+            Interpolant* extension = builder_->build();
+            (*interpolant_)->Append(*extension);
+            appended_ = true;
+
+            return extension;
+        }
+
+        std::unique_ptr<InterpolantBuilder> builder_;
+        Interpolant** interpolant_;
+        bool appended_;
+    };
+
+    // -------------------------------------------------------------------------
+    // //
+    void InitializeTables(const std::string& name,
+        InterpolantBuilderContainer& builder_container, size_t hash_digest,
+        const InterpolationDef& interpolation_def)
+    {
+        log_debug("Initialize %s interpolation.", name.c_str());
+
+        std::lock_guard<std::mutex> table_lock(
+            TableMutex(name + "_" + std::to_string(hash_digest)));
 
         bool storing_failed = false;
         bool reading_worked = false;
@@ -433,6 +513,81 @@ namespace Helper {
         log_debug("Initialize %s interpolation done.", name.c_str());
     }
 
+    // -------------------------------------------------------------------------
+    // //
+    void ExtendTables(const std::string& name,
+        InterpolantBuilderContainer& builder_container, size_t hash_digest,
+        const InterpolationDef& interpolation_def)
+    {
+        std::vector<std::unique_ptr<ExtensionBuilder>> builders;
+
+        for (auto& builder : builder_container) {
+            InterpolantBuilder* extension_builder
+                = builder.first->CreateExtensionBuilder(
+                    interpolation_def.max_node_energy,
+                    interpolation_def.extended_max_node_energy);
+
+            if (extension_builder != NULL) {
+                builders.emplace_back(
+                    new ExtensionBuilder(extension_builder, builder.second));
+            }
+        }
+
+        if (builders.empty()) {
+            return;
+        }
+
+        std::vector<Interpolant*> extensions(builders.size(), NULL);
+        InterpolantBuilderContainer extension_container;
+
+        for (unsigned int i = 0; i < builders.size(); ++i) {
+            extension_container.push_back(
+                std::make_pair(builders[i].get(), &extensions[i]));
+        }
+
+        // the extension is keyed by the tables it extends
+        hash_combine(hash_digest, interpolation_def.extended_max_node_energy);
+
+        InitializeTables(name + "_extension", extension_container, hash_digest,
+            interpolation_def);
+
+        // loaded extensions still have to be appended
+        for (unsigned int i = 0; i < builders.size(); ++i) {
+            if (!builders[i]->appended_) {
+                (*builders[i]->interpolant_)->Append(*extensions[i]);
+            }
+            delete extensions[i];
+        }
+    }
+
+} // namespace
+
+    // -------------------------------------------------------------------------
+    // //
+    void InitializeInterpolation(const std::string name,
+        InterpolantBuilderContainer& builder_container,
+        size_t hash_digest,
+        const InterpolationDef interpolation_def)
+    {
+        hash_combine(hash_digest, interpolation_def.GetHash());
+
+        InitializeTables(
+            name, builder_container, hash_digest, interpolation_def);
+
+        if (interpolation_def.extended_max_node_energy
+            > interpolation_def.max_node_energy) {
+            ExtendTables(
+                name, builder_container, hash_digest, interpolation_def);
+        }
+
+        // the tables are stored as built, so they are compacted only in memory
+        if (interpolation_def.storage_precision > 0) {
+            for (auto& builder : builder_container) {
+                (*builder.second)->Compact(interpolation_def.storage_precision);
+            }
+        }
+    }
+
 } // namespace Helper
 
 } // namespace PROPOSAL
@@ -6,6 +6,7 @@
 #include "PROPOSAL/propagation_utility/PropagationUtility.h"
 
 #include "PROPOSAL/crossection/CrossSection.h"
+#include "PROPOSAL/crossection/CrossSectionIntegral.h"
 #include "PROPOSAL/crossection/parametrization/Parametrization.h"
 
 using namespace PROPOSAL;
@@ -27,6 +28,8 @@ std::ostream& operator<<(std::ostream& os, Utility::Definition const& util_defin
     os << "Photonuclear Definition:\n" << util_definition.photo_def << std::endl;
     os << "PhotoPair Production Definition:\n" << util_definition.photopair_def << std::endl;
     os << "Weak Interaction Definition:\n" << util_definition.weak_def << std::endl;
+    os << "Integral cache size: " << util_definition.integral_cache_size << '\n';
+    os << "Integral cache tolerance: " << util_definition.integral_cache_tolerance << std::endl;
 
     os << Helper::Centered(60, "");
     return os;
@@ -49,6 +52,8 @@ Utility::Definition::Definition()
     , weak_def()
     , photopair_def()
     , annihilation_def()
+    , integral_cache_size(0)
+    , integral_cache_tolerance(0)
 {
 }
 
@@ -64,21 +69,26 @@ Utility::Definition::Definition(const nlohmann::json& config)
     , weak_def()
     , photopair_def()
     , annihilation_def()
+    , integral_cache_size(0)
+    , integral_cache_tolerance(0)
 {
     assert(config.is_object());
 
     std::string brems_str = config.value("brems", "none");
     brems_def.parametrization = BremsstrahlungFactory::Get().GetEnumFromString(brems_str);
     brems_def.multiplier = config.value("brems_multiplier", 1.0);
+    brems_def.quadrature = Integral::GetQuadratureFromString(config.value("brems_quadrature", "romberg"));
     brems_def.lpm_effect = config.value("lpm", true);
 
     std::string compton_str = config.value("compton", "none");
     compton_def.parametrization = ComptonFactory::Get().GetEnumFromString(compton_str);
     compton_def.multiplier = config.value("compton_multiplier", 1.0);
+    compton_def.quadrature = Integral::GetQuadratureFromString(config.value("compton_quadrature", "romberg"));
 
     std::string photo_str = config.value("photo", "none");
     photo_def.parametrization = PhotonuclearFactory::Get().GetEnumFromString(photo_str);
     photo_def.multiplier = config.value("photo_multiplier", 1.0);
+    photo_def.quadrature = Integral::GetQuadratureFromString(config.value("photo_quadrature", "romberg"));
     std::string photo_shadow = config.value("photo_shadow", "shadow_none");
     photo_def.shadow = PhotonuclearFactory::Get().GetShadowEnumFromString(photo_shadow);
     photo_def.hard_component = config.value("photo_hard_component", true);
@@ -86,30 +96,46 @@ Utility::Definition::Definition(const nlohmann::json& config)
     std::string epair_str = config.value("epair", "none");
     epair_def.parametrization = EpairProductionFactory::Get().GetEnumFromString(epair_str);
     epair_def.multiplier = config.value("epair_multiplier", 1.0);
+    epair_def.quadrature = Integral::GetQuadratureFromString(config.value("epair_quadrature", "romberg"));
     epair_def.lpm_effect = config.value("lpm", true);
 
     std::string ioniz_str = config.value("ioniz", "none");
     ioniz_def.parametrization = IonizationFactory::Get().GetEnumFromString(ioniz_str);
     ioniz_def.multiplier = config.value("ioniz_multiplier", 1.0);
+    ioniz_def.quadrature = Integral::GetQuadratureFromString(config.value("ioniz_quadrature", "romberg"));
 
     std::string mupair_str = config.value("mupair", "none");
     mupair_def.parametrization = MupairProductionFactory::Get().GetEnumFromString(mupair_str);
     mupair_def.multiplier = config.value("mupair_multiplier", 1.0);
+    mupair_def.quadrature = Integral::GetQuadratureFromString(config.value("mupair_quadrature", "romberg"));
     mupair_def.particle_output = config.value("mupair_particle_output", true);
 
     std::string weak_str = config.value("weak", "none");
     weak_def.parametrization = WeakInteractionFactory::Get().GetEnumFromString(weak_str);
     weak_def.multiplier = config.value("weak_multiplier", 1.0);
+    weak_def.quadrature = Integral::GetQuadratureFromString(config.value("weak_quadrature", "romberg"));
 
     std::string photopair_str = config.value("photopair", "none");
     photopair_def.parametrization = PhotoPairFactory::Get().GetEnumFromString(photopair_str);
     photopair_def.multiplier = config.value("photopair_multiplier", 1.0);
+    photopair_def.quadrature = Integral::GetQuadratureFromString(config.value("photopair_quadrature", "romberg"));
     std::string photoangle_str = config.value("photangle", "PhotoAngleNoDeflection");
     photopair_def.photoangle = PhotoPairFactory::Get().GetPhotoAngleEnumFromString(photoangle_str);
 
     std::string annihilation_str = config.value("annihilation", "none");
     annihilation_def.parametrization = AnnihilationFactory::Get().GetEnumFromString(annihilation_str);
     annihilation_def.multiplier = config.value("annihilation_multiplier", 1.0);
+    annihilation_def.quadrature = Integral::GetQuadratureFromString(config.value("annihilation_quadrature", "romberg"));
+
+    int cache_size = config.value("integral_cache_size", 0);
+    if (cache_size < 0) {
+        log_fatal("The integral cache size must not be negative!");
+    }
+    integral_cache_size = cache_size;
+    integral_cache_tolerance = config.value("integral_cache_tolerance", 0.0);
+    if (integral_cache_tolerance < 0) {
+        log_fatal("The integral cache tolerance must not be negative!");
+    }
 }
 
 
@@ -133,6 +159,10 @@ bool Utility::Definition::operator==(
         return false;
     else if (annihilation_def != utility_def.annihilation_def)
         return false;
+    else if (integral_cache_size != utility_def.integral_cache_size)
+        return false;
+    else if (integral_cache_tolerance != utility_def.integral_cache_tolerance)
+        return false;
 
     return true;
 }
@@ -179,6 +209,8 @@ Utility::Utility(const ParticleDef& particle_def,
     , medium_(medium)
     , cut_settings_(cut_settings)
     , crosssections_()
+    , integral_cache_size_(utility_def.integral_cache_size)
+    , integral_cache_tolerance_(utility_def.integral_cache_tolerance)
 {
     if(utility_def.brems_def.parametrization!=BremsstrahlungFactory::Enum::None) {
         crosssections_.push_back(BremsstrahlungFactory::Get().CreateBremsstrahlung(
@@ -236,6 +268,16 @@ Utility::Utility(const ParticleDef& particle_def,
                 particle_def_, medium_, utility_def.photopair_def));
         log_debug("PhotoPairProduction enabled");
     }
+
+    if (integral_cache_size_ > 0) {
+        for (auto crosssection : crosssections_) {
+            auto crosssection_integral = dynamic_cast<CrossSectionIntegral*>(crosssection);
+            if (crosssection_integral) {
+                crosssection_integral->SetCache(
+                    integral_cache_size_, integral_cache_tolerance_);
+            }
+        }
+    }
 }
 
 Utility::Utility(const ParticleDef& particle_def,
@@ -247,6 +289,8 @@ Utility::Utility(const ParticleDef& particle_def,
     , medium_(medium)
     , cut_settings_(cut_settings)
     , crosssections_()
+    , integral_cache_size_(0)
+    , integral_cache_tolerance_(0)
 {
     if(utility_def.brems_def.parametrization!=BremsstrahlungFactory::Enum::None) {
         crosssections_.push_back(BremsstrahlungFactory::Get().CreateBremsstrahlung(
@@ -308,7 +352,9 @@ Utility::Utility(const ParticleDef& particle_def,
 Utility::Utility(const std::vector<CrossSection*>& crosssections) try
     : particle_def_(crosssections.at(0)->GetParametrization().GetParticleDef()),
       medium_(crosssections.at(0)->GetParametrization().GetMedium()),
-      cut_settings_(crosssections.at(0)->GetParametrization().GetEnergyCuts()) {
+      cut_settings_(crosssections.at(0)->GetParametrization().GetEnergyCuts()),
+      integral_cache_size_(0),
+      integral_cache_tolerance_(0) {
     for (std::vector<CrossSection*>::const_iterator it = crosssections.begin();
          it != crosssections.end(); ++it) {
         if ((*it)->GetParametrization().GetParticleDef() != particle_def_) {
@@ -334,7 +380,9 @@ Utility::Utility(const Utility& collection)
     : particle_def_(collection.particle_def_),
       medium_(collection.medium_),
       cut_settings_(collection.cut_settings_),
-      crosssections_(collection.crosssections_.size(), NULL) {
+      crosssections_(collection.crosssections_.size(), NULL),
+      integral_cache_size_(collection.integral_cache_size_),
+      integral_cache_tolerance_(collection.integral_cache_tolerance_) {
     for (unsigned int i = 0; i < crosssections_.size(); ++i) {
         crosssections_[i] = collection.crosssections_[i]->clone();
     }
@@ -29,18 +29,25 @@ using namespace PROPOSAL;
  ******************************************************************************/
 
 UtilityIntegral::UtilityIntegral(const Utility& utility)
-    : UtilityDecorator(utility), integral_(IROMB, IMAXS, IPREC2) {}
+    : UtilityDecorator(utility),
+      integral_(IROMB, IMAXS, IPREC2),
+      integrand_cache_(utility.GetIntegralCacheSize(),
+                       utility.GetIntegralCacheTolerance()) {}
 
 UtilityIntegral::UtilityIntegral(const Utility& utility,
                                  const UtilityIntegral& collection)
-    : UtilityDecorator(utility), integral_(collection.integral_) {
+    : UtilityDecorator(utility),
+      integral_(collection.integral_),
+      integrand_cache_(collection.integrand_cache_) {
     if (utility != collection.GetUtility()) {
         log_fatal("Utilities of the decorators should have same values!");
     }
 }
 
 UtilityIntegral::UtilityIntegral(const UtilityIntegral& collection)
-    : UtilityDecorator(collection), integral_(collection.integral_) {}
+    : UtilityDecorator(collection),
+      integral_(collection.integral_),
+      integrand_cache_(collection.integrand_cache_) {}
 
 UtilityIntegral::~UtilityIntegral() {}
 
@@ -54,6 +61,18 @@ bool UtilityIntegral::compare(const UtilityDecorator& utility_decorator) const {
         return true;
 }
 
+double UtilityIntegral::Integrand(double energy) {
+    const double* cached = integrand_cache_.Find(energy);
+    if (cached != nullptr) {
+        return *cached;
+    }
+
+    double value = FunctionToIntegral(energy);
+    integrand_cache_.Insert(energy, value);
+
+    return value;
+}
+
 double UtilityIntegral::GetUpperLimit(double ei, double rnd) {
     (void)ei;
     (void)rnd;
@@ -73,8 +92,7 @@ double UtilityIntegralDisplacement::Calculate(double ei,
                                               double rnd) {
     return integral_.IntegrateWithRandomRatio(
         ei, ef,
-        std::bind(&UtilityIntegralDisplacement::FunctionToIntegral, this,
-                  std::placeholders::_1),
+        [this](double energy) { return Integrand(energy); },
         4, -rnd);
 }
 
@@ -85,8 +103,7 @@ double UtilityIntegralDisplacement::Calculate(double ei,
                                               const Vector3D& direction) {
     double aux = integral_.IntegrateWithRandomRatio(
         ei, ef,
-        std::bind(&UtilityIntegralDisplacement::FunctionToIntegral, this,
-                  std::placeholders::_1),
+        [this](double energy) { return Integrand(energy); },
         4, -distance_to_border);
     return utility_.GetMedium()->GetDensityDistribution().Correct(
         xi, direction, aux, distance_to_border);
@@ -119,8 +136,7 @@ double UtilityIntegralInteraction::Calculate(double ei, double ef, double rnd) {
 
     return integral_.IntegrateWithRandomRatio(
         ei, ef,
-        std::bind(&UtilityIntegralInteraction::FunctionToIntegral, this,
-                  std::placeholders::_1),
+        [this](double energy) { return Integrand(energy); },
         4, -rnd);
 }
 
@@ -156,8 +172,7 @@ double UtilityIntegralDecay::Calculate(double ei, double ef, double rnd) {
 
     return integral_.IntegrateWithRandomRatio(
         ei, ef,
-        std::bind(&UtilityIntegralDecay::FunctionToIntegral, this,
-                  std::placeholders::_1),
+        [this](double energy) { return Integrand(energy); },
         4, -rnd);
 }
 
@@ -184,8 +199,7 @@ double UtilityIntegralTime::Calculate(double ei, double ef, double rnd) {
 
     return integral_.Integrate(
         ei, ef,
-        std::bind(&UtilityIntegralTime::FunctionToIntegral, this,
-                  std::placeholders::_1),
+        [this](double energy) { return Integrand(energy); },
         4);
 }
 
@@ -216,8 +230,7 @@ double UtilityIntegralContRand::Calculate(double ei, double ef, double rnd) {
     (void)rnd;
     return integral_.Integrate(
         ei, ef,
-        std::bind(&UtilityIntegralContRand::FunctionToIntegral, this,
-                  std::placeholders::_1),
+        [this](double energy) { return Integrand(energy); },
         4);
 }
 
@@ -244,8 +257,7 @@ double UtilityIntegralScattering::Calculate(double ei, double ef, double rnd) {
     (void)rnd;
     return integral_.Integrate(
         ei, ef,
-        std::bind(&UtilityIntegralScattering::FunctionToIntegral, this,
-                  std::placeholders::_1),
+        [this](double energy) { return Integrand(energy); },
         4);
 }
 
@@ -10,6 +10,7 @@
 #include "PROPOSAL/Logging.h"
 
 #include "PROPOSAL/crossection/CrossSection.h"
+#include "PROPOSAL/crossection/parametrization/Parametrization.h"
 
 #include "PROPOSAL/math/InterpolantBuilder.h"
 #include "PROPOSAL/math/MathMethods.h"
@@ -21,12 +22,13 @@ using namespace PROPOSAL;
  ******************************************************************************/
 
 UtilityInterpolant::UtilityInterpolant(
-    const Utility& utility, InterpolationDef def)
+    const Utility& utility, InterpolationDef def, int multiplier_power)
     : UtilityDecorator(utility)
     , stored_result_(0)
     , interpolant_(NULL)
     , interpolant_diff_(NULL)
     , interpolation_def_(def)
+    , multiplier_power_(multiplier_power)
 {
 }
 
@@ -37,6 +39,7 @@ UtilityInterpolant::UtilityInterpolant(
     , interpolant_(new Interpolant(*collection.interpolant_))
     , interpolant_diff_(new Interpolant(*collection.interpolant_diff_))
     , interpolation_def_(collection.interpolation_def_)
+    , multiplier_power_(collection.multiplier_power_)
 {
     if (utility != collection.GetUtility()) {
         log_fatal("Utilities of the decorators should have same values!");
@@ -49,6 +52,7 @@ UtilityInterpolant::UtilityInterpolant(const UtilityInterpolant& collection)
     , interpolant_(new Interpolant(*collection.interpolant_))
     , interpolant_diff_(new Interpolant(*collection.interpolant_diff_))
     , interpolation_def_(collection.interpolation_def_)
+    , multiplier_power_(collection.multiplier_power_)
 {
 }
 
@@ -93,15 +97,48 @@ void UtilityInterpolant::InitInterpolation(const std::string& name,
     Integral integral(IROMB, IMAXS, IPREC2);
     const ParticleDef& particle_def = utility_.GetParticleDef();
 
+    // --------------------------------------------------------------------- //
+    // Normalize the multipliers to the largest one
+    // --------------------------------------------------------------------- //
+
+    std::vector<CrossSection*> crosssections = utility_.GetCrosssections();
+
+    double multiplier_scale = 0;
+    for (auto crosssection : crosssections) {
+        multiplier_scale = std::max(
+            multiplier_scale, crosssection->GetParametrization().GetMultiplier());
+    }
+    if (multiplier_scale <= 0) {
+        multiplier_scale = 1;
+    }
+
+    double table_scale = std::pow(multiplier_scale, multiplier_power_);
+
+    size_t hash_digest = 0;
+    for (auto crosssection : crosssections) {
+        const Parametrization& param = crosssection->GetParametrization();
+        hash_combine(hash_digest, param.GetHash(),
+            param.GetMultiplier() / multiplier_scale, param.GetParticleDef().low);
+    }
+    if (name.compare("decay") == 0) {
+        hash_combine(hash_digest, particle_def.lifetime);
+    }
+
+    // --------------------------------------------------------------------- //
+    // Builder
+    // --------------------------------------------------------------------- //
+
     std::vector<std::pair<Interpolant**, std::function<double(double)>>>
         interpolants;
 
     interpolants.push_back(std::make_pair(&interpolant_,
-        std::bind(&UtilityInterpolant::BuildInterpolant, this,
-            std::placeholders::_1, std::ref(utility), std::ref(integral))));
+        [this, &utility, &integral, table_scale](double energy) {
+            return BuildInterpolant(energy, utility, integral) / table_scale;
+        }));
     interpolants.push_back(std::make_pair(&interpolant_diff_,
-        std::bind(&UtilityIntegral::FunctionToIntegral, &utility,
-            std::placeholders::_1)));
+        [&utility, table_scale](double energy) {
+            return utility.FunctionToIntegral(energy) / table_scale;
+        }));
 
     unsigned int number_of_interpolants = interpolants.size();
 
@@ -113,6 +150,7 @@ void UtilityInterpolant::InitInterpolation(const std::string& name,
     for (unsigned int i = 0; i < number_of_interpolants; ++i) {
         builder_vec[i]
             .SetMax(number_of_sampling_points)
+            .SetPrecision(interpolation_def_.interpolation_precision)
             .SetXMin(particle_def.low)
             .SetXMax(interpolation_def_.max_node_energy)
             .SetRomberg(interpolation_def_.order_of_interpolation)
@@ -129,15 +167,11 @@ void UtilityInterpolant::InitInterpolation(const std::string& name,
             = std::make_pair(&builder_vec[i], interpolants[i].first);
     }
 
-    std::vector<CrossSection*> crosssections = utility_.GetCrosssections();
-    std::vector<Parametrization*> params(crosssections.size(), NULL);
-
-    for (unsigned int i = 0; i < crosssections.size(); ++i) {
-        params[i] = &crosssections[i]->GetParametrization();
-    }
-
     Helper::InitializeInterpolation(
-        name, builder_container, params, interpolation_def_);
+        name, builder_container, hash_digest, interpolation_def_);
+
+    interpolant_->Scale(table_scale);
+    interpolant_diff_->Scale(table_scale);
 }
 
 /******************************************************************************
@@ -257,7 +291,7 @@ void UtilityInterpolantDisplacement::InitInterpolation(const std::string& name,
 
 UtilityInterpolantInteraction::UtilityInterpolantInteraction(
     const Utility& utility, InterpolationDef def)
-    : UtilityInterpolant(utility, def)
+    : UtilityInterpolant(utility, def, 0)
     , big_low_(0)
     , up_(0)
 {
@@ -565,7 +599,7 @@ void UtilityInterpolantTime::InitInterpolation(const std::string& name,
 
 UtilityInterpolantContRand::UtilityInterpolantContRand(
     const Utility& utility, InterpolationDef def)
-    : UtilityInterpolant(utility, def)
+    : UtilityInterpolant(utility, def, 0)
 {
     UtilityIntegralContRand utility_contrand(utility_);
     InitInterpolation(
@@ -0,0 +1,94 @@
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "PROPOSAL/Sector.h"
+#include "PROPOSAL/json.hpp"
+#include "PROPOSAL/math/Vector3D.h"
+
+namespace PROPOSAL {
+
+/**
+ * @brief Concentric shells of a layered sphere, e.g.\ the Earth
+ *
+ * Every layer is a hollow sphere with its own medium, whose density is a
+ * polynomial in the radius divided by the radius of the whole model, like
+ * in the Preliminary Reference Earth Model (PREM). The model itself is only
+ * a description: it expands into one sector definition per layer, which is
+ * handed to the Propagator like any other set of sectors, and the density
+ * along a track is taken from these sectors.
+ */
+class EarthModel
+{
+public:
+    struct Layer
+    {
+        double inner_radius; //!< in meter
+        double outer_radius; //!< in meter
+        std::string medium;
+        std::vector<double> density; //!< polynomial in r / R in g/cm^3
+
+        bool operator==(const Layer& layer) const;
+    };
+
+    // position of the center and radii in meter like for the geometries
+    EarthModel(const Vector3D& center, const std::vector<Layer>& layers);
+    EarthModel(const nlohmann::json&);
+
+    bool operator==(const EarthModel& earth_model) const;
+    bool operator!=(const EarthModel& earth_model) const;
+
+    //! Layers of the PREM (Dziewonski & Anderson 1981), the core is made of
+    //! iron, the mantle and the crust of standard rock and the top of water.
+    static std::vector<Layer> PREM();
+
+    //! One definition per layer with a hollow sphere as geometry and a
+    //! radial density polynomial relative to the density of the medium, the
+    //! other settings are copied from sector_def.
+    std::vector<Sector::Definition> CreateSectorDefinitions(const Sector::Definition& sector_def) const;
+
+    Vector3D GetCenter() const { return center_; }
+    const std::vector<Layer>& GetLayers() const { return layers_; }
+    unsigned int GetHierarchy() const { return hierarchy_; }
+    void SetHierarchy(unsigned int hierarchy) { hierarchy_ = hierarchy; }
+
+private:
+    void Init();
+
+    Vector3D center_;            //!< in cm
+    std::vector<Layer> layers_;
+    unsigned int hierarchy_;
+
+    std::vector<double> outer_radii_; //!< in cm, ascending
+};
+
+} // namespace PROPOSAL
@@ -97,6 +97,7 @@
 #include "PROPOSAL/medium/density_distr/density_homogeneous.h"
 #include "PROPOSAL/medium/density_distr/density_polynomial.h"
 #include "PROPOSAL/medium/density_distr/density_splines.h"
+#include "PROPOSAL/medium/density_distr/density_voxel.h"
 
 #include "PROPOSAL/math/Function.h"
 #include "PROPOSAL/math/Integral.h"
@@ -125,6 +126,7 @@
 #include "PROPOSAL/scattering/ScatteringNoScattering.h"
 
 #include "PROPOSAL/Constants.h"
+#include "PROPOSAL/EarthModel.h"
 #include "PROPOSAL/EnergyCutSettings.h"
 #include "PROPOSAL/Propagator.h"
 #include "PROPOSAL/PropagatorService.h"
@@ -49,6 +49,7 @@
 #include <vector>
 
 #include "PROPOSAL/Sector.h"
+#include "PROPOSAL/geometry/TraversalPlan.h"
 
 namespace PROPOSAL {
 
@@ -77,6 +78,22 @@ public:
     Secondaries Propagate(const DynamicData& particle_condition,
         double max_distance=1e20, double minimal_energy=0.);
 
+    // ----------------------------------------------------------------------------
+    /// @brief Stop particles which can not reach the detector any more
+    ///
+    /// The maximal range of a particle with continuous losses only is
+    /// tabulated for every sector. If the detector lies ahead and even this
+    /// range is shorter than the column depth to the detector or to the end of
+    /// the current sector, the propagation stops and the secondaries are
+    /// flagged with Secondaries::IsRangedOut. Sectors with continuous
+    /// randomization are never culled, since the randomized losses can be
+    /// smaller than the mean losses the ranges are based on.
+    ///
+    /// @param range_culling
+    // ----------------------------------------------------------------------------
+    void SetRangeCulling(bool range_culling);
+    bool GetRangeCulling() const { return !range_tables_.empty(); }
+
     // --------------------------------------------------------------------- //
     // Getter
     // --------------------------------------------------------------------- //
@@ -156,6 +173,31 @@ private:
     // ----------------------------------------------------------------------------
     double CalculateEffectiveDistance(const Vector3D& particle_position, const Vector3D& particle_direction);
 
+    // ----------------------------------------------------------------------------
+    /// @brief Build the traversal plan over the sector geometries and the detector
+    ///
+    /// The sectors keep their index, the detector is the last geometry.
+    // ----------------------------------------------------------------------------
+    void BuildTraversalPlan();
+
+    // ----------------------------------------------------------------------------
+    /// @brief Tabulate the range with continuous losses only for every sector
+    ///
+    /// The ranges are given in cm for the unscaled density of the medium on
+    /// the logarithmic energy nodes of the interpolation definition. Sectors
+    /// with continuous randomization get an empty table.
+    // ----------------------------------------------------------------------------
+    void BuildRangeTables();
+
+    // ----------------------------------------------------------------------------
+    /// @brief Upper bound of the range in the sector
+    ///
+    /// The range at the next energy node above the energy is returned, so the
+    /// table never underestimates it. Above the last node or without a table
+    /// the range is infinite.
+    // ----------------------------------------------------------------------------
+    double MaximalRange(unsigned int sector, double energy) const;
+
     // --------------------------------------------------------------------- //
     // Global default values
     // --------------------------------------------------------------------- //
@@ -199,8 +241,15 @@ private:
     std::vector<Sector*> sectors_;
     Sector* current_sector_;
 
+    TraversalPlan traversal_plan_; //!< border crossings along the current track segment
+
+    std::vector<std::vector<double>> range_tables_; //!< ranges of the sectors, empty without culling
+    double range_log_energy_min_ {0.};
+    double range_log_energy_step_ {0.};
+
     ParticleDef particle_def_;
     std::shared_ptr<const Geometry> detector_;
+    InterpolationDef interpolation_def_; //!< used for the range tables
 
     std::pair<double,double> produced_particle_moments_ {100., 10000.};
     unsigned int n_th_call_ {1};
@@ -88,6 +88,11 @@ public:
     void SetExitPoint(const DynamicData& exit_point);
     void SetClosestApproachPoint(const DynamicData& closest_approach_point);
 
+    // the propagation was stopped, because the particle can not reach the
+    // detector any more
+    bool IsRangedOut() const { return ranged_out_; }
+    void SetRangedOut(bool ranged_out) { ranged_out_ = ranged_out; }
+
 private:
     std::vector<DynamicData> secondaries_;
     std::shared_ptr<ParticleDef> primary_def_;
@@ -97,6 +102,8 @@ private:
     std::unique_ptr<DynamicData> entry_point_;
     std::unique_ptr<DynamicData> exit_point_;
     std::unique_ptr<DynamicData> closest_approach_point_;
+
+    bool ranged_out_;
 };
 
 } // namespace PROPOSAL
@@ -30,6 +30,8 @@
 
 // #include <string>
 // #include <vector>
+#include <atomic>
+#include <future>
 #include <memory>
 #include <tuple>
 
@@ -150,6 +152,10 @@ public:
         const double final_energy, const double border_length);
     double BorderLength(const Vector3D&, const Vector3D& );
 
+    // Displacement with continuous losses only, in cm for the unscaled
+    // density of the medium.
+    double ContinuousDisplacement(const double initial_energy, const double final_energy);
+
     // Loss Energies
     double EnergyMinimal(const double inital_energy, const double cut);
     double EnergyDecay(const double initial_energy, const double rnd);
@@ -167,6 +173,13 @@ public:
     Secondaries Propagate(const DynamicData& particle_condition,
         double max_distance=1e20, double minimal_energy=0.);
 
+    /**
+     *  Blocks until the interpolation tables of an asynchronously built
+     *  sector are ready. Returns immediately for all other sectors.
+     */
+    void WaitForTables() const;
+    bool TablesReady() const { return tables_ready_; }
+
     /**
      *  Makes Stochastic Energyloss
      *
@@ -189,14 +202,20 @@ public:
     // --------------------------------------------------------------------- //
 
     ParticleLocation::Enum GetLocation() const { return sector_def_.location; }
-    std::shared_ptr<Scattering> GetScattering() const { return scattering_; }
+    std::shared_ptr<Scattering> GetScattering() const { return std::atomic_load(&scattering_); }
     const ParticleDef GetParticleDef() const { return particle_def_; }
-    const Utility& GetUtility() const { return utility_; }
+    const Utility& GetUtility() const { return *std::atomic_load(&utility_); }
     const Definition& GetSectorDef() const { return sector_def_; }
 
 protected:
     Sector& operator=(const Sector&); // Undefined & not allowed
 
+    // Runs in the background if InterpolationDef::do_async_build is set.
+    // The tables are built against a private utility. Once the cross
+    // sections and later the propagation utilities are ready, copies bound
+    // to a new utility are published with atomic stores.
+    void BuildTables(const InterpolationDef&);
+
     // --------------------------------------------------------------------- //
     // Protected members
     // --------------------------------------------------------------------- //
@@ -205,7 +224,14 @@ protected:
 
     ParticleDef particle_def_;
 
-    Utility utility_;
+    // Correction factor of a homogeneous density distribution. The step
+    // loop uses it directly instead of the virtual density calls, zero if
+    // the density is not homogeneous.
+    double homogeneous_density_;
+
+    // All members below are exchanged by the table builder and therefore
+    // only accessed through std::atomic_load/std::atomic_store.
+    std::shared_ptr<Utility> utility_;
     std::shared_ptr<UtilityDecorator> displacement_calculator_;
     std::shared_ptr<UtilityDecorator> interaction_calculator_;
     std::shared_ptr<UtilityDecorator> decay_calculator_;
@@ -214,6 +240,12 @@ protected:
     std::shared_ptr<ContinuousRandomizer> cont_rand_;
     std::shared_ptr<Scattering> scattering_;
 
+    // Utilities of replaced components, which might still be in use.
+    std::vector<std::shared_ptr<Utility>> fallback_utilities_;
+    std::atomic<bool> tables_ready_;
+    std::atomic<bool> abort_table_build_;
+    std::shared_future<void> table_build_;
+
     /* std::pair<double, double> produced_particle_moments_{ 100., 10000. }; */
     /* unsigned int n_th_call_{ 1 }; */
 };
@@ -48,7 +48,6 @@ public:
     // Public methods
     // ----------------------------------------------------------------- //
 
-    double CalculatedEdx(double energy);
     double CalculatedEdxWithoutMultiplier(double energy);
 
 };
@@ -48,14 +48,15 @@ namespace PROPOSAL {
         // Public methods
         // ----------------------------------------------------------------- //
 
-        double CalculatedEdx(double energy);
         double CalculatedEdxWithoutMultiplier(double energy);
         virtual double CalculatedE2dxWithoutMultiplier(double energy);
-        virtual double CalculatedNdx(double energy);
+        using CrossSectionIntegral::CalculatedNdx;
         virtual double CalculatedNdx(double energy, double rnd);
 
         double CalculateCumulativeCrossSection(double energy, int i, double v);
         virtual std::pair<double, double> StochasticDeflection(double energy, double energy_loss);
+    protected:
+        virtual double CalculatedNdxWithoutMultiplier(double energy);
     private:
         double CalculateStochasticLoss(double energy, double rnd1);
 
@@ -30,6 +30,7 @@
 #pragma once
 
 #include "PROPOSAL/crossection/CrossSection.h"
+#include "PROPOSAL/math/EnergyCache.h"
 #include "PROPOSAL/math/Integral.h"
 
 namespace PROPOSAL {
@@ -46,7 +47,7 @@ public:
 
     virtual CrossSection* clone() const = 0;
 
-    virtual double CalculatedEdx(double energy) = 0;
+    virtual double CalculatedEdx(double energy);
     virtual double CalculatedEdxWithoutMultiplier(double energy) = 0;
     virtual double CalculatedE2dx(double energy);
     virtual double CalculatedE2dxWithoutMultiplier(double energy);
@@ -55,13 +56,24 @@ public:
     virtual double CalculateStochasticLoss(double energy, double rnd1, double rnd2);
     virtual double CalculateCumulativeCrossSection(double energy, int component, double v);
 
+    // Memoizes dEdx, dE2dx and dNdx for the last size energies each.
+    // Energies within the relative tolerance share their values.
+    void SetCache(size_t size, double tolerance);
+
 protected:
     virtual bool compare(const CrossSection&) const;
 
+    // total rate without multiplier, also sets prob_for_component_ and sum_of_rates_
+    virtual double CalculatedNdxWithoutMultiplier(double energy);
+
     Integral dedx_integral_;
     Integral de2dx_integral_;
     IntegralVec dndx_integral_;
 
+    EnergyCache<double> dedx_cache_;
+    EnergyCache<double> de2dx_cache_;
+    EnergyCache<std::vector<double> > dndx_cache_; // prob_for_component_ followed by sum_of_rates_
+
     virtual double CalculateStochasticLoss(double energy, double rnd1);
 };
 
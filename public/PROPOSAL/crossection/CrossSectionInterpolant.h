@@ -55,6 +55,7 @@ public:
     // Needed to initialize interpolation
     virtual double FunctionToBuildDNdxInterpolant(double energy, int component);
     virtual double FunctionToBuildDNdxInterpolant2D(double energy, double v, Integral&, int component);
+    double FunctionToBuildCutIndependentDNdxInterpolant2D(double energy, double v, Integral&, int component);
     virtual double CalculateCumulativeCrossSection(double energy, int component, double v);
 
 protected:
@@ -65,10 +66,47 @@ protected:
     virtual double CalculateStochasticLoss(double energy, double rnd1);
     virtual void InitdNdxInterpolation(const InterpolationDef& def);
 
+    // ----------------------------------------------------------------- //
+    // Per component tables
+    //
+    // The dNdx tables are stored for a single atom of every component and
+    // keyed by the component hash, so media made of the same elements share
+    // them. After loading they are scaled to the atom density of the medium.
+    // The table functions therefore have to be divided by
+    // GetComponentNormalization.
+    // ----------------------------------------------------------------- //
+
+    void InitializeComponentInterpolation(const std::string& name,
+                                          Helper::InterpolantBuilderContainer& builder_container2d,
+                                          Helper::InterpolantBuilderContainer& builder_container1d,
+                                          bool cut_dependent,
+                                          const InterpolationDef& def);
+    double GetComponentNormalization(int component) const;
+
+    // ----------------------------------------------------------------- //
+    // Cut independent dNdx tables
+    //
+    // The 2d tables hold the integral of dNdx from v to vMax on a log grid
+    // starting at an energy loss of cut_independent_min_loss_. They do not
+    // depend on the energy cuts and are shared between all cut settings.
+    // dNdx and the sampling for the actual cut are derived from them.
+    // ----------------------------------------------------------------- //
+
+    bool InitCutIndependentdNdxInterpolation(const InterpolationDef& def);
+    double CalculateCutIndependentdNdx(double energy, int component);
+    double GetCutIndependentVLow(double energy, double v_min) const;
+
+    // Find the relative energy loss v for the given random number.
+    // rate is the dNdx of the component the random number is scaled with.
+    double CalculateRelativeLoss(double energy, int component, double rnd, double rate);
+
+    static const double cut_independent_min_loss_;
+
     Interpolant* dedx_interpolant_;
     Interpolant* de2dx_interpolant_;
     InterpolantVec dndx_interpolant_1d_; // Stochastic dNdx()
     InterpolantVec dndx_interpolant_2d_; // Stochastic dNdx()
+    bool cut_independent_dndx_;
 };
 
 } // namespace PROPOSAL
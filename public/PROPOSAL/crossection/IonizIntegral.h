@@ -48,13 +48,14 @@ public:
     // Public methods
     // ----------------------------------------------------------------- //
 
-    double CalculatedEdx(double energy);
     double CalculatedEdxWithoutMultiplier(double energy);
-    double CalculatedE2dx(double energy);
     double CalculatedE2dxWithoutMultiplier(double energy);
-    double CalculatedNdx(double energy);
+    using CrossSectionIntegral::CalculatedNdx;
     double CalculatedNdx(double energy, double rnd);
 
+protected:
+    double CalculatedNdxWithoutMultiplier(double energy);
+
 private:
     virtual double CalculateStochasticLoss(double energy, double rnd1);
 };
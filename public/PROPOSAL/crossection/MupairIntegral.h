@@ -48,7 +48,6 @@ public:
     // Public methods
     // ----------------------------------------------------------------- //
 
-    double CalculatedEdx(double energy);
     double CalculatedEdxWithoutMultiplier(double energy);
     std::pair<std::vector<DynamicData>, bool> CalculateProducedParticles(double energy, double energy_loss, const Vector3D& initial_direction);
 
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "PROPOSAL/crossection/CrossSectionInterpolant.h"
 
 namespace PROPOSAL {
@@ -53,6 +55,17 @@ public:
 
 private:
     InteractionType GetType(const MupairProduction& param);
+
+    // Tables of the inverse cumulative rho distribution. For every component
+    // there is one table in (energy, v) per inner node of the random number,
+    // storing rho / rho_max. The nodes rnd = 0 and rnd = 1 are 0 and 1.
+    void InitRhoInterpolation(const InterpolationDef& def);
+    // rho / rho_max at the inner random number nodes, v = vMin * (vMax / vMin)^t
+    std::vector<double> FunctionToBuildRhoInterpolant(double energy, double t, int component, int nodes);
+    double Calculaterho(double energy, double v, double rnd1, double rnd2);
+
+    std::vector<InterpolantVec> rho_interpolant_;
+
     ParticleDef const* muminus_def_;
     ParticleDef const* muplus_def_;
 };
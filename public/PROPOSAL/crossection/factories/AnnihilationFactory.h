@@ -34,6 +34,7 @@
 #include <memory>
 #include <sstream>
 
+#include "PROPOSAL/math/Integral.h"
 #include "PROPOSAL/methods.h"
 
 namespace PROPOSAL {
@@ -60,6 +61,7 @@ namespace PROPOSAL {
             Definition()
                 : parametrization(None)
                 , multiplier(1.0)
+                , quadrature(Integral::Romberg)
             {
             }
 
@@ -69,6 +71,8 @@ namespace PROPOSAL {
                     return false;
                 else if (multiplier != def.multiplier)
                     return false;
+                else if (quadrature != def.quadrature)
+                    return false;
 
                 return true;
             }
@@ -86,6 +90,7 @@ namespace PROPOSAL {
 
                 os << "Parametrization: " << definition.parametrization << std::endl;
                 os << "Multiplier: " << definition.multiplier << std::endl;
+                os << "Quadrature: " << definition.quadrature << std::endl;
 
                 os << Helper::Centered(60, "");
                 return os;
@@ -93,6 +98,7 @@ namespace PROPOSAL {
 
             Enum parametrization;
             double multiplier;
+            Integral::Quadrature quadrature;
         };
 
         // --------------------------------------------------------------------- //
@@ -36,6 +36,7 @@
 #include <memory>
 #include <sstream>
 
+#include "PROPOSAL/math/Integral.h"
 #include "PROPOSAL/methods.h"
 
 namespace PROPOSAL {
@@ -71,6 +72,7 @@ public:
             : parametrization(KelnerKokoulinPetrukhin)
             , lpm_effect(true)
             , multiplier(1.0)
+            , quadrature(Integral::Romberg)
         {
         }
 
@@ -82,6 +84,8 @@ public:
                 return false;
             else if (multiplier != def.multiplier)
                 return false;
+            else if (quadrature != def.quadrature)
+                return false;
 
             return true;
         }
@@ -99,6 +103,7 @@ public:
 
             os << "Parametrization: " << definition.parametrization << std::endl;
             os << "Multiplier: " << definition.multiplier << std::endl;
+            os << "Quadrature: " << definition.quadrature << std::endl;
             os << "LPM Effect: " << definition.lpm_effect << std::endl;
 
             os << Helper::Centered(60, "");
@@ -108,6 +113,7 @@ public:
         Enum parametrization;
         bool lpm_effect;
         double multiplier;
+        Integral::Quadrature quadrature;
     };
 
     // --------------------------------------------------------------------- //
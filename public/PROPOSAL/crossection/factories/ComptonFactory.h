@@ -36,6 +36,7 @@
 #include <memory>
 #include <sstream>
 
+#include "PROPOSAL/math/Integral.h"
 #include "PROPOSAL/methods.h"
 
 namespace PROPOSAL {
@@ -65,6 +66,7 @@ namespace PROPOSAL {
             Definition()
                     : parametrization(None)
                     , multiplier(1.0)
+                    , quadrature(Integral::Romberg)
             {
             }
 
@@ -74,6 +76,8 @@ namespace PROPOSAL {
                     return false;
                 else if (multiplier != def.multiplier)
                     return false;
+                else if (quadrature != def.quadrature)
+                    return false;
 
                 return true;
             }
@@ -91,6 +95,7 @@ namespace PROPOSAL {
 
                 os << "Parametrization: " << definition.parametrization << std::endl;
                 os << "Multiplier: " << definition.multiplier << std::endl;
+                os << "Quadrature: " << definition.quadrature << std::endl;
 
                 os << Helper::Centered(60, "");
                 return os;
@@ -98,6 +103,7 @@ namespace PROPOSAL {
 
             Enum parametrization;
             double multiplier;
+            Integral::Quadrature quadrature;
         };
 
         // --------------------------------------------------------------------- //
@@ -33,6 +33,7 @@
 #include <memory>
 #include <sstream>
 
+#include "PROPOSAL/math/Integral.h"
 #include "PROPOSAL/methods.h"
 
 namespace PROPOSAL {
@@ -61,6 +62,7 @@ public:
             : parametrization(KelnerKokoulinPetrukhin)
             , lpm_effect(true)
             , multiplier(1.0)
+            , quadrature(Integral::Romberg)
         {
         }
 
@@ -72,6 +74,8 @@ public:
                 return false;
             else if (multiplier != def.multiplier)
                 return false;
+            else if (quadrature != def.quadrature)
+                return false;
 
             return true;
         }
@@ -89,6 +93,7 @@ public:
 
             os << "Parametrization: " << definition.parametrization << std::endl;
             os << "Multiplier: " << definition.multiplier << std::endl;
+            os << "Quadrature: " << definition.quadrature << std::endl;
             os << "LPM Effect: " << definition.lpm_effect << std::endl;
 
             os << Helper::Centered(60, "");
@@ -98,6 +103,7 @@ public:
         Enum parametrization;
         bool lpm_effect;
         double multiplier;
+        Integral::Quadrature quadrature;
     };
 
     // --------------------------------------------------------------------- //
@@ -37,6 +37,7 @@
 #include <iostream>
 #include <sstream>
 
+#include "PROPOSAL/math/Integral.h"
 #include "PROPOSAL/methods.h"
 
 namespace PROPOSAL {
@@ -64,6 +65,7 @@ public:
         Definition()
             : parametrization(BetheBlochRossi)
             , multiplier(1.0)
+            , quadrature(Integral::Romberg)
         {
         }
 
@@ -73,6 +75,8 @@ public:
                 return false;
             else if(multiplier != def.multiplier)
                 return false;
+            else if (quadrature != def.quadrature)
+                return false;
             return true;
         }
 
@@ -89,6 +93,7 @@ public:
 
             os << "Parametrization: " << definition.parametrization << std::endl;
             os << "Multiplier: " << definition.multiplier << std::endl;
+            os << "Quadrature: " << definition.quadrature << std::endl;
 
             os << Helper::Centered(60, "");
             return os;
@@ -96,6 +101,7 @@ public:
 
         Enum parametrization;
         double multiplier;
+        Integral::Quadrature quadrature;
     };
 
     // --------------------------------------------------------------------- //
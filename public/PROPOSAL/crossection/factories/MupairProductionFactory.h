@@ -33,6 +33,7 @@
 #include <memory>
 #include <sstream>
 
+#include "PROPOSAL/math/Integral.h"
 #include "PROPOSAL/methods.h"
 
 namespace PROPOSAL {
@@ -59,6 +60,7 @@ public:
         Definition()
             : parametrization(None)
             , multiplier(1.0)
+            , quadrature(Integral::Romberg)
             , particle_output(true)
         {
         }
@@ -69,6 +71,8 @@ public:
                 return false;
             else if (multiplier != def.multiplier)
                 return false;
+            else if (quadrature != def.quadrature)
+                return false;
             else if (particle_output != def.particle_output)
                 return false;
 
@@ -88,6 +92,7 @@ public:
 
             os << "Parametrization: " << definition.parametrization << std::endl;
             os << "Multiplier: " << definition.multiplier << std::endl;
+            os << "Quadrature: " << definition.quadrature << std::endl;
             os << "Particle Output: " << definition.particle_output << std::endl;
 
             os << Helper::Centered(60, "");
@@ -96,6 +101,7 @@ public:
 
         Enum parametrization;
         double multiplier;
+        Integral::Quadrature quadrature;
         bool particle_output;
     };
 
@@ -35,6 +35,7 @@
 #include <memory>
 #include <sstream>
 
+#include "PROPOSAL/math/Integral.h"
 #include "PROPOSAL/methods.h"
 
 namespace PROPOSAL {
@@ -73,6 +74,7 @@ namespace PROPOSAL {
                     : parametrization(None)
                     , photoangle(PhotoAngleNoDeflection)
                     , multiplier(1.0)
+                    , quadrature(Integral::Romberg)
             {
             }
 
@@ -82,6 +84,8 @@ namespace PROPOSAL {
                     return false;
                 else if (multiplier != def.multiplier)
                     return false;
+                else if (quadrature != def.quadrature)
+                    return false;
                 else if (photoangle != def.photoangle)
                     return false;
 
@@ -101,6 +105,7 @@ namespace PROPOSAL {
 
                 os << "Parametrization: " << definition.parametrization << std::endl;
                 os << "Multiplier: " << definition.multiplier << std::endl;
+                os << "Quadrature: " << definition.quadrature << std::endl;
                 os << "PhotoAngle: " << definition.photoangle << std::endl;
 
                 os << Helper::Centered(60, "");
@@ -110,6 +115,7 @@ namespace PROPOSAL {
             Enum parametrization;
             PhotoAngle photoangle;
             double multiplier;
+            Integral::Quadrature quadrature;
         };
 
         // --------------------------------------------------------------------- //
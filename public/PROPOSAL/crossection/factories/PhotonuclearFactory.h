@@ -37,6 +37,7 @@
 #include <iostream>
 #include <sstream>
 
+#include "PROPOSAL/math/Integral.h"
 #include "PROPOSAL/methods.h"
 
 namespace PROPOSAL {
@@ -84,6 +85,7 @@ public:
             , shadow(ShadowButkevichMikhailov)
             , hard_component(true)
             , multiplier(1.0)
+            , quadrature(Integral::Romberg)
         {
         }
 
@@ -97,6 +99,8 @@ public:
                 return false;
             else if (multiplier != def.multiplier)
                 return false;
+            else if (quadrature != def.quadrature)
+                return false;
 
             return true;
         }
@@ -114,6 +118,7 @@ public:
 
             os << "Parametrization: " << definition.parametrization << std::endl;
             os << "Multiplier: " << definition.multiplier << std::endl;
+            os << "Quadrature: " << definition.quadrature << std::endl;
             os << "Shadowing Parametrization: " << definition.shadow << std::endl;
             os << "Hard Component: " << definition.hard_component << std::endl;
 
@@ -125,6 +130,7 @@ public:
         Shadow shadow;
         bool hard_component;
         double multiplier;
+        Integral::Quadrature quadrature;
     };
 
     // --------------------------------------------------------------------- //
@@ -33,6 +33,7 @@
 #include <memory>
 #include <sstream>
 
+#include "PROPOSAL/math/Integral.h"
 #include "PROPOSAL/methods.h"
 
 namespace PROPOSAL {
@@ -59,6 +60,7 @@ namespace PROPOSAL {
             Definition()
                     : parametrization(None)
                     , multiplier(1.0)
+                    , quadrature(Integral::Romberg)
             {
             }
 
@@ -68,6 +70,8 @@ namespace PROPOSAL {
                     return false;
                 else if (multiplier != def.multiplier)
                     return false;
+                else if (quadrature != def.quadrature)
+                    return false;
 
                 return true;
             }
@@ -85,6 +89,7 @@ namespace PROPOSAL {
 
                 os << "Parametrization: " << definition.parametrization << std::endl;
                 os << "Multiplier: " << definition.multiplier << std::endl;
+                os << "Quadrature: " << definition.quadrature << std::endl;
 
                 os << Helper::Centered(60, "");
                 return os;
@@ -92,6 +97,7 @@ namespace PROPOSAL {
 
             Enum parametrization;
             double multiplier;
+            Integral::Quadrature quadrature;
         };
 
         // --------------------------------------------------------------------- //
@@ -55,7 +55,8 @@ namespace PROPOSAL {
 
         virtual IntegralLimits GetIntegralLimits(double energy);
 
-        virtual size_t GetHash() const;
+        virtual size_t GetParametrizationHash() const;
+        virtual size_t GetComponentHash(int component) const;
 
     protected:
         bool compare(const Parametrization&) const;
@@ -74,13 +74,18 @@ public:
     virtual double DifferentialCrossSection(double energy, double v);
     virtual double CalculateParametrization(double energy, double v) = 0;
 
+    // batch forms, see Parametrization::DifferentialCrossSection
+    virtual void DifferentialCrossSection(double energy, const double* v, double* out, size_t n);
+    virtual void CalculateParametrization(double energy, const double* v, double* out, size_t n);
+
     virtual IntegralLimits GetIntegralLimits(double energy);
 
     // ----------------------------------------------------------------- //
     // Getter
     // ----------------------------------------------------------------- //
 
-    virtual size_t GetHash() const;
+    virtual size_t GetParametrizationHash() const;
+    virtual size_t GetComponentHash(int component) const;
 
 protected:
     virtual bool compare(const Parametrization&) const;
@@ -108,7 +113,38 @@ protected:
 // ------------------------------------------------------------------------- //
 
 BREMSSTRAHLUNG_DEF(PetrukhinShestakov)
-BREMSSTRAHLUNG_DEF(KelnerKokoulinPetrukhin)
+
+// ------------------------------------------------------------------------- //
+// KelnerKokoulinPetrukhin declaration
+// additionally provides the batch form of the parametrization
+// ------------------------------------------------------------------------- //
+
+class BremsKelnerKokoulinPetrukhin : public Bremsstrahlung
+{
+public:
+    BremsKelnerKokoulinPetrukhin(const ParticleDef&, std::shared_ptr<const Medium>, const EnergyCutSettings&, double multiplier, bool lpm);
+    BremsKelnerKokoulinPetrukhin(const BremsKelnerKokoulinPetrukhin&);
+    ~BremsKelnerKokoulinPetrukhin();
+
+    Parametrization* clone() const { return new BremsKelnerKokoulinPetrukhin(*this); }
+    static Bremsstrahlung* create(const ParticleDef& particle_def,
+                                  std::shared_ptr<const Medium> medium,
+                                  const EnergyCutSettings& cuts,
+                                  double multiplier,
+                                  bool lpm)
+    {
+        return new BremsKelnerKokoulinPetrukhin(particle_def, medium, cuts, multiplier, lpm);
+    }
+
+    double CalculateParametrization(double energy, double v);
+    void CalculateParametrization(double energy, const double* v, double* out, size_t n);
+
+    const std::string& GetName() const { return name_; }
+
+private:
+    static const std::string name_;
+};
+
 BREMSSTRAHLUNG_DEF(CompleteScreening)
 BREMSSTRAHLUNG_DEF(AndreevBezrukovBugaev)
 BREMSSTRAHLUNG_DEF(SandrockSoedingreksoRhode)
@@ -136,6 +172,7 @@ public:
 
     double CalculateParametrization(double energy, double v);
     double DifferentialCrossSection(double energy, double v);
+    void DifferentialCrossSection(double energy, const double* v, double* out, size_t n);
 
     const std::string& GetName() const { return name_; }
 
@@ -137,6 +137,10 @@ public:
 
     virtual double DifferentialCrossSection(double energy, double v);
 
+    // With Integral::Cubature, v and rho are integrated at once. The rho
+    // integral runs in log(r) from max(1 - r_max, ComputerPrecision) to 1.
+    virtual bool IntegrateDifferentialCrossSection(double energy, double v_min, double v_max, int moment, double& result);
+
     // ----------------------------------------------------------------------------
     /// @brief This is the calculation of the d2Sigma/dvdRo - interface to Integral
     ///
@@ -146,22 +150,56 @@ public:
     // ----------------------------------------------------------------------------
     virtual double FunctionToIntegral(double energy, double v, double rho) = 0;
 
-    virtual size_t GetHash() const;
+    // Batch form for n values of rho at fixed energy and v, used by the rho
+    // integration. The default evaluates the points one by one.
+    virtual void FunctionToIntegral(double energy, double v, const double* rho, double* out, size_t n);
+
+    virtual size_t GetParametrizationHash() const;
+    virtual size_t GetComponentHash(int component) const;
+
+    virtual void SetQuadrature(Integral::Quadrature);
 
 private:
     bool compare(const Parametrization&) const;
     virtual void print(std::ostream&) const;
 
     Integral integral_;
+    Cubature cubature_;
 };
 
 /******************************************************************************
  *                     Declare Integral Parametrizations                      *
  ******************************************************************************/
 
-EPAIR_PARAM_INTEGRAL_DEC(KelnerKokoulinPetrukhin)
 EPAIR_PARAM_INTEGRAL_DEC(SandrockSoedingreksoRhode)
 
+// KelnerKokoulinPetrukhin additionally provides the batch form of the integrand
+class EpairKelnerKokoulinPetrukhin : public EpairProductionRhoIntegral
+{
+public:
+    EpairKelnerKokoulinPetrukhin(const ParticleDef&, std::shared_ptr<const Medium>, const EnergyCutSettings&, double multiplier, bool lpm);
+    EpairKelnerKokoulinPetrukhin(const EpairKelnerKokoulinPetrukhin&);
+    virtual ~EpairKelnerKokoulinPetrukhin();
+
+    virtual Parametrization* clone() const { return new EpairKelnerKokoulinPetrukhin(*this); }
+    static EpairProduction* create(const ParticleDef& particle_def,
+                                   std::shared_ptr<const Medium> medium,
+                                   const EnergyCutSettings& cuts,
+                                   double multiplier,
+                                   bool lpm)
+    {
+        return new EpairKelnerKokoulinPetrukhin(particle_def, medium, cuts, multiplier, lpm);
+    }
+
+    double FunctionToIntegral(double energy, double v, double rho);
+    void FunctionToIntegral(double energy, double v, const double* rho, double* out, size_t n);
+
+    const std::string& GetName() const { return name_; }
+
+protected:
+    static const std::string name_;
+};
+
 /******************************************************************************
  *                    Declare Interpolant Parametrizations                    *
  ******************************************************************************/
@@ -195,6 +233,9 @@ public:
 
     double DifferentialCrossSection(double energy, double v);
 
+    // the interpolated cross section is cheap, the v integral stays one-dimensional
+    bool IntegrateDifferentialCrossSection(double, double, double, int, double&) { return false; }
+
 protected:
     virtual bool compare(const Parametrization&) const;
     double FunctionToBuildPhotoInterpolant(double energy, double v, int component);
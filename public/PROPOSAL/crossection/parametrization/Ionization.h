@@ -46,6 +46,12 @@ public:
     // ----------------------------------------------------------------- //
     double Delta(double beta, double gamma);
     double DifferentialCrossSection(double energy, double v) = 0;
+
+    // the ionization parametrizations define their own dEdx integrand
+    using Parametrization::FunctionToDEdxIntegral;
+    void FunctionToDEdxIntegral(double energy, const double* v, double* out, size_t n);
+
+    virtual size_t GetComponentHash(int component) const;
 private:
 
 };
@@ -74,6 +80,9 @@ public:
      double DifferentialCrossSection(double energy, double v);
      double FunctionToDEdxIntegral(double energy, double v);
 
+     void DifferentialCrossSection(double energy, const double* v, double* out, size_t n);
+     void FunctionToDEdxIntegral(double energy, const double* v, double* out, size_t n);
+
      const std::string& GetName() const { return name_; }
 
 private:
@@ -126,7 +126,9 @@ public:
     ///
     // ----------------------------------------------------------------------------
 
-    virtual size_t GetHash() const;
+    virtual size_t GetParametrizationHash() const;
+
+    virtual void SetQuadrature(Integral::Quadrature);
 
 private:
     bool compare(const Parametrization&) const;
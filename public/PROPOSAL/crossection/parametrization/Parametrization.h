@@ -29,7 +29,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+
 #include "PROPOSAL/EnergyCutSettings.h"
+#include "PROPOSAL/math/Cubature.h"
+#include "PROPOSAL/math/Integral.h"
 #include "PROPOSAL/particle/ParticleDef.h"
 #include "PROPOSAL/medium/Medium.h"
 
@@ -67,10 +72,27 @@ public:
 
     virtual double DifferentialCrossSection(double energy, double v) = 0;
 
+    // Batch form, out[i] = DifferentialCrossSection(energy, v[i]) for i < n.
+    // Integral::IntegrateBatch passes all abscissae of a quadrature step at
+    // once, so parametrizations can hoist the energy dependent terms out of
+    // the loop over v. The default evaluates the points one by one.
+    virtual void DifferentialCrossSection(double energy, const double* v, double* out, size_t n);
+
     double FunctionToDNdxIntegral(double energy, double v);
     virtual double FunctionToDEdxIntegral(double energy, double v);
     double FunctionToDE2dxIntegral(double energy, double v);
 
+    void FunctionToDNdxIntegral(double energy, const double* v, double* out, size_t n);
+    virtual void FunctionToDEdxIntegral(double energy, const double* v, double* out, size_t n);
+    void FunctionToDE2dxIntegral(double energy, const double* v, double* out, size_t n);
+
+    // Integral of v^moment * DifferentialCrossSection over [v_min, v_max] for
+    // the current component. Parametrizations whose differential cross
+    // section is itself an integral (over rho or Q2) do both integrations at
+    // once with Cubature if their quadrature is Integral::Cubature. Returns
+    // false otherwise, the caller has to integrate over v on its own then.
+    virtual bool IntegrateDifferentialCrossSection(double energy, double v_min, double v_max, int moment, double& result);
+
     virtual double Calculaterho(double energy, double v, double rnd1, double rnd2){
         (void)energy; (void)v; (void)rnd1; (void)rnd2; return 0;}
 
@@ -86,9 +108,21 @@ public:
     std::shared_ptr<const Medium> GetMedium() const { return medium_; }
     const EnergyCutSettings& GetEnergyCuts() const { return cut_settings_; }
     double GetMultiplier() const { return multiplier_; }
+    int GetCurrentComponent() const { return component_index_; }
+    Integral::Quadrature GetQuadrature() const { return quadrature_; }
     virtual bool IsParticleOutputEnabled() const {return false;} // no particle production per default
 
-    virtual size_t GetHash() const;
+    // Hash of the parametrization and the particle, without medium and cuts.
+    virtual size_t GetParametrizationHash() const;
+
+    // Hash of everything the differential cross section depends on.
+    // Tables which are independent of the energy cuts are keyed by this one.
+    size_t GetCutIndependentHash() const;
+    size_t GetHash() const;
+
+    // Hash of the cross section of a single atom of the given component.
+    // Parametrizations depending on the whole medium have to add it here.
+    virtual size_t GetComponentHash(int component) const;
 
     // ----------------------------------------------------------------- //
     // Setter
@@ -97,11 +131,61 @@ public:
     // void SetCurrentComponent(Components::Component* component) {current_component_ = component;}
     void SetCurrentComponent(int index) { component_index_ = index; }
 
+    // Quadrature used for the integrals of this parametrization, including
+    // the integrals over v of the cross section built from it.
+    virtual void SetQuadrature(Integral::Quadrature quadrature) { quadrature_ = quadrature; }
+
 protected:
 
     virtual bool compare(const Parametrization&) const;
     virtual void print(std::ostream&) const {};
 
+    // Integrates v^moment * f(v, u) over [v_min, v_max] x [0, 1], where
+    // integrand(v, u, out, n) sets out[i] = f(v, u[i]). Below v = 0.5 the
+    // cubature runs in log(v), above in log(1 - v), to resolve the steep
+    // cross sections at both ends of the kinematic range.
+    template <typename Integrand>
+    double IntegrateWithCubature(Cubature& cubature, double v_min, double v_max, int moment, Integrand integrand)
+    {
+        if (v_min > v_max)
+        {
+            return -IntegrateWithCubature(cubature, v_max, v_min, moment, integrand);
+        }
+
+        double v_split = std::min(std::max(0.5, v_min), v_max);
+        double sum     = 0;
+
+        if (v_min < v_split)
+        {
+            sum += cubature.Integrate(
+                std::log(v_min), std::log(v_split), 0, 1, [&](double t, const double* u, double* out, size_t n) {
+                    double v = std::exp(t);
+                    integrand(v, u, out, n);
+                    double jacobian = std::pow(v, moment + 1);
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        out[i] *= jacobian;
+                    }
+                });
+        }
+
+        if (v_split < v_max)
+        {
+            sum += cubature.Integrate(
+                std::log(1 - v_max), std::log(1 - v_split), 0, 1, [&](double t, const double* u, double* out, size_t n) {
+                    double w = std::exp(t);
+                    integrand(1 - w, u, out, n);
+                    double jacobian = std::pow(1 - w, moment) * w;
+                    for (size_t i = 0; i < n; ++i)
+                    {
+                        out[i] *= jacobian;
+                    }
+                });
+        }
+
+        return sum;
+    }
+
     // const std::string name_;
 
     const ParticleDef particle_def_;
@@ -113,6 +197,7 @@ protected:
     int component_index_;
 
     double multiplier_;
+    Integral::Quadrature quadrature_;
 };
 
 std::ostream& operator<<(std::ostream&, PROPOSAL::Parametrization const&);
@@ -65,7 +65,7 @@ namespace PROPOSAL {
 
         virtual IntegralLimits GetIntegralLimits(double energy);
 
-        virtual size_t GetHash() const;
+        virtual size_t GetParametrizationHash() const;
 
     protected:
         bool compare(const Parametrization&) const;
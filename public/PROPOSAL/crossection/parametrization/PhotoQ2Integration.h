@@ -96,13 +96,27 @@ public:
 
     virtual double DifferentialCrossSection(double energy, double v);
 
+    // With Integral::Cubature, v and Q2 are integrated at once. The Q2
+    // integral runs in log(Q2) between the same limits as in DifferentialCrossSection.
+    virtual bool IntegrateDifferentialCrossSection(double energy, double v_min, double v_max, int moment, double& result);
+
     virtual double FunctionToQ2Integral(double energy, double v, double Q2) = 0;
 
+    // Batch form for n values of Q2 at fixed energy and v, used by the Q2
+    // integration. The default evaluates the points one by one.
+    virtual void FunctionToQ2Integral(double energy, double v, const double* Q2, double* out, size_t n);
+
     // --------------------------------------------------------------------- //
     // Getter
     // --------------------------------------------------------------------- //
 
-    virtual size_t GetHash() const;
+    virtual size_t GetParametrizationHash() const;
+
+    // --------------------------------------------------------------------- //
+    // Setter
+    // --------------------------------------------------------------------- //
+
+    virtual void SetQuadrature(Integral::Quadrature);
 
 protected:
     virtual bool compare(const Parametrization&) const;
@@ -110,6 +124,7 @@ protected:
 
     ShadowEffect* shadow_effect_;
     Integral integral_;
+    Cubature cubature_;
 };
 
 /******************************************************************************
@@ -117,10 +132,40 @@ protected:
  ******************************************************************************/
 
 Q2_PHOTO_PARAM_INTEGRAL_DEC(AbramowiczLevinLevyMaor91)
-Q2_PHOTO_PARAM_INTEGRAL_DEC(AbramowiczLevinLevyMaor97)
 Q2_PHOTO_PARAM_INTEGRAL_DEC(ButkevichMikhailov)
 Q2_PHOTO_PARAM_INTEGRAL_DEC(RenoSarcevicSu)
 
+// AbramowiczLevinLevyMaor97 additionally provides the batch form of the integrand
+class PhotoAbramowiczLevinLevyMaor97 : public PhotoQ2Integral
+{
+public:
+    PhotoAbramowiczLevinLevyMaor97(const ParticleDef&,
+                                   std::shared_ptr<const Medium>,
+                                   const EnergyCutSettings&,
+                                   double multiplier,
+                                   const ShadowEffect& shadow_effect);
+    PhotoAbramowiczLevinLevyMaor97(const PhotoAbramowiczLevinLevyMaor97&);
+    virtual ~PhotoAbramowiczLevinLevyMaor97();
+
+    virtual Parametrization* clone() const { return new PhotoAbramowiczLevinLevyMaor97(*this); }
+    static Photonuclear* create(const ParticleDef& particle_def,
+                                std::shared_ptr<const Medium> medium,
+                                const EnergyCutSettings& cuts,
+                                double multiplier,
+                                const ShadowEffect& shadow_effect)
+    {
+        return new PhotoAbramowiczLevinLevyMaor97(particle_def, medium, cuts, multiplier, shadow_effect);
+    }
+
+    double FunctionToQ2Integral(double energy, double v, double Q2);
+    void FunctionToQ2Integral(double energy, double v, const double* Q2, double* out, size_t n);
+
+    const std::string& GetName() const { return name_; }
+
+protected:
+    static const std::string name_;
+};
+
 /******************************************************************************
  *                    Declare Interpolant Parametrizations                    *
  ******************************************************************************/
@@ -154,6 +199,9 @@ public:
 
     double DifferentialCrossSection(double energy, double v);
 
+    // the interpolated cross section is cheap, the v integral stays one-dimensional
+    bool IntegrateDifferentialCrossSection(double, double, double, int, double&) { return false; }
+
 protected:
     virtual bool compare(const Parametrization&) const;
     double FunctionToBuildPhotoInterpolant(double energy, double v, int component);
@@ -0,0 +1,115 @@
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "PROPOSAL/math/Vector3D.h"
+
+namespace PROPOSAL {
+
+class Geometry;
+
+/**
+ * Bounding volume hierarchy over the axis aligned bounding boxes of a list
+ * of geometries or of other objects.
+ *
+ * The queries return the indices of all geometries whose box can contain a
+ * position or can be crossed by a ray, so only these have to be tested
+ * exactly. Nodes are split at the median of the box centres along the
+ * widest axis. Boxes with a common centre (e.g. the shells of a layered
+ * earth) are split by their size instead, so nested shells still end up
+ * in different subtrees.
+ */
+class BoundingVolumeHierarchy
+{
+public:
+    BoundingVolumeHierarchy();
+    BoundingVolumeHierarchy(const std::vector<std::shared_ptr<const Geometry>>& geometries);
+    // boxes given by (lower corner, upper corner), e.g. of the triangles of a mesh
+    BoundingVolumeHierarchy(const std::vector<std::pair<Vector3D, Vector3D>>& boxes);
+
+    // ----------------------------------------------------------------------------
+    /// @brief Geometries whose bounding box contains the position
+    ///
+    /// @param position
+    /// @param candidates indices of the geometries in ascending order
+    // ----------------------------------------------------------------------------
+    void FindCandidates(const Vector3D& position, std::vector<unsigned int>& candidates) const;
+
+    // ----------------------------------------------------------------------------
+    /// @brief Geometries whose bounding box the ray enters before max_distance
+    ///
+    /// Geometries that are not returned have no intersection with the ray
+    /// closer than max_distance.
+    ///
+    /// @param position start of the ray
+    /// @param direction direction of the ray
+    /// @param max_distance
+    /// @param candidates indices of the geometries in ascending order
+    // ----------------------------------------------------------------------------
+    void FindCandidates(const Vector3D& position,
+                        const Vector3D& direction,
+                        double max_distance,
+                        std::vector<unsigned int>& candidates) const;
+
+    unsigned int GetNumberOfNodes() const { return nodes_.size(); }
+
+private:
+    struct Box
+    {
+        double lower[3];
+        double upper[3];
+
+        void Extend(const Box& box);
+        bool Contains(const double* position) const;
+        // distance along the ray to the entry of the box, infinity if missed
+        double Entry(const double* position, const double* direction) const;
+    };
+
+    struct Node
+    {
+        Box box;
+        unsigned int first; // first index in indices_ for leaves, second child otherwise
+        unsigned int count; // number of geometries for leaves, 0 otherwise
+    };
+
+    void Init(const std::vector<std::pair<Vector3D, Vector3D>>& boxes);
+    unsigned int Build(unsigned int begin, unsigned int end);
+
+    static const unsigned int max_leaf_size = 4;
+
+    std::vector<Box> boxes_;
+    std::vector<unsigned int> indices_;
+    std::vector<Node> nodes_; // depth first, the first child follows its parent
+};
+
+} // namespace PROPOSAL
@@ -53,6 +53,16 @@ public:
 
     // Methods
     std::pair<double, double> DistanceToBorder(const Vector3D& position, const Vector3D& direction) const override;
+    void BatchDistanceToBorder(const double* x,
+                               const double* y,
+                               const double* z,
+                               const double* dir_x,
+                               const double* dir_y,
+                               const double* dir_z,
+                               double* first,
+                               double* second,
+                               size_t n) const override;
+    std::pair<Vector3D, Vector3D> GetBoundingBox() const override;
 
     // Getter & Setter
     double GetX() const { return x_; }
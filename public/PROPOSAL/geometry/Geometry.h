@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -91,11 +92,33 @@ public:
      */
     virtual std::pair<double, double> DistanceToBorder(const Vector3D& position, const Vector3D& direction) const = 0;
 
+    /*!
+     * DistanceToBorder for n rays in structure of arrays layout.
+     * The positions are given by x, y, z and the directions by dir_x, dir_y, dir_z,
+     * the two distances are written to first and second.
+     * The default loops over DistanceToBorder, the geometries override it
+     * with branch free loops, which can be vectorized by the compiler.
+     */
+    virtual void BatchDistanceToBorder(const double* x,
+                                       const double* y,
+                                       const double* z,
+                                       const double* dir_x,
+                                       const double* dir_y,
+                                       const double* dir_z,
+                                       double* first,
+                                       double* second,
+                                       size_t n) const;
+
     /*!
      * Calculates the distance to the closest approch to the geometry center
      */
     double DistanceToClosestApproach(const Vector3D& position, const Vector3D& direction) const;
 
+    /*!
+     * Axis aligned box (lower corner, upper corner) enclosing the geometry
+     */
+    virtual std::pair<Vector3D, Vector3D> GetBoundingBox() const = 0;
+
     // void swap(Geometry &geometry);
 
     // ----------------------------------------------------------------- //
@@ -121,16 +144,16 @@ protected:
 
     Vector3D position_; //!< x,y,z-coordinate of origin ( center of box, cylinder, sphere)
 
-    std::string name_; //!< "box" , "cylinder" , "sphere" (sphere and cylinder might be hollow)
+    std::string name_; //!< "box" , "cylinder" , "sphere", "mesh" (sphere and cylinder might be hollow)
 
     unsigned int hierarchy_; //!< adds a hierarchy of geometry objects to allow crossing geometries
 };
 } // namespace PROPOSAL
 
 namespace PROPOSAL {
-    enum Geometry_Type : int { SPHERE, BOX, CYLINDER };
+    enum Geometry_Type : int { SPHERE, BOX, CYLINDER, MESH };
 } // namespace PROPOSAL
 
 namespace PROPOSAL {
-    const std::array<std::string, 3>  Geometry_Name = { "sphere", "box", "cylinder" };
+    const std::array<std::string, 4>  Geometry_Name = { "sphere", "box", "cylinder", "mesh" };
 } // namespace PROPOSAL
@@ -36,12 +36,14 @@
 #include "PROPOSAL/geometry/Sphere.h"
 #include "PROPOSAL/geometry/Box.h"
 #include "PROPOSAL/geometry/Cylinder.h"
+#include "PROPOSAL/geometry/Mesh.h"
 
 namespace PROPOSAL {
 static std::map<const Geometry_Type, std::shared_ptr<Geometry>> Geometry_Map{
     { Geometry_Type::SPHERE, std::shared_ptr<Geometry>(new Sphere) },
     { Geometry_Type::BOX, std::shared_ptr<Geometry>(new Box) },
     { Geometry_Type::CYLINDER, std::shared_ptr<Geometry>(new Cylinder) },
+    { Geometry_Type::MESH, std::shared_ptr<Geometry>(new Mesh) },
 };
 } // namespace PROPOSAL
 
@@ -0,0 +1,100 @@
+
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "PROPOSAL/geometry/BoundingVolumeHierarchy.h"
+#include "PROPOSAL/geometry/Geometry.h"
+#include "PROPOSAL/json.hpp"
+
+namespace PROPOSAL {
+
+/**
+ * Closed triangle mesh, e.g. of a cavern or of the topography above a
+ * detector.
+ *
+ * The vertices are given relative to the position of the geometry. The
+ * borders along a trajectory are the intersections with the triangles,
+ * which are found with a bounding volume hierarchy. Whether the particle is
+ * inside follows from the number of borders in front of it, so the mesh
+ * has to be closed. The triangles are oriented consistently on
+ * construction, so that a trajectory through an edge or a vertex is counted
+ * once and a trajectory only touching the surface is not counted.
+ */
+class Mesh : public Geometry
+{
+public:
+    Mesh();
+    Mesh(const Vector3D position,
+         const std::vector<Vector3D>& vertices,
+         const std::vector<std::array<unsigned int, 3>>& triangles);
+    Mesh(const Vector3D position, const std::string& path);
+    Mesh(const Mesh&);
+    Mesh(const nlohmann::json& config);
+
+    std::shared_ptr<const Geometry> create() const override { return std::shared_ptr<const Geometry>( new Mesh(*this) ); };
+    void swap(Geometry&) override;
+
+    virtual ~Mesh() {}
+
+    // Operators
+    Mesh& operator=(const Geometry&) override;
+
+    // Methods
+    std::pair<double, double> DistanceToBorder(const Vector3D& position, const Vector3D& direction) const override;
+    std::pair<Vector3D, Vector3D> GetBoundingBox() const override;
+
+    // Getter
+    unsigned int GetNumberOfTriangles() const { return triangles_.size(); }
+
+private:
+    // vertex and the two edges starting from it, in cm relative to the position
+    struct Triangle
+    {
+        double vertex[3];
+        double edge_1[3];
+        double edge_2[3];
+    };
+
+    void Init(const std::vector<Vector3D>& vertices, const std::vector<std::array<unsigned int, 3>>& triangles);
+    void ReadObj(const std::string& path, std::vector<Vector3D>& vertices, std::vector<std::array<unsigned int, 3>>& triangles) const;
+    void ReadStl(const std::string& path, std::vector<Vector3D>& vertices, std::vector<std::array<unsigned int, 3>>& triangles) const;
+    void Read(const std::string& path);
+
+    bool compare(const Geometry&) const override;
+    void print(std::ostream&) const override;
+
+    std::vector<Triangle> triangles_;
+    BoundingVolumeHierarchy hierarchy_;
+};
+
+} // namespace PROPOSAL
@@ -0,0 +1,115 @@
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "PROPOSAL/geometry/BoundingVolumeHierarchy.h"
+#include "PROPOSAL/geometry/Geometry.h"
+#include "PROPOSAL/math/Vector3D.h"
+
+namespace PROPOSAL {
+
+/**
+ * Border crossings of a list of geometries along a straight track.
+ *
+ * The ray is cast once against all geometries and the crossings are stored
+ * as distances from the start of the ray. As long as the particle moves
+ * along the same ray, the distances to the borders, the locations and the
+ * distances to the closest approach follow from the position on the ray.
+ * Only geometries whose border has been reached are evaluated again.
+ * The ray is cast again if the direction changes or the particle leaves
+ * the ray.
+ */
+class TraversalPlan
+{
+public:
+    TraversalPlan();
+    TraversalPlan(const std::vector<std::shared_ptr<const Geometry>>& geometries);
+
+    // ----------------------------------------------------------------------------
+    /// @brief Move the particle to the position
+    ///
+    /// The ray is cast again if the particle is not on the current ray any
+    /// more or moved backwards.
+    ///
+    /// @param position
+    /// @param direction
+    // ----------------------------------------------------------------------------
+    void Update(const Vector3D& position, const Vector3D& direction);
+
+    // ----------------------------------------------------------------------------
+    /// @brief Same as Geometry::DistanceToBorder at the current position
+    // ----------------------------------------------------------------------------
+    std::pair<double, double> DistanceToBorder(unsigned int index) const;
+
+    bool IsInside(unsigned int index) const;
+    Geometry::ParticleLocation::Enum GetLocation(unsigned int index) const;
+    double DistanceToClosestApproach(unsigned int index) const;
+
+    // ----------------------------------------------------------------------------
+    /// @brief Geometries with a border ahead of the particle
+    ///
+    /// @return indices of the geometries sorted by the distance to their next border
+    // ----------------------------------------------------------------------------
+    const std::vector<unsigned int>& GetUpcomingBorders() const { return order_; }
+
+    unsigned int GetNumberOfCasts() const { return number_of_casts_; }
+
+private:
+    // distances along the ray from its origin, -1 for no crossing
+    struct Crossing
+    {
+        double first;
+        double second;
+        double closest_approach;
+    };
+
+    void Cast(const Vector3D& position, const Vector3D& direction);
+    void Evaluate(unsigned int index, const Vector3D& position, const Vector3D& direction);
+    void Insert(unsigned int index);
+
+    std::vector<std::shared_ptr<const Geometry>> geometries_;
+    BoundingVolumeHierarchy hierarchy_;
+
+    bool is_cast_;
+    Vector3D origin_;
+    Vector3D direction_;
+    double distance_; //!< position of the particle on the ray
+
+    std::vector<Crossing> crossings_;
+    std::vector<unsigned int> order_;
+    std::vector<unsigned int> buffer_;
+
+    unsigned int number_of_casts_;
+};
+
+} // namespace PROPOSAL
@@ -0,0 +1,108 @@
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace PROPOSAL {
+
+/**
+ * Adaptive cubature of a function over a rectangle [x_min, x_max] x [y_min, y_max].
+ *
+ * Every region is integrated with the degree 7 rule of Genz and Malik
+ * (J. Comput. Appl. Math. 6 (1980) 295) and its embedded degree 5 rule as
+ * error estimate. The region with the largest error is bisected along the
+ * axis with the larger fourth difference until the summed error is below the
+ * relative precision, so both variables share one error control.
+ *
+ * The 17 points of the rule lie on 7 lines of constant x. The integrand is
+ * called once per line, integrand(double x, const double* y, double* out, size_t n)
+ * has to set out[i] = f(x, y[i]) for n <= max_points_per_line points. Work that
+ * only depends on x (e.g. integration limits of an inner variable) is thus
+ * done once for all points of a line.
+ */
+class Cubature
+{
+public:
+    static const size_t max_points_per_line = 5;
+
+    Cubature();
+    Cubature(double precision, unsigned int max_regions);
+
+    bool operator==(const Cubature& cubature) const;
+    bool operator!=(const Cubature& cubature) const;
+
+    template <typename LineIntegrand>
+    double Integrate(double x_min, double x_max, double y_min, double y_max, LineIntegrand integrand)
+    {
+        callable_ = &integrand;
+        call_     = &Call<LineIntegrand>;
+
+        double result = IntegrateRectangle(x_min, x_max, y_min, y_max);
+
+        callable_ = nullptr;
+        call_     = nullptr;
+
+        return result;
+    }
+
+private:
+    struct Region
+    {
+        double center[2];
+        double half_width[2];
+        double value;
+        double error;
+        int split_axis;
+
+        // ordered by the error estimate, so the heap yields the worst region
+        bool operator<(const Region& region) const { return error < region.error; }
+    };
+
+    template <typename LineIntegrand>
+    static void Call(void* callable, double x, const double* y, double* out, size_t n)
+    {
+        (*static_cast<LineIntegrand*>(callable))(x, y, out, n);
+    }
+
+    double IntegrateRectangle(double x_min, double x_max, double y_min, double y_max);
+
+    // applies the Genz-Malik rule and sets value, error and split_axis
+    void GenzMalik(Region& region);
+
+    double precision_;
+    unsigned int max_regions_;
+
+    void* callable_;
+    void (*call_)(void*, double, const double*, double*, size_t);
+
+    std::vector<Region> workspace_; // reused between calls
+};
+
+} // namespace PROPOSAL
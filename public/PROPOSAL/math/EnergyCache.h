@@ -0,0 +1,166 @@
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <list>
+#include <map>
+#include <utility>
+
+namespace PROPOSAL {
+
+/**
+ * Bounded least recently used cache of values depending on an energy.
+ *
+ * Used in integral mode to memoize integrals for energies which recur during
+ * the propagation (e.g. the lower particle energy or the sector borders).
+ * A stored value is returned for every energy whose relative distance to
+ * the stored energy is at most the tolerance, a tolerance of 0 requires the
+ * exact energy. With a capacity of 0 nothing is stored.
+ *
+ * A copy has the same settings but starts empty. The cache is not thread safe.
+ */
+template <typename T>
+class EnergyCache
+{
+public:
+    EnergyCache()
+        : capacity_(0)
+        , tolerance_(0)
+        , entries_()
+        , index_()
+    {
+    }
+
+    EnergyCache(size_t capacity, double tolerance)
+        : capacity_(capacity)
+        , tolerance_(tolerance)
+        , entries_()
+        , index_()
+    {
+    }
+
+    EnergyCache(const EnergyCache& cache)
+        : capacity_(cache.capacity_)
+        , tolerance_(cache.tolerance_)
+        , entries_()
+        , index_()
+    {
+    }
+
+    EnergyCache& operator=(const EnergyCache& cache)
+    {
+        if (this != &cache)
+        {
+            capacity_  = cache.capacity_;
+            tolerance_ = cache.tolerance_;
+            Clear();
+        }
+        return *this;
+    }
+
+    bool IsEnabled() const { return capacity_ > 0; }
+    size_t GetCapacity() const { return capacity_; }
+    double GetTolerance() const { return tolerance_; }
+    size_t GetSize() const { return index_.size(); }
+
+    // returns the stored value or nullptr, a found entry becomes the most recently used
+    const T* Find(double energy)
+    {
+        if (index_.empty())
+        {
+            return nullptr;
+        }
+
+        double delta = tolerance_ * std::abs(energy);
+
+        typename Index::iterator it = index_.lower_bound(energy - delta);
+        if (it == index_.end() || it->first > energy + delta)
+        {
+            return nullptr;
+        }
+
+        // the closer of the two stored energies around the requested one
+        typename Index::iterator next = it;
+        ++next;
+        if (next != index_.end() && next->first <= energy + delta &&
+            std::abs(next->first - energy) < std::abs(it->first - energy))
+        {
+            it = next;
+        }
+
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return &it->second->second;
+    }
+
+    // stores the value, the least recently used entry is dropped if the cache is full
+    void Insert(double energy, const T& value)
+    {
+        if (capacity_ == 0)
+        {
+            return;
+        }
+
+        typename Index::iterator it = index_.find(energy);
+        if (it != index_.end())
+        {
+            it->second->second = value;
+            entries_.splice(entries_.begin(), entries_, it->second);
+            return;
+        }
+
+        if (index_.size() >= capacity_)
+        {
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+
+        entries_.push_front(std::make_pair(energy, value));
+        index_[energy] = entries_.begin();
+    }
+
+    void Clear()
+    {
+        entries_.clear();
+        index_.clear();
+    }
+
+private:
+    typedef std::list<std::pair<double, T> > Entries;
+    typedef std::map<double, typename Entries::iterator> Index;
+
+    size_t capacity_;
+    double tolerance_;
+
+    Entries entries_; // most recently used first
+    Index index_;
+};
+
+} // namespace PROPOSAL
@@ -0,0 +1,166 @@
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace PROPOSAL {
+
+/**
+ * Inline exp and log for the hot paths of the interpolation.
+ *
+ * The core of both is made of multiplications, additions and table
+ * lookups. exp clamps its argument to the finite range with conditional
+ * selects. log scales subnormal inputs into the normal range with a
+ * conditional select before the table lookup and returns the results for
+ * zero, negative, infinite and NaN inputs in explicit branches after it.
+ * These branches are well predicted for the positive finite arguments of
+ * the batched versions. Over the whole double range the
+ * results differ from std::exp and std::log by at most 1 ulp, see
+ * tests/FastMath_TEST.cxx.
+ *
+ * exp reduces x = (64 k + j) ln2 / 64 + r with |r| <= ln2 / 128 and
+ * evaluates 2^k 2^(j/64) exp(r) with a table of 2^(j/64) and a degree 5
+ * polynomial. log splits x = 2^k m with 1 <= m < 2, m = c (1 + u) with the
+ * nearest c = 1 + j/64, and evaluates k ln2 + log(c) + log(1 + u) with a
+ * table of log(c) and a degree 8 polynomial. The node c = 1 keeps the
+ * relative accuracy for x close to 1.
+ */
+
+namespace fastmath {
+
+// 2^(j/64) for j = 0, ..., 63, correctly rounded
+extern const double exp_table[64];
+
+// 1 / c, log(c) in a high and a low part for c = 1 + j/64, j = 0, ..., 64
+extern const double log_table[65][3];
+
+inline uint64_t AsBits(double x)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof bits);
+    return bits;
+}
+
+inline double AsDouble(uint64_t bits)
+{
+    double x;
+    std::memcpy(&x, &bits, sizeof x);
+    return x;
+}
+
+} // namespace fastmath
+
+inline double fastExp(double x)
+{
+    const double inv_ln2_64  = 92.33248261689366;
+    const double ln2_64_hi   = 0.010830424696905538; // 33 bits, so kd * ln2_64_hi is exact
+    const double ln2_64_lo   = -6.563929801064195e-13;
+    const double shift       = 6755399441055744.; // 1.5 * 2^52, rounds to integer
+    const double upper_limit = 710.;              // exp overflows above 709.78
+    const double lower_limit = -746.;             // exp underflows below -745.13
+
+    // NaN passes the limits
+    double xc = x > upper_limit ? upper_limit : (x < lower_limit ? lower_limit : x);
+
+    double kd = xc * inv_ln2_64 + shift;
+    int64_t ki = static_cast<int64_t>(fastmath::AsBits(kd) - fastmath::AsBits(shift));
+    kd -= shift;
+
+    double r = (xc - kd * ln2_64_hi) - kd * ln2_64_lo;
+
+    // exp(r) - 1
+    double p = r + r * r * (1. / 2 + r * (1. / 6 + r * (1. / 24 + r * (1. / 120))));
+
+    double t = fastmath::exp_table[ki & 63];
+
+    // 2^k in two factors, so results in the subnormal range do not need a
+    // special case
+    int64_t k  = ki >> 6;
+    int64_t k1 = k >> 1;
+    int64_t k2 = k - k1;
+
+    double scale1 = fastmath::AsDouble(static_cast<uint64_t>(k1 + 1023) << 52);
+    double scale2 = fastmath::AsDouble(static_cast<uint64_t>(k2 + 1023) << 52);
+
+    return (t + t * p) * scale1 * scale2;
+}
+
+inline double fastLog(double x)
+{
+    const double ln2_hi = 0.6931471803691238; // trailing zeros, so k * ln2_hi is exact
+    const double ln2_lo = 1.9082149292705877e-10;
+    const double shift  = 6755399441055744.; // 1.5 * 2^52, rounds to integer
+
+    // subnormal numbers are scaled into the normal range first
+    bool subnormal = x < std::numeric_limits<double>::min();
+    double xs      = subnormal ? x * 18014398509481984. : x; // 2^54
+
+    // x = 2^k m with m in [1, 2), k is converted with the exponent bits of
+    // 2^52 + k to avoid the slow integer conversion
+    uint64_t bits = fastmath::AsBits(xs);
+    double m      = fastmath::AsDouble((bits & UINT64_C(0x000fffffffffffff)) | UINT64_C(0x3ff0000000000000));
+    double dk     = fastmath::AsDouble((bits >> 52) | UINT64_C(0x4330000000000000)) - (4503599627370496. + 1023);
+    dk -= subnormal ? 54 : 0;
+
+    // m = c (1 + u) with c = 1 + j / 64 the nearest node, m - c is exact
+    double jd       = (m - 1) * 64 + shift;
+    const double* c = fastmath::log_table[fastmath::AsBits(jd) - fastmath::AsBits(shift)];
+    double u        = (m - (1 + (jd - shift) * (1. / 64))) * c[0];
+
+    // log(1 + u) - u for |u| <= 1/128
+    double u2 = u * u;
+    double p  = u2 * ((-1. / 2 + u * (1. / 3)) + u2 * ((-1. / 4 + u * (1. / 5)) + u2 * (-1. / 6 + u * (1. / 7) - u2 * (1. / 8))));
+
+    double result = (dk * ln2_hi + c[1]) + (u + (p + (dk * ln2_lo + c[2])));
+
+    if (x > 0 && x < std::numeric_limits<double>::infinity())
+    {
+        return result;
+    }
+
+    if (x == 0)
+    {
+        return -std::numeric_limits<double>::infinity();
+    }
+
+    // inf stays inf, negative numbers and NaN give NaN
+    return x > 0 ? x : std::numeric_limits<double>::quiet_NaN();
+}
+
+// out[i] = exp(x[i]) for i < n
+void fastExp(const double* x, double* out, size_t n);
+
+// out[i] = log(x[i]) for i < n
+void fastLog(const double* x, double* out, size_t n);
+
+} // namespace PROPOSAL
@@ -29,8 +29,11 @@
 
 #pragma once
 
+#include <cstddef>
 #include <functional>
 #include <iostream>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 namespace PROPOSAL {
@@ -63,6 +66,25 @@ class Integral
 {
 
 public:
+    /**
+     * Quadrature rule used by Integrate. Romberg is the classical scheme
+     * described above. GaussKronrod integrates the substituted integrand with
+     * the fixed 7-point Gauss-Legendre / 15-point Kronrod pair, bisecting the
+     * interval with the largest error estimate until the precision is reached.
+     * Cubature behaves like GaussKronrod here; it tells the cross sections
+     * whose differential cross section is itself an integral to integrate
+     * both variables at once with the adaptive 2D Cubature.
+     * The sampling of x(rand) (IntegrateWithRandomRatio) always uses Romberg.
+     */
+    enum Quadrature
+    {
+        Romberg = 0,
+        GaussKronrod,
+        Cubature
+    };
+
+    static Quadrature GetQuadratureFromString(const std::string&);
+
     /**
      * initializes class with default settings
      */
@@ -106,6 +128,10 @@ public:
      *   method = 4: IntegrateWithLog
      *   method = 5: IntegrateWithLogSubstitution
      *
+     * The integrand can be any callable double(double), e.g. a lambda. It is
+     * taken by value and only referenced during the integration, so no
+     * std::function has to be built for every call.
+     *
      * \param   min             lower integration limit
      * \param   max             upper integration limit
      * \param   function2use    integrand
@@ -113,11 +139,33 @@ public:
      * \return  Integration result
      */
 
-    double Integrate(double min,
-                     double max,
-                     std::function<double(double)> integrand,
-                     int method,
-                     double powerOfSubstitution = 0);
+    template <typename Integrand>
+    double Integrate(double min, double max, Integrand integrand, int method, double powerOfSubstitution = 0)
+    {
+        return IntegrateRef(min, max, IntegrandRef(integrand), method, powerOfSubstitution);
+    }
+
+    //----------------------------------------------------------------------------//
+
+    /*!
+     * like Integrate, but the integrand is evaluated at several points at once:
+     * integrand(const double* x, double* out, size_t n) has to set out[i] = f(x[i]).
+     * The quadrature rules pass all abscissae of a refinement step (in blocks of
+     * batch_size) in one call.
+     */
+
+    template <typename BatchIntegrand>
+    double IntegrateBatch(double min,
+                          double max,
+                          BatchIntegrand integrand,
+                          int method,
+                          double powerOfSubstitution = 0)
+    {
+        return IntegrateRef(min, max, IntegrandRef(integrand, IntegrandRef::Batch()), method, powerOfSubstitution);
+    }
+
+    // maximum number of points passed to a batch integrand at once
+    static const size_t batch_size = 32;
 
     //----------------------------------------------------------------------------//
 
@@ -167,6 +215,7 @@ public:
     bool GetRandomDo() const { return randomDo_; }
     bool GetReverse() const { return reverse_; }
     bool GetUseLog() const { return useLog_; }
+    Quadrature GetQuadrature() const { return quadrature_; }
 
     // --------------------------------------------------------------------- //
     // Setter
@@ -176,7 +225,8 @@ public:
     {
         std::cerr << "Integral::set_funtion2use is depricated and might even be buggy. \n better make use of "
                      "Integral::integrateOpened(...) to set the function to use, and its range...\n";
-        this->integrand_ = integrand;
+        this->integrand_     = integrand;
+        this->integrand_ref_ = IntegrandRef(integrand_);
     }
     void SetIntegrand(std::function<double(double)> integrand);
     void SetMax(double max);
@@ -194,14 +244,103 @@ public:
     void SetRomberg4refine(int romberg4refine);
     void SetSavedResult(double savedResult);
     void SetUseLog(bool useLog);
+    void SetQuadrature(Quadrature quadrature);
 
 private:
+    /*!
+     * Non-owning reference to an integrand of arbitrary type. The call is
+     * forwarded through a plain function pointer to the concrete callable,
+     * which the compiler can inline there. The referenced callable has to
+     * outlive the integration. Scalar and batch integrands can both be
+     * evaluated pointwise or for a whole block of points.
+     */
+    class IntegrandRef
+    {
+    public:
+        struct Batch
+        {
+        };
+
+        IntegrandRef()
+            : callable_(nullptr)
+            , call_(nullptr)
+            , call_batch_(nullptr)
+        {
+        }
+
+        template <typename Integrand,
+                  typename = typename std::enable_if<
+                      !std::is_same<typename std::decay<Integrand>::type, IntegrandRef>::value>::type>
+        IntegrandRef(Integrand& integrand)
+            : callable_(const_cast<void*>(static_cast<const void*>(&integrand)))
+            , call_(&Call<Integrand>)
+            , call_batch_(&CallEach<Integrand>)
+        {
+        }
+
+        template <typename BatchIntegrand>
+        IntegrandRef(BatchIntegrand& integrand, Batch)
+            : callable_(const_cast<void*>(static_cast<const void*>(&integrand)))
+            , call_(&CallSingle<BatchIntegrand>)
+            , call_batch_(&CallBatch<BatchIntegrand>)
+        {
+        }
+
+        double operator()(double x) const { return call_(callable_, x); }
+        void operator()(const double* x, double* out, size_t n) const { call_batch_(callable_, x, out, n); }
+
+    private:
+        template <typename Integrand>
+        static double Call(void* callable, double x)
+        {
+            return (*static_cast<Integrand*>(callable))(x);
+        }
+
+        template <typename Integrand>
+        static void CallEach(void* callable, const double* x, double* out, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                out[i] = (*static_cast<Integrand*>(callable))(x[i]);
+            }
+        }
+
+        template <typename BatchIntegrand>
+        static double CallSingle(void* callable, double x)
+        {
+            double out;
+            (*static_cast<BatchIntegrand*>(callable))(&x, &out, 1);
+            return out;
+        }
+
+        template <typename BatchIntegrand>
+        static void CallBatch(void* callable, const double* x, double* out, size_t n)
+        {
+            (*static_cast<BatchIntegrand*>(callable))(x, out, n);
+        }
+
+        void* callable_;
+        double (*call_)(void*, double);
+        void (*call_batch_)(void*, const double*, double*, size_t);
+    };
+
     struct InterpolationResults
     {
         double Value;
         double Error;
     };
 
+    struct GaussKronrodInterval
+    {
+        double min;
+        double max;
+        double value;
+        double error;
+
+        // ordered by the error estimate, so the heap yields the worst interval
+        bool operator<(const GaussKronrodInterval& interval) const { return error < interval.error; }
+    };
+
     struct QuadpackResults
     {
         QuadpackResults()
@@ -232,6 +371,7 @@ private:
     std::vector<double> d_;
 
     std::function<double(double)> integrand_;
+    IntegrandRef integrand_ref_;
 
     int romberg4refine_; // set to 2 in constructor
     double powerOfSubstitution_;
@@ -247,6 +387,25 @@ private:
     std::vector<double> q_rlist2_; // epstab
     std::vector<double> q_iord_;
 
+    Quadrature quadrature_;
+    std::vector<GaussKronrodInterval> gk_workspace_; // reused between calls
+
+    // ----------------------------------------------------------------------------
+    /// @brief Applies the fixed 7-point Gauss / 15-point Kronrod rule on
+    ///        [q_min, q_max] to the substituted integrand.
+    ///
+    /// @return Kronrod estimate and |K15 - G7| as error estimate, without
+    ///         the (200 err / resasc)^1.5 rescaling of QUADPACK, bounded
+    ///         from below by the rounding error
+    // ----------------------------------------------------------------------------
+    Integral::InterpolationResults GaussKronrod15(double q_min, double q_max);
+
+    // ----------------------------------------------------------------------------
+    /// @brief Globally adaptive Gauss-Kronrod integration of the substituted
+    ///        integrand between min_ and max_.
+    // ----------------------------------------------------------------------------
+    double AdaptiveGaussKronrod();
+
     // ----------------------------------------------------------------------------
     /// @brief This function is a translation of the fortran 77 subroutine
     ///        dqk21 from the package QUADPACK by Piessens et al. (1983),
@@ -381,6 +540,17 @@ private:
      */
     double Function(double x);
 
+    /*!
+     * Function evaluated at n <= batch_size points with a single call of the
+     * integrand.
+     */
+    void Function(const double* x, double* out, size_t n);
+
+    /*!
+     * adds Function(x[i]) for the n points in the given order to sum
+     */
+    void SumFunction(const double* x, size_t n, double& sum);
+
     //----------------------------------------------------------------------------//
 
     /*!
@@ -443,25 +613,29 @@ private:
 
     //----------------------------------------------------------------------------//
 
-    double InitIntegralOpenedAndClosed(double min, double max, std::function<double(double)> integrand);
+    double IntegrateRef(double min, double max, IntegrandRef integrand, int method, double powerOfSubstitution);
+
+    //----------------------------------------------------------------------------//
+
+    double InitIntegralOpenedAndClosed(double min, double max, IntegrandRef integrand);
 
     //----------------------------------------------------------------------------//
 
     double InitIntegralWithSubstitution(double min,
                                         double max,
-                                        std::function<double(double)> integrand,
+                                        IntegrandRef integrand,
                                         double powerOfSubstitution);
 
     //----------------------------------------------------------------------------//
 
     double InitIntegralWithLogSubstitution(double min,
                                            double max,
-                                           std::function<double(double)> integrand,
+                                           IntegrandRef integrand,
                                            double powerOfSubstitution);
 
     //----------------------------------------------------------------------------//
 
-    double InitIntegralWithLog(double min, double max, std::function<double(double)> integrand);
+    double InitIntegralWithLog(double min, double max, IntegrandRef integrand);
 
     //----------------------------------------------------------------------------//
 
@@ -476,7 +650,7 @@ private:
      * \param   function2use    integrand
      * \return  Integration result
      */
-    double IntegrateClosed(double min, double max, std::function<double(double)> integrand);
+    double IntegrateClosed(double min, double max, IntegrandRef integrand);
 
     //----------------------------------------------------------------------------//
 
@@ -489,7 +663,7 @@ private:
      * \param   function2use    integrand
      * \return  Integration result
      */
-    double IntegrateOpened(double min, double max, std::function<double(double)> integrand);
+    double IntegrateOpened(double min, double max, IntegrandRef integrand);
 
     //----------------------------------------------------------------------------//
 
@@ -505,7 +679,7 @@ private:
 
     double IntegrateWithSubstitution(double min,
                                      double max,
-                                     std::function<double(double)> integrand,
+                                     IntegrandRef integrand,
                                      double powerOfSubstitution);
 
     //----------------------------------------------------------------------------//
@@ -519,7 +693,7 @@ private:
      * \return  Integration result
      */
 
-    double IntegrateWithLog(double min, double max, std::function<double(double)> integrand);
+    double IntegrateWithLog(double min, double max, IntegrandRef integrand);
 
     //----------------------------------------------------------------------------//
 
@@ -535,7 +709,7 @@ private:
 
     double IntegrateWithLogSubstitution(double min,
                                         double max,
-                                        std::function<double(double)> integrand,
+                                        IntegrandRef integrand,
                                         double powerOfSubstitution);
 
     //----------------------------------------------------------------------------//
@@ -94,6 +94,28 @@ private:
 
     double x_save_, y_save_; // Is setted to 1 and 0 in constructor
 
+    // Index of the last node below every bucket of width 1/lookup_scale_,
+    // only filled for grids which are not equidistant
+    std::vector<int> lookup_;
+    double lookup_scale_;
+
+    // Flat layout of compacted 2d tables: the row interpolant holds the grid
+    // and settings shared by all rows, the values of the rows are stored one
+    // after another in double or single precision.
+    Interpolant* flat_row_;
+    std::vector<double> flat_values_;
+    std::vector<float> flat_values_float_;
+    double storage_precision_, storage_error_;
+
+    // values of the row the flat row interpolant currently describes
+    const double* values_;
+    const float* values_float_;
+
+    // Neville kernels for the order of the interpolation and of the inverse
+    // interpolation, chosen when the table is set up
+    typedef double (Interpolant::*NevilleKernel)(double x, int start, int num, bool dd, bool doLog, double& error);
+    NevilleKernel neville_, nevilleY_;
+
     //----------------------------------------------------------------------------//
     // Memberfunctions
 
@@ -108,6 +130,25 @@ private:
 
     //----------------------------------------------------------------------------//
 
+    /*!
+     * Neville's algorithm on the nodes start, ..., start + romberg - 1.
+     *
+     * The orders 3, 4 and 5 are instantiated with N fixed, so their loops are
+     * unrolled. N = 0 takes the order from romberg_.
+     *
+     * \param   num      node the reconstruction starts from
+     * \param   dd       direction of the first step
+     * \param   doLog    interpolate exp of the stored values
+     * \param   error    last correction, the error estimate
+     */
+    template <int N, bool Rational>
+    double Neville(double x, int start, int num, bool dd, bool doLog, double& error);
+
+    // sets neville_ and nevilleY_ from the orders and rational flags
+    void InitNeville();
+
+    //----------------------------------------------------------------------------//
+
     /**
      * Exp(x) with CutOff.
      *
@@ -194,6 +235,80 @@ private:
 
     //----------------------------------------------------------------------------//
 
+    /**
+     * Position of x in units of the node spacing.
+     *
+     * The nodes lie at half integer positions, so the integer part is the
+     * index of the nearest node. Non-uniform grids use the lookup table and
+     * interpolate linearly between the neighbouring nodes.
+     *
+     * \param    x   (log substituted) x
+     * \return   position on the grid
+     */
+
+    double GridPosition(double x);
+
+    //----------------------------------------------------------------------------//
+
+    /**
+     * Builds the lookup table if the nodes in iX_ are not equidistant.
+     */
+
+    void InitLookup();
+
+    //----------------------------------------------------------------------------//
+
+    /**
+     * Uses the given nodes as grid of the interpolant.
+     *
+     * \param    x   nodes in ascending order
+     * \param    y   function values at the nodes
+     */
+
+    void SetGrid(const std::vector<double>& x, const std::vector<double>& y);
+
+    //----------------------------------------------------------------------------//
+
+    /**
+     * Function value at node i, read from the flat values for compacted
+     * tables and from iY_ otherwise.
+     */
+
+    double Value(int i) const
+    {
+        if (values_float_ != NULL)
+        {
+            return values_float_[i];
+        }
+        if (values_ != NULL)
+        {
+            return values_[i];
+        }
+        return iY_.at(i);
+    }
+
+    //----------------------------------------------------------------------------//
+
+    /**
+     * Interpolant of row i of a 2d table.
+     *
+     * For compacted tables this is the shared row interpolant, pointed to
+     * the values of row i.
+     */
+
+    Interpolant* Row(int i);
+
+    //----------------------------------------------------------------------------//
+
+    /**
+     * Stores the flat values in single precision if the rounding error stays
+     * within the storage precision.
+     */
+
+    void StoreFlatValues();
+
+    //----------------------------------------------------------------------------//
+
 public:
     Interpolant(const Interpolant&);
     Interpolant& operator=(const Interpolant&);
@@ -284,6 +399,65 @@ public:
 
     //----------------------------------------------------------------------------//
 
+    /*!
+     * Constructor for the 1-dimensional functions with adaptive nodes.
+     *
+     * Starts with a coarse equidistant grid between xmin and xmax and bisects
+     * the intervals whose midpoint is interpolated with a relative error
+     * above precision, compared to the function itself. The intervals with
+     * the largest errors are refined first, at most max nodes are used.
+     * Parameters as for the main constructor.
+     *
+     * \param   precision    relative error aimed for
+     */
+    Interpolant(int max,
+                double xmin,
+                double xmax,
+                std::function<double(double)> function1d,
+                int romberg,
+                bool rational,
+                bool relative,
+                bool isLog,
+                int rombergY,
+                bool rationalY,
+                bool relativeY,
+                bool logSubst,
+                double precision);
+
+    //----------------------------------------------------------------------------//
+
+    /*!
+     * Constructor for the 2-dimensional functions with adaptive nodes.
+     *
+     * The rows are refined along x2 like the nodes of the 1-dimensional
+     * constructor, every row has its own adaptive grid in x1 with up to
+     * max1 nodes. Parameters as for the main constructor.
+     *
+     * \param   precision    relative error aimed for
+     */
+    Interpolant(int max1,
+                double x1min,
+                double x1max,
+                int max2,
+                double x2min,
+                double x2max,
+                std::function<double(double, double)> function2d,
+                int romberg1,
+                bool rational1,
+                bool relative1,
+                bool isLog1,
+                int romberg2,
+                bool rational2,
+                bool relative2,
+                bool isLog2,
+                int rombergY,
+                bool rationalY,
+                bool relativeY,
+                bool logSubst,
+                double precision);
+
+    //----------------------------------------------------------------------------//
+
     /*!
      * Constructor for the 1-dimensional functions if the array already exists.
      *
@@ -416,6 +590,52 @@ public:
 
     //----------------------------------------------------------------------------//
 
+    /**
+     * Scales the tabulated function values.
+     *
+     * Afterwards the interpolant describes factor * f. Used to rescale
+     * normalized tables after they have been loaded.
+     *
+     * \param    factor   positive scale factor
+     */
+
+    void Scale(double factor);
+
+    //----------------------------------------------------------------------------//
+
+    /**
+     * Appends the nodes of an interpolant continuing the grid of this one.
+     *
+     * The extension has to start at the upper bound of this interpolant and
+     * must use the same spacing, as built by
+     * InterpolantBuilder::CreateExtensionBuilder. Non-uniform grids only
+     * need to continue above the last node. 2d interpolants are extended
+     * along x1.
+     *
+     * \param    extension   interpolant with the additional nodes
+     */
+
+    void Append(const Interpolant& extension);
+
+    //----------------------------------------------------------------------------//
+
+    /**
+     * Moves the rows of a 2d table into one contiguous array.
+     *
+     * All rows have to share their grid, which holds for equidistant tables.
+     * The values are stored in single precision if the relative error this
+     * introduces does not exceed precision, otherwise in double precision.
+     * Later scaling is checked against the same error budget. Compacted
+     * tables are saved in the usual format but can not be extended.
+     *
+     * \param    precision   relative error allowed for the stored values
+     * \return   true if the table has been compacted
+     */
+
+    bool Compact(double precision);
+
+    //----------------------------------------------------------------------------//
+
     void swap(Interpolant& interpolant);
 
     //----------------------------------------------------------------------------//
@@ -473,6 +693,12 @@ public:
 
     double GetStep() const { return step_; }
 
+    bool IsUniform() const { return lookup_.empty(); }
+
+    bool IsCompact() const { return flat_row_ != NULL; }
+
+    bool IsSinglePrecision() const { return !flat_values_float_.empty(); }
+
     bool GetRelative() const { return relative_; }
 
     bool GetRational() const { return rational_; }
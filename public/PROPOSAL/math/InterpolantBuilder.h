@@ -59,10 +59,23 @@ public:
     static const bool default_relativeY;
     static const bool default_logSubst;
 
+    static const double default_precision;
+
     InterpolantBuilder() {}
     virtual ~InterpolantBuilder() {}
 
     virtual Interpolant* build() = 0;
+
+    // Builder for the nodes continuing the grid above upper up to at least
+    // new_upper with the same spacing. The built interpolant can be appended
+    // to the one of this builder. Only logarithmic grids ending at upper can
+    // be extended, otherwise NULL is returned. The caller owns the builder.
+    virtual InterpolantBuilder* CreateExtensionBuilder(double upper, double new_upper) const
+    {
+        (void)upper;
+        (void)new_upper;
+        return NULL;
+    }
 };
 
 // ----------------------------------------------------------------------------
@@ -144,6 +157,14 @@ public:
         return *this;
     }
 
+    // Relative error the nodes are adapted to. Zero gives max equidistant
+    // nodes, otherwise max is the largest number of nodes.
+    Interpolant1DBuilder& SetPrecision(const double val)
+    {
+        precision = val;
+        return *this;
+    }
+
     // prepare specific frequently desired Product
     // returns Builder for shorthand inline usage (same way as cout <<)
     // Builder& setProductP(){
@@ -155,6 +176,7 @@ public:
     // }
 
     Interpolant* build();
+    InterpolantBuilder* CreateExtensionBuilder(double upper, double new_upper) const;
 
 private:
     Function1D function1d;
@@ -167,6 +189,8 @@ private:
 
     int rombergY;
     bool rationalY, relativeY, logSubst;
+
+    double precision;
 };
 
 // ----------------------------------------------------------------------------
@@ -286,6 +310,15 @@ public:
         return *this;
     }
 
+    // Relative error the nodes are adapted to. Zero gives equidistant nodes,
+    // otherwise max1 and max2 are the largest numbers of nodes. Adaptive
+    // tables can not be extended, since the rows depend on the x1 range.
+    Interpolant2DBuilder& SetPrecision(const double val)
+    {
+        precision = val;
+        return *this;
+    }
+
     // prepare specific frequently desired Product
     // returns Builder for shorthand inline usage (same way as cout <<)
     // Builder& setProductP(){
@@ -297,6 +330,7 @@ public:
     // }
 
     Interpolant* build();
+    InterpolantBuilder* CreateExtensionBuilder(double upper, double new_upper) const;
 
 private:
     Function2D function2d;
@@ -315,6 +349,8 @@ private:
 
     int rombergY;
     bool rationalY, relativeY, logSubst;
+
+    double precision;
 };
 
 // ----------------------------------------------------------------------------
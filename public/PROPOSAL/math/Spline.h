@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <fstream>
 #include <string>
 #include <utility>
@@ -65,6 +66,9 @@ class Spline {
 
     virtual bool save(std::string, bool);
     virtual double evaluate(double x);
+    // evaluates the spline at the n positions x, consecutive positions in
+    // the same subintervall skip the lookup
+    void BatchEvaluate(const double* x, double* result, size_t n);
     virtual void Derivative();
     virtual void Antiderivative(double c);
 
@@ -82,11 +86,21 @@ class Spline {
     virtual void calculate_splines(std::vector<double> x,
                                    std::vector<double> y) = 0;
 
+    // Index of the subintervall containing x. A uniform grid over the domain
+    // stores the first subintervall of every cell, so only the subintervalls
+    // inside one cell are searched, which is O(1) for near-uniform nodes.
+    unsigned int FindSubintervall(double x) const;
+    void BuildIndex();
+
     std::vector<Polynom> splines_;
     std::vector<double> subintervall_;
     unsigned int n_subintervalls_;
     std::vector<double> x_;
     std::vector<double> y_;
+
+    std::vector<unsigned int> grid_index_;
+    double grid_min_;
+    double grid_inverse_width_;
 };
 
 }  // namespace PROPOSAL
@@ -29,6 +29,7 @@
 #include <exception>
 #include <functional>
 #include <string>
+#include <vector>
 #include "PROPOSAL/math/Vector3D.h"
 
 namespace PROPOSAL {
@@ -97,6 +98,34 @@ class DensityException : public std::exception {
 };
 }  // namespace PROPOSAL
 
+namespace PROPOSAL {
+// Antiderivative of a density profile tabulated on the depth nodes of an
+// axis. Invert looks up the interval containing a given value of the
+// antiderivative and polishes the linear estimate with a few safeguarded
+// Newton steps, so no bracketing search over the whole track is needed.
+class DepthIntegral {
+   public:
+    DepthIntegral();
+    DepthIntegral(const std::vector<double>& depths,
+                  const std::function<double(double)>& antiderivative);
+
+    bool operator==(const DepthIntegral& depth_integral) const;
+    bool operator!=(const DepthIntegral& depth_integral) const;
+
+    // depth where the antiderivative reaches the value integral, NaN if
+    // it lies outside of the table
+    double Invert(double integral,
+                  const std::function<double(double)>& density,
+                  const std::function<double(double)>& antiderivative) const;
+
+    bool empty() const { return depths_.empty(); }
+
+   private:
+    std::vector<double> depths_;
+    std::vector<double> integrals_;
+};
+}  // namespace PROPOSAL
+
 namespace PROPOSAL {
 class Density_distr {
    public:
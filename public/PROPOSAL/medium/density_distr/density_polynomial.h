@@ -38,6 +38,9 @@ namespace PROPOSAL {
 class Density_polynomial : public Density_distr {
    public:
     Density_polynomial(const Axis&, const Polynom&);
+    // tabulates the integrated density between depth_min and depth_max to
+    // invert it without root finding
+    Density_polynomial(const Axis&, const Polynom&, double depth_min, double depth_max);
     Density_polynomial(const Density_polynomial&);
     ~Density_polynomial();
 
@@ -72,5 +75,7 @@ class Density_polynomial : public Density_distr {
 
     std::function<double(double)> density_distribution;
     std::function<double(double)> antiderived_density_distribution;
+
+    DepthIntegral depth_integral_;
 };
 }  // namespace PROPOSAL
@@ -80,5 +80,7 @@ class Density_splines : public Density_distr {
 
     std::function<double(double)> density_distribution;
     std::function<double(double)> antiderived_density_distribution;
+
+    DepthIntegral depth_integral_;
 };
 }  // namespace PROPOSAL
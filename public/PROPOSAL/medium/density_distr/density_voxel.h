@@ -0,0 +1,91 @@
+/******************************************************************************
+ *                                                                            *
+ * This file is part of the simulation tool PROPOSAL.                         *
+ *                                                                            *
+ * Copyright (C) 2017 TU Dortmund University, Department of Physics,          *
+ *                    Chair Experimental Physics 5b                           *
+ *                                                                            *
+ * This software may be modified and distributed under the terms of a         *
+ * modified GNU Lesser General Public Licence version 3 (LGPL),               *
+ * copied verbatim in the file "LICENSE".                                     *
+ *                                                                            *
+ * Modifcations to the LGPL License:                                          *
+ *                                                                            *
+ *      1. The user shall acknowledge the use of PROPOSAL by citing the       *
+ *         following reference:                                               *
+ *                                                                            *
+ *         J.H. Koehne et al.  Comput.Phys.Commun. 184 (2013) 2070-2090 DOI:  *
+ *         10.1016/j.cpc.2013.04.001                                          *
+ *                                                                            *
+ *      2. The user should report any bugs/errors or improvments to the       *
+ *         current maintainer of PROPOSAL or open an issue on the             *
+ *         GitHub webpage                                                     *
+ *                                                                            *
+ *         "https://github.com/tudo-astroparticlephysics/PROPOSAL"            *
+ *                                                                            *
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include "PROPOSAL/medium/density_distr/density_distr.h"
+
+namespace PROPOSAL {
+
+// Density correction factors on a regular grid of voxels. The grid starts at
+// the corner origin and holds voxel_number[0] x voxel_number[1] x
+// voxel_number[2] voxels with the edge lengths voxel_size (in cm). The
+// densities are stored with the x index running fastest. Outside of the grid
+// the density correction is given by outside.
+//
+// Integrals along a trajectory are sums over the crossed voxels, which are
+// visited with a 3D-DDA (Amanatides & Woo), so Correct needs no root finding.
+class Density_voxel : public Density_distr {
+   public:
+    Density_voxel(const Vector3D& origin,
+                  const Vector3D& voxel_size,
+                  const std::array<unsigned int, 3>& voxel_number,
+                  const std::vector<double>& densities,
+                  double outside = 1.0);
+    Density_voxel(const Density_voxel&);
+
+    bool compare(const Density_distr& dens_distr) const override;
+
+    Density_distr* clone() const override { return new Density_voxel(*this); };
+
+    double Correct(const Vector3D& xi,
+                   const Vector3D& direction,
+                   double res,
+                   double distance_to_border) const override;
+    double Integrate(const Vector3D& xi,
+                     const Vector3D& direction,
+                     double l) const override;
+    double Calculate(const Vector3D& xi,
+                     const Vector3D& direction,
+                     double distance) const override;
+    double Evaluate(const Vector3D& xi) const override;
+
+    Vector3D GetOrigin() const { return origin_; }
+    Vector3D GetVoxelSize() const { return Vector3D(voxel_size_[0], voxel_size_[1], voxel_size_[2]); }
+    std::array<unsigned int, 3> GetVoxelNumber() const { return voxel_number_; }
+    const std::vector<double>& GetDensities() const { return densities_; }
+    double GetOutside() const { return outside_; }
+
+   private:
+    // Walks along the trajectory until either the distance max_distance or
+    // the grammage max_grammage is reached. Returns the grammage and stores
+    // the distance in distance.
+    double Traverse(const Vector3D& xi,
+                    const Vector3D& direction,
+                    double max_distance,
+                    double max_grammage,
+                    double& distance) const;
+
+    Vector3D origin_;
+    std::array<double, 3> voxel_size_;
+    std::array<unsigned int, 3> voxel_number_;
+    std::vector<double> densities_;
+    double outside_;
+};
+}  // namespace PROPOSAL
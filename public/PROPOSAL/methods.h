@@ -77,11 +77,16 @@ struct InterpolationDef
         , path_to_tables(std::string())
         , path_to_tables_readonly(std::string())
         , max_node_energy(1e14) // upper energy bound for Interpolation (MeV)
+        , extended_max_node_energy(0) // extend the tables above max_node_energy (MeV)
         , nodes_cross_section(100) // number of interpolation in cross section
         , nodes_continous_randomization(200) // number of interpolation in continuous randomization
         , nodes_propagate(1000) // number of interpolation in propagate
+        , interpolation_precision(0) // adapt the nodes to this relative error, 0 for equidistant nodes
+        , storage_precision(0) // relative error of the stored 2d table values, 0 keeps the tables as built
         , do_binary_tables(true)
         , just_use_readonly_path(false)
+        , do_async_build(false)
+        , do_cut_independent_dndx(false)
     {
     }
 
@@ -91,11 +96,16 @@ struct InterpolationDef
     std::string path_to_tables;
     std::string path_to_tables_readonly;
     double max_node_energy;
+    double extended_max_node_energy; // not part of the hash, extensions are stored on their own
     int nodes_cross_section;
     int nodes_continous_randomization;
     int nodes_propagate;
+    double interpolation_precision; // the nodes_* are the maximal numbers of nodes then
+    double storage_precision; // not part of the hash, the tables are compacted after loading
     bool do_binary_tables;
     bool just_use_readonly_path;
+    bool do_async_build; // build tables in the background and integrate meanwhile
+    bool do_cut_independent_dndx; // share the dNdx tables between energy cuts
 
     size_t GetHash() const;
 };
@@ -175,6 +185,25 @@ void InitializeInterpolation(const std::string name,
                              const std::vector<Parametrization*>&,
                              const InterpolationDef);
 
+// ----------------------------------------------------------------------------
+/// @brief Helper for interpolation initialization
+///
+/// Same as above, but the tables are keyed by the given hash instead of
+/// the hash of the parametrizations.
+/// If InterpolationDef::extended_max_node_energy is set, the tables are
+/// extended afterwards. The extension is stored as "<name>_extension" and
+/// keyed by the hash of the extended tables.
+///
+/// @param name: subject of resulting file name
+/// @param InterpolantBuilderContainer:
+///        vector of builder, pointer to Interplant pairs
+/// @param size_t: hash of everything the tables depend on
+// ----------------------------------------------------------------------------
+void InitializeInterpolation(const std::string name,
+                             InterpolantBuilderContainer&,
+                             size_t,
+                             const InterpolationDef);
+
 // ----------------------------------------------------------------------------
 /// @brief Simple map structure where keys and values can be used for indexing
 // ----------------------------------------------------------------------------
@@ -65,6 +65,12 @@ class Utility {
         PhotoPairFactory::Definition photopair_def;
         AnnihilationFactory::Definition annihilation_def;
 
+        // Number of energies for which the integrals are memoized in
+        // integral mode, 0 disables the memoization. Energies within the
+        // relative tolerance share their values.
+        unsigned int integral_cache_size;
+        double integral_cache_tolerance;
+
         bool operator==(const Utility::Definition& utility_def) const;
         bool operator!=(const Utility::Definition& utility_def) const;
         friend std::ostream& operator<<(std::ostream&, Definition const&);
@@ -100,6 +106,8 @@ class Utility {
         return crosssections_;
     }
     CrossSection* GetCrosssection(int typeId) const;
+    unsigned int GetIntegralCacheSize() const { return integral_cache_size_; }
+    double GetIntegralCacheTolerance() const { return integral_cache_tolerance_; }
 
     std::pair<double, int> StochasticLoss(
         double particle_energy, double rnd1, double rnd2, double rnd3);
@@ -116,6 +124,9 @@ class Utility {
     EnergyCutSettings cut_settings_;
 
     std::vector<CrossSection*> crosssections_;
+
+    unsigned int integral_cache_size_;
+    double integral_cache_tolerance_;
 };
 
 class UtilityDecorator {
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include "PROPOSAL/math/EnergyCache.h"
 #include "PROPOSAL/math/Integral.h"
 #include "PROPOSAL/propagation_utility/PropagationUtility.h"
 
@@ -75,7 +76,11 @@ class UtilityIntegral : public UtilityDecorator {
 
     virtual bool compare(const UtilityDecorator&) const;
 
+    // FunctionToIntegral, memoized if the utility enables the integral cache
+    double Integrand(double energy);
+
     Integral integral_;
+    EnergyCache<double> integrand_cache_;
 };
 
 class UtilityIntegralDisplacement : public UtilityIntegral {
@@ -65,7 +65,7 @@ class Interpolant;
 class UtilityInterpolant : public UtilityDecorator
 {
 public:
-    UtilityInterpolant(const Utility&, InterpolationDef);
+    UtilityInterpolant(const Utility&, InterpolationDef, int multiplier_power = -1);
 
     // Copy constructors
     UtilityInterpolant(const Utility&, const UtilityInterpolant&);
@@ -91,6 +91,12 @@ protected:
     Interpolant* interpolant_diff_;
 
     InterpolationDef interpolation_def_;
+
+    // The integrand scales with multiplier^multiplier_power_, if all cross
+    // section multipliers are scaled by a common factor. The tables are
+    // stored for the multipliers normalized to the largest one and are
+    // rescaled after loading, so they are shared between such variations.
+    int multiplier_power_;
 };
 
 class UtilityInterpolantInteraction : public UtilityInterpolant
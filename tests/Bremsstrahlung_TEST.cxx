@@ -4,6 +4,8 @@
 
 #include "gtest/gtest.h"
 
+#include <dirent.h>
+#include <unistd.h>
 #include <fstream>
 #include "PROPOSAL/Constants.h"
 #include "PROPOSAL/crossection/BremsIntegral.h"
@@ -33,6 +35,30 @@ ParticleDef getParticleDef(const std::string& name)
 
 const std::string testfile_dir = "bin/TestFiles/";
 
+int CountTables(const std::string& table_dir, const std::string& name)
+{
+    int count = 0;
+    DIR* dir  = opendir(table_dir.c_str());
+    while (struct dirent* entry = readdir(dir))
+    {
+        if (std::string(entry->d_name).compare(0, name.size() + 1, name + "_") == 0)
+            ++count;
+    }
+    closedir(dir);
+    return count;
+}
+
+void RemoveTables(const std::string& table_dir)
+{
+    DIR* dir = opendir(table_dir.c_str());
+    while (struct dirent* entry = readdir(dir))
+    {
+        std::remove((table_dir + "/" + entry->d_name).c_str());
+    }
+    closedir(dir);
+    rmdir(table_dir.c_str());
+}
+
 TEST(Comparison, Comparison_equal)
 {
     ParticleDef particle_def = MuMinusDef::Get();
@@ -549,6 +575,162 @@ TEST(Bremsstrahlung, Test_of_e_Interpolant)
     }
 }
 
+TEST(Bremsstrahlung, Test_of_cut_independent_dNdx)
+{
+    ParticleDef particle_def             = MuMinusDef::Get();
+    std::shared_ptr<const Medium> medium = CreateMedium("standardrock");
+
+    BremsstrahlungFactory::Definition brems_def;
+
+    InterpolationDef InterpolDef;
+    InterpolDef.do_cut_independent_dndx = true;
+
+    std::vector<EnergyCutSettings> cuts{EnergyCutSettings(500, 0.05), EnergyCutSettings(10, 0.001),
+                                        EnergyCutSettings(-1, 0.01)};
+
+    for (const auto& ecuts : cuts)
+    {
+        CrossSection* brems_integral =
+            BremsstrahlungFactory::Get().CreateBremsstrahlung(particle_def, medium, ecuts, brems_def);
+        CrossSection* brems_interpol =
+            BremsstrahlungFactory::Get().CreateBremsstrahlung(particle_def, medium, ecuts, brems_def, InterpolDef);
+
+        for (double energy = 1e3; energy < 1e12; energy *= 10)
+        {
+            double dNdx = brems_integral->CalculatedNdx(energy);
+            EXPECT_NEAR(brems_interpol->CalculatedNdx(energy), dNdx, 1e-3 * dNdx);
+
+            double loss = brems_interpol->CalculateStochasticLoss(energy, 0.5, 0.5);
+            EXPECT_GE(loss, energy * ecuts.GetCut(energy) * (1 - 1e-6));
+            EXPECT_LE(loss, energy);
+        }
+
+        delete brems_integral;
+        delete brems_interpol;
+    }
+}
+
+TEST(Bremsstrahlung, Test_of_component_tables_shared_between_media)
+{
+    ParticleDef particle_def = MuMinusDef::Get();
+    EnergyCutSettings ecuts(500, 0.05);
+
+    // water and ice consist of the same elements
+    std::shared_ptr<const Medium> water = CreateMedium("water");
+    std::shared_ptr<const Medium> ice   = CreateMedium("ice");
+
+    BremsKelnerKokoulinPetrukhin param_water(particle_def, water, ecuts, 1.0, false);
+    BremsKelnerKokoulinPetrukhin param_ice(particle_def, ice, ecuts, 1.0, false);
+    BremsKelnerKokoulinPetrukhin param_water_lpm(particle_def, water, ecuts, 1.0, true);
+    BremsKelnerKokoulinPetrukhin param_ice_lpm(particle_def, ice, ecuts, 1.0, true);
+
+    EXPECT_NE(param_water.GetHash(), param_ice.GetHash());
+    for (int i = 0; i < water->GetNumComponents(); ++i)
+    {
+        EXPECT_EQ(param_water.GetComponentHash(i), param_ice.GetComponentHash(i));
+        EXPECT_NE(param_water_lpm.GetComponentHash(i), param_ice_lpm.GetComponentHash(i));
+    }
+
+    char table_dir[] = "/tmp/PROPOSAL_Bremsstrahlung_TEST_XXXXXX";
+    ASSERT_NE(mkdtemp(table_dir), nullptr);
+
+    InterpolationDef InterpolDef;
+    InterpolDef.path_to_tables = table_dir;
+
+    BremsInterpolant brems_water(param_water, InterpolDef);
+    int dndx_tables = CountTables(table_dir, "dNdx");
+    EXPECT_EQ(dndx_tables, water->GetNumComponents());
+
+    BremsInterpolant brems_ice(param_ice, InterpolDef);
+    EXPECT_EQ(CountTables(table_dir, "dNdx"), dndx_tables);
+
+    BremsIntegral brems_integral(param_ice);
+    for (double energy = 1e3; energy < 1e12; energy *= 10)
+    {
+        double dNdx = brems_integral.CalculatedNdx(energy);
+        EXPECT_NEAR(brems_ice.CalculatedNdx(energy), dNdx, 1e-3 * dNdx);
+    }
+
+    RemoveTables(table_dir);
+}
+
+TEST(Bremsstrahlung, Test_of_extended_max_node_energy)
+{
+    ParticleDef particle_def = MuMinusDef::Get();
+    std::shared_ptr<const Medium> medium = CreateMedium("standardrock");
+    EnergyCutSettings ecuts(-1, 0.05);
+
+    BremsKelnerKokoulinPetrukhin param(particle_def, medium, ecuts, 1.0, true);
+    BremsIntegral brems_integral(param);
+
+    char table_dir[] = "/tmp/PROPOSAL_Bremsstrahlung_TEST_XXXXXX";
+    ASSERT_NE(mkdtemp(table_dir), nullptr);
+
+    InterpolationDef InterpolDef;
+    InterpolDef.path_to_tables  = table_dir;
+    InterpolDef.max_node_energy = 1e8;
+
+    BremsInterpolant brems_base(param, InterpolDef);
+    EXPECT_EQ(CountTables(table_dir, "dNdx_extension"), 0);
+
+    // the base tables are reused, only the extension is built
+    InterpolDef.extended_max_node_energy = 1e12;
+    int dndx_tables = CountTables(table_dir, "dNdx");
+
+    BremsInterpolant brems_extended(param, InterpolDef);
+    EXPECT_EQ(CountTables(table_dir, "dNdx_extension"), medium->GetNumComponents());
+    EXPECT_EQ(CountTables(table_dir, "dNdx"), dndx_tables + medium->GetNumComponents());
+    EXPECT_EQ(CountTables(table_dir, "dEdx_extension"), 1);
+
+    BremsInterpolant brems_loaded(param, InterpolDef);
+
+    for (double energy = 1e3; energy < 1e12; energy *= 10)
+    {
+        double dNdx = brems_integral.CalculatedNdx(energy);
+        double dEdx = brems_integral.CalculatedEdx(energy);
+        EXPECT_NEAR(brems_extended.CalculatedNdx(energy), dNdx, 1e-3 * dNdx);
+        EXPECT_NEAR(brems_extended.CalculatedEdx(energy), dEdx, 1e-3 * dEdx);
+        EXPECT_DOUBLE_EQ(brems_loaded.CalculatedNdx(energy), brems_extended.CalculatedNdx(energy));
+    }
+
+    RemoveTables(table_dir);
+}
+
+TEST(Bremsstrahlung, Test_of_batch_differential_crosssection)
+{
+    ParticleDef particle_def             = MuMinusDef::Get();
+    std::shared_ptr<const Medium> medium = CreateMedium("standardrock");
+    EnergyCutSettings ecuts(500, 0.05);
+
+    for (bool lpm : {false, true})
+    {
+        BremsKelnerKokoulinPetrukhin brems(particle_def, medium, ecuts, 1.0, lpm);
+        Parametrization& param = brems;
+
+        const size_t n = 20;
+        double v[n], out[n];
+
+        for (double energy = 1e3; energy < 1e12; energy *= 10)
+        {
+            for (size_t component = 0; component < medium->GetNumComponents(); ++component)
+            {
+                brems.SetCurrentComponent(component);
+                Parametrization::IntegralLimits limits = brems.GetIntegralLimits(energy);
+                for (size_t i = 0; i < n; ++i)
+                {
+                    v[i] = limits.vMax * std::pow(1e-6, (i + 0.5) / n);
+                }
+
+                param.DifferentialCrossSection(energy, v, out, n);
+                for (size_t i = 0; i < n; ++i)
+                {
+                    EXPECT_DOUBLE_EQ(out[i], brems.DifferentialCrossSection(energy, v[i]));
+                }
+            }
+        }
+    }
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -8,6 +8,8 @@
 #include "PROPOSAL/medium/density_distr/density_homogeneous.h"
 #include "PROPOSAL/medium/density_distr/density_polynomial.h"
 #include "PROPOSAL/medium/density_distr/density_splines.h"
+#include "PROPOSAL/medium/density_distr/density_voxel.h"
+#include "PROPOSAL/math/RandomGenerator.h"
 
 using namespace PROPOSAL;
 
@@ -109,6 +111,156 @@ TEST(Assignment, Copyconstructor)
     EXPECT_TRUE(A == C);
 }
 
+TEST(Voxel, Evaluate)
+{
+    std::vector<double> densities = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    Density_voxel A(Vector3D(-10, 0, 5), Vector3D(10, 20, 5), {{3, 2, 2}}, densities, 0.5);
+
+    EXPECT_EQ(A.Evaluate(Vector3D(-5, 10, 7)), 1);
+    EXPECT_EQ(A.Evaluate(Vector3D(5, 10, 7)), 2);
+    EXPECT_EQ(A.Evaluate(Vector3D(-5, 30, 7)), 4);
+    EXPECT_EQ(A.Evaluate(Vector3D(15, 30, 12)), 12);
+    EXPECT_EQ(A.Evaluate(Vector3D(-10, 0, 5)), 1);
+    EXPECT_EQ(A.Evaluate(Vector3D(20, 10, 7)), 0.5);
+    EXPECT_EQ(A.Evaluate(Vector3D(-11, 10, 7)), 0.5);
+    EXPECT_EQ(A.Evaluate(Vector3D(0, 10, 15)), 0.5);
+
+    Density_voxel B(A);
+    EXPECT_TRUE(A == B);
+    densities[3] = 0;
+    Density_voxel C(Vector3D(-10, 0, 5), Vector3D(10, 20, 5), {{3, 2, 2}}, densities, 0.5);
+    EXPECT_TRUE(A != C);
+
+    EXPECT_THROW(Density_voxel(Vector3D(), Vector3D(1, 1, 1), {{3, 2, 1}}, densities), DensityException);
+    EXPECT_THROW(Density_voxel(Vector3D(), Vector3D(1, 0, 1), {{3, 2, 2}}, densities), DensityException);
+    EXPECT_THROW(Density_voxel(Vector3D(), Vector3D(1, 1, 1), {{3, 2, 2}}, densities, -1), DensityException);
+}
+
+TEST(Voxel, Homogeneous)
+{
+    Density_voxel A(Vector3D(-100, -100, -100), Vector3D(20, 25, 40), {{10, 8, 5}}, std::vector<double>(400, 0.7), 0.7);
+    Density_homogeneous B(0.7);
+
+    Vector3D position(-200, 30, 10);
+    Vector3D direction(1, 0.3, -0.2);
+    direction.normalise();
+
+    for (double l : {0., 1., 50., 123.4, 1000.}) {
+        EXPECT_NEAR(A.Calculate(position, direction, l), B.Calculate(position, direction, l), 1e-10 * (1 + l));
+        EXPECT_NEAR(A.Correct(position, direction, l, 0), B.Correct(position, direction, l, 0), 1e-10 * (1 + l));
+    }
+}
+
+TEST(Voxel, Traversal)
+{
+    RandomGenerator::Get().SetSeed(24680);
+
+    std::vector<double> densities(6 * 5 * 4);
+    for (auto& density : densities)
+        density = RandomGenerator::Get().RandomDouble() * 2;
+    densities[17] = 0;
+
+    Density_voxel A(Vector3D(0, 0, 0), Vector3D(10, 20, 30), {{6, 5, 4}}, densities, 0.25);
+
+    for (int i = 0; i < 200; ++i) {
+        Vector3D position(200 * RandomGenerator::Get().RandomDouble() - 50,
+                          200 * RandomGenerator::Get().RandomDouble() - 50,
+                          200 * RandomGenerator::Get().RandomDouble() - 50);
+        Vector3D direction(RandomGenerator::Get().RandomDouble() - 0.5,
+                           RandomGenerator::Get().RandomDouble() - 0.5,
+                           RandomGenerator::Get().RandomDouble() - 0.5);
+        if (i % 10 == 0)
+            direction = Vector3D(0, 0, 1);
+        direction.normalise();
+
+        // sum over small steps, which differs at every voxel border by at
+        // most one step times the density difference
+        double length = 300;
+        int steps = 30000;
+        double sum = 0;
+        for (int k = 0; k < steps; ++k)
+            sum += A.Evaluate(position + (length / steps * (k + 0.5)) * direction) * length / steps;
+
+        double grammage = A.Calculate(position, direction, length);
+        EXPECT_NEAR(grammage, sum, 20 * 2 * length / steps);
+        EXPECT_NEAR(A.Integrate(position, -direction, -length), -grammage, 1e-10);
+
+        double res = RandomGenerator::Get().RandomDouble() * grammage;
+        double distance = A.Correct(position, direction, res, 0);
+        EXPECT_NEAR(A.Calculate(position, direction, distance), res, 1e-9);
+        EXPECT_NEAR(A.Correct(position, direction, -res, 0), -A.Correct(position, -direction, res, 0), 1e-9);
+    }
+}
+
+TEST(Voxel, Empty)
+{
+    Density_voxel A(Vector3D(0, 0, 0), Vector3D(10, 10, 10), {{2, 1, 1}}, {1, 2}, 0);
+
+    EXPECT_NEAR(A.Correct(Vector3D(-5, 5, 5), Vector3D(1, 0, 0), 25, 0), 22.5, 1e-12);
+    EXPECT_NEAR(A.Calculate(Vector3D(-5, 5, 5), Vector3D(1, 0, 0), 100), 30, 1e-12);
+    EXPECT_THROW(A.Correct(Vector3D(-5, 5, 5), Vector3D(1, 0, 0), 31, 0), DensityException);
+    EXPECT_THROW(A.Correct(Vector3D(-5, 5, 5), Vector3D(0, 1, 0), 1, 0), DensityException);
+    EXPECT_EQ(A.Correct(Vector3D(-5, 5, 5), Vector3D(0, 1, 0), 0, 0), 0);
+}
+
+TEST(Correct, Polynomial)
+{
+    // density rising from 1 to 3 over 2 km along the axis
+    std::vector<double> coefficients = {1, 1e-5};
+    Polynom polynom(coefficients);
+    CartesianAxis axis(Vector3D(0, 0, 1), Vector3D(0, 0, 0));
+    Density_polynomial A(axis, polynom, -1e4, 3e5);
+    Density_polynomial B(axis, polynom);
+    EXPECT_TRUE(A != B);
+    EXPECT_TRUE(A == Density_polynomial(A));
+
+    std::vector<Vector3D> directions = {Vector3D(0, 0, 1), Vector3D(0, 0, -1), Vector3D(0.6, 0, 0.8),
+                                        Vector3D(0.8, 0, -0.6), Vector3D(1, 0, 0), Vector3D(1, 0, 1e-9)};
+    Vector3D position(0, 0, 1e5);
+
+    for (auto direction : directions) {
+        direction.normalise();
+        for (double distance : {1e-2, 1., 1e2, 1e4, 5e4}) {
+            double grammage = A.Calculate(position, direction, distance);
+            EXPECT_GT(grammage, 0);
+            EXPECT_NEAR(A.Correct(position, direction, grammage, 1e6), distance, 1e-6 * distance);
+            EXPECT_NEAR(B.Correct(position, direction, grammage, 1e5), distance, 1e-6 * distance);
+        }
+    }
+
+    // along the axis the integral is known
+    EXPECT_NEAR(A.Calculate(position, Vector3D(0, 0, 1), 1e5), 1e5 * 2.5, 1e-6);
+    EXPECT_NEAR(A.Calculate(position, Vector3D(0, 0, -1), 1e5), 1e5 * 1.5, 1e-6);
+    EXPECT_NEAR(A.Calculate(position, Vector3D(1, 0, 0), 1e5), 1e5 * 2, 1e-6);
+
+    EXPECT_THROW(A.Correct(position, Vector3D(0, 0, 1), 3e3, 1e3), DensityException);
+    EXPECT_THROW(Density_polynomial(axis, polynom, 1, 1), DensityException);
+}
+
+TEST(Correct, Splines)
+{
+    std::vector<double> x = {-1e5, 0, 1e5, 2e5, 4e5};
+    std::vector<double> y = {0.5, 1, 3, 2, 2.5};
+    Linear_Spline linear(x, y);
+    Cubic_Spline cubic(x, y);
+    CartesianAxis axis(Vector3D(0, 0, 1), Vector3D(0, 0, 0));
+
+    for (auto A : {Density_splines(axis, linear), Density_splines(axis, cubic)}) {
+        Vector3D position(0, 0, 1.5e5);
+        for (auto direction : {Vector3D(0, 0, 1), Vector3D(0, 0, -1), Vector3D(0.6, 0, 0.8), Vector3D(0.8, 0, -0.6)}) {
+            for (double distance : {1e-2, 1., 1e3, 1e5, 2e5}) {
+                double grammage = A.Calculate(position, direction, distance);
+                EXPECT_GT(grammage, 0);
+                EXPECT_NEAR(A.Correct(position, direction, grammage, 1e6), distance, 1e-6 * distance);
+            }
+        }
+    }
+
+    Density_splines A(axis, linear);
+    EXPECT_NEAR(A.Calculate(Vector3D(0, 0, 0), Vector3D(0, 0, 1), 2e5), 1e5 * 2 + 1e5 * 2.5, 1e-6);
+    EXPECT_NEAR(A.Calculate(Vector3D(0, 0, 0), Vector3D(0, 0, -1), 1e5), 1e5 * 0.75, 1e-6);
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
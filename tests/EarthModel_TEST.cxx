@@ -0,0 +1,183 @@
+
+#include <cstdio>
+#include <fstream>
+
+#include "gtest/gtest.h"
+
+#include "PROPOSAL/EarthModel.h"
+#include "PROPOSAL/PROPOSAL.h"
+
+using namespace PROPOSAL;
+
+// index of the sector containing the position, the number of sectors if it
+// is outside of the model
+unsigned int FindSector(const std::vector<Sector::Definition>& definitions, const Vector3D& position)
+{
+    Vector3D direction(0, 0, 1);
+    for (unsigned int i = 0; i < definitions.size(); ++i) {
+        if (definitions[i].GetGeometry()->IsInside(position, direction))
+            return i;
+    }
+    return definitions.size();
+}
+
+double MassDensity(const std::vector<Sector::Definition>& definitions, const Vector3D& position)
+{
+    unsigned int sector = FindSector(definitions, position);
+    if (sector == definitions.size())
+        return 0;
+    return definitions[sector].GetMedium()->GetCorrectedMassDensity(position);
+}
+
+TEST(EarthModel, PREM)
+{
+    EarthModel earth(Vector3D(0, 0, 0), EarthModel::PREM());
+    std::vector<Sector::Definition> definitions = earth.CreateSectorDefinitions(Sector::Definition());
+
+    ASSERT_EQ(earth.GetLayers().size(), 10u);
+    ASSERT_EQ(definitions.size(), 10u);
+    EXPECT_EQ(FindSector(definitions, Vector3D(0, 0, 1e3)), 0u);
+    EXPECT_EQ(FindSector(definitions, Vector3D(0, 0, 1221.4e5)), 0u);
+    EXPECT_EQ(FindSector(definitions, Vector3D(0, 0, 1221.6e5)), 1u);
+    EXPECT_EQ(FindSector(definitions, Vector3D(0, 0, 6000e5)), 5u);
+    EXPECT_EQ(FindSector(definitions, Vector3D(0, 0, 6370e5)), 9u);
+    EXPECT_EQ(FindSector(definitions, Vector3D(0, 0, 6372e5)), 10u);
+    EXPECT_EQ(FindSector(definitions, Vector3D(0, 3e8, 4e8)), 2u);
+
+    // reference values of the PREM
+    EXPECT_NEAR(MassDensity(definitions, Vector3D(0, 0, 1e3)), 13.0885, 1e-6);
+    EXPECT_NEAR(MassDensity(definitions, Vector3D(0, 0, 3479.9e5)), 9.9035, 1e-3);
+    EXPECT_NEAR(MassDensity(definitions, Vector3D(0, 0, 3480.1e5)), 5.5664, 1e-3);
+    EXPECT_NEAR(MassDensity(definitions, Vector3D(0, 0, 6360e5)), 2.6, 1e-12);
+    EXPECT_NEAR(MassDensity(definitions, Vector3D(0, 0, -6370e5)), 1.02, 1e-12);
+    EXPECT_EQ(MassDensity(definitions, Vector3D(0, 0, 6400e5)), 0);
+}
+
+TEST(EarthModel, Sectors)
+{
+    RandomGenerator::Get().SetSeed(4321);
+
+    Vector3D center(0, 0, -6371e3);
+    EarthModel earth(center, EarthModel::PREM());
+    std::vector<Sector::Definition> definitions = earth.CreateSectorDefinitions(Sector::Definition());
+    ASSERT_EQ(definitions.size(), earth.GetLayers().size());
+
+    for (int i = 0; i < 1000; ++i) {
+        Vector3D direction;
+        direction.SetSphericalCoordinates(1,
+            2 * PI * RandomGenerator::Get().RandomDouble(),
+            std::acos(2 * RandomGenerator::Get().RandomDouble() - 1));
+        direction.CalculateCartesianFromSpherical();
+
+        double radius = 6371e5 * std::pow(RandomGenerator::Get().RandomDouble(), 0.2);
+        Vector3D position = 100 * center + radius * direction;
+
+        // the shells do not overlap
+        unsigned int inside = 0;
+        for (const auto& definition : definitions)
+            inside += definition.GetGeometry()->IsInside(position, direction);
+        EXPECT_EQ(inside, 1u);
+
+        // the density is the polynomial of the layer in r / R
+        unsigned int layer = FindSector(definitions, position);
+        ASSERT_LT(layer, definitions.size());
+        EXPECT_GE(radius, 100 * earth.GetLayers()[layer].inner_radius * (1 - 1e-12));
+        EXPECT_LE(radius, 100 * earth.GetLayers()[layer].outer_radius * (1 + 1e-12));
+
+        double x = radius / 6371e5;
+        double expected = 0;
+        const std::vector<double>& coefficients = earth.GetLayers()[layer].density;
+        for (auto coefficient = coefficients.rbegin(); coefficient != coefficients.rend(); ++coefficient)
+            expected = expected * x + *coefficient;
+
+        EXPECT_NEAR(definitions[layer].GetMedium()->GetCorrectedMassDensity(position), expected, 1e-10 * expected);
+    }
+}
+
+TEST(EarthModel, Config)
+{
+    nlohmann::json config = {
+        { "origin", { 0, 0, -1e3 } },
+        { "hierarchy", 2 },
+        { "layers", {
+            { { "outer_radius", 500 }, { "medium", "iron" }, { "density", { 8, -1 } } },
+            { { "inner_radius", 500 }, { "outer_radius", 1000 }, { "medium", "water" }, { "density", { 1 } } },
+        } },
+    };
+
+    EarthModel A(config);
+    EarthModel B(Vector3D(0, 0, -1e3), { { 0, 500, "iron", { 8, -1 } }, { 500, 1000, "water", { 1 } } });
+    EXPECT_TRUE(A != B);
+    B.SetHierarchy(2);
+    EXPECT_TRUE(A == B);
+    EXPECT_EQ(A.CreateSectorDefinitions(Sector::Definition())[1].GetGeometry()->GetHierarchy(), 2u);
+
+    EXPECT_TRUE(EarthModel(nlohmann::json{ { "origin", { 0, 0, 0 } } })
+        == EarthModel(Vector3D(), EarthModel::PREM()));
+
+    config["layers"][1]["inner_radius"] = 600;
+    EXPECT_THROW(EarthModel{ config }, std::invalid_argument);
+    EXPECT_THROW(EarthModel(nlohmann::json{ { "origin", { 0, 0, 0 } }, { "model", "flat" } }), std::invalid_argument);
+}
+
+TEST(EarthModel, Propagation)
+{
+    // up-going muon starting 10 km below the surface of the earth
+    nlohmann::json config = {
+        { "global", {
+            { "seed", 1 },
+            { "interpolation", {
+                { "path_to_tables", { "resources/tables" } },
+                { "path_to_tables_readonly", { "resources/tables" } },
+            } },
+            { "brems", "BremsAndreevBezrukovBugaev" },
+            { "photo", "PhotoButkevichMikhailov" },
+            { "photo_shadow", "ShadowDuttaRenoSarcevicSeckel" },
+            { "epair", "epairkelnerkokoulinpetrukhin" },
+            { "ioniz", "ionizbetheblochrossi" },
+            { "cuts_infront", { { "e_cut", 500 }, { "v_cut", 0.05 }, { "cont_rand", true } } },
+            { "cuts_inside", { { "e_cut", 500 }, { "v_cut", 0.05 }, { "cont_rand", true } } },
+            { "cuts_behind", { { "e_cut", 500 }, { "v_cut", 0.05 }, { "cont_rand", true } } },
+            { "medium", "standardrock" },
+            { "geometry", { { "shape", "sphere" }, { "origin", { 0, 0, -6371e3 } }, { "outer_radius", 6371e3 } } },
+        } },
+        { "sectors", nlohmann::json::array({ { { "earth_model", { { "model", "PREM" }, { "origin", { 0, 0, -6371e3 } } } } } }) },
+        { "detector", { { "shape", "sphere" }, { "origin", { 0, 0, 1e3 } }, { "outer_radius", 100 } } },
+    };
+
+    std::ofstream file("EarthModel_TEST.json");
+    file << config;
+    file.close();
+
+    ParticleDef mu_def = MuMinusDef::Get();
+    Propagator propagator(mu_def, "EarthModel_TEST.json");
+    std::remove("EarthModel_TEST.json");
+
+    EXPECT_EQ(propagator.GetSectors().size() % EarthModel::PREM().size(), 0u);
+
+    EarthModel earth(nlohmann::json{ { "origin", { 0, 0, -6371e3 } } });
+    std::vector<Sector::Definition> definitions = earth.CreateSectorDefinitions(Sector::Definition());
+
+    DynamicData mu(mu_def.particle_type);
+    for (int i = 0; i < 10; ++i) {
+        mu.SetEnergy(1e6);
+        mu.SetPropagatedDistance(0);
+        mu.SetPosition(Vector3D(0, 0, -1e6));
+        mu.SetDirection(Vector3D(0, 0, 1));
+
+        Secondaries secondaries = propagator.Propagate(mu);
+        ASSERT_GT(secondaries.GetNumberOfParticles(), 0u);
+
+        // a TeV muon stops in a few kilometers of rock
+        Vector3D position = secondaries.GetSecondaries().back().GetPosition();
+        EXPECT_LT(FindSector(definitions, position), definitions.size());
+        EXPECT_GT(position.GetZ(), -1e6);
+        EXPECT_LT(position.GetZ(), 0);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
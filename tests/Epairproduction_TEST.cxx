@@ -541,6 +541,47 @@ TEST(Epairproduction, Test_of_e_interpol)
     }
 }
 
+TEST(Epairproduction, Test_of_batch_rho_integrand)
+{
+    ParticleDef particle_def             = MuMinusDef::Get();
+    std::shared_ptr<const Medium> medium = CreateMedium("standardrock");
+    EnergyCutSettings ecuts(500, 0.05);
+
+    EpairKelnerKokoulinPetrukhin epair(particle_def, medium, ecuts, 1.0, true);
+    EpairProductionRhoIntegral& param = epair;
+
+    const size_t n = 20;
+    double rho[n], out[n];
+
+    for (double energy = 1e3; energy < 1e12; energy *= 10)
+    {
+        Parametrization::IntegralLimits limits = epair.GetIntegralLimits(energy);
+
+        for (double v = limits.vUp; v < limits.vMax; v *= 2)
+        {
+            // the integrand is evaluated at 1 - rho, see FunctionToIntegral
+            double aux = 1 - (4 * ME) / (energy * v);
+            double aux2 = 1 - (6 * particle_def.mass * particle_def.mass) / (energy * energy * (1 - v));
+            if (aux <= 0 || aux2 <= 0)
+            {
+                continue;
+            }
+            double r_max = std::sqrt(aux) * aux2;
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                rho[i] = 1 - r_max + r_max * (i + 0.5) / n;
+            }
+
+            param.FunctionToIntegral(energy, v, rho, out, n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                EXPECT_DOUBLE_EQ(out[i], epair.FunctionToIntegral(energy, v, rho[i]));
+            }
+        }
+    }
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,124 @@
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "PROPOSAL/math/FastMath.h"
+
+using namespace PROPOSAL;
+
+// distance of two doubles in units of the last place of the expected value
+double Ulps(double value, double expected)
+{
+    double ulp = std::nextafter(std::abs(expected), std::numeric_limits<double>::infinity()) - std::abs(expected);
+    return std::abs(value - expected) / ulp;
+}
+
+TEST(FastMath, ExpAccuracy)
+{
+    std::mt19937_64 gen(1234);
+    std::uniform_real_distribution<double> dist(-708, 709.7);
+
+    double max_ulps = 0;
+
+    for (int i = 0; i < 1000000; ++i)
+    {
+        double x = dist(gen);
+        max_ulps = std::max(max_ulps, Ulps(fastExp(x), std::exp(x)));
+    }
+
+    // close to zero the reduction is exact
+    for (double x = -1; x <= 1; x += 1e-5)
+    {
+        max_ulps = std::max(max_ulps, Ulps(fastExp(x), std::exp(x)));
+    }
+
+    EXPECT_LE(max_ulps, 1.);
+}
+
+TEST(FastMath, LogAccuracy)
+{
+    std::mt19937_64 gen(1234);
+    std::uniform_real_distribution<double> dist(0.9, 1.1);
+
+    double max_ulps = 0;
+
+    for (int i = 0; i < 1000000; ++i)
+    {
+        // all positive normal and subnormal numbers
+        uint64_t bits = gen() % UINT64_C(0x7ff0000000000000);
+        double x;
+        std::memcpy(&x, &bits, sizeof x);
+
+        if (x > 0)
+        {
+            max_ulps = std::max(max_ulps, Ulps(fastLog(x), std::log(x)));
+        }
+
+        // relative accuracy close to 1
+        x = dist(gen);
+        if (x != 1)
+        {
+            max_ulps = std::max(max_ulps, Ulps(fastLog(x), std::log(x)));
+        }
+    }
+
+    EXPECT_LE(max_ulps, 1.);
+    EXPECT_EQ(fastLog(1.), 0.);
+}
+
+TEST(FastMath, SpecialValues)
+{
+    double inf = std::numeric_limits<double>::infinity();
+    double nan = std::numeric_limits<double>::quiet_NaN();
+
+    EXPECT_EQ(fastExp(0.), 1.);
+    EXPECT_EQ(fastExp(inf), inf);
+    EXPECT_EQ(fastExp(1000.), inf);
+    EXPECT_EQ(fastExp(-inf), 0.);
+    EXPECT_EQ(fastExp(-1000.), 0.);
+    EXPECT_TRUE(std::isnan(fastExp(nan)));
+
+    // subnormal results
+    EXPECT_NEAR(fastExp(-740.), std::exp(-740.), 1e-2 * std::exp(-740.));
+
+    EXPECT_EQ(fastLog(0.), -inf);
+    EXPECT_EQ(fastLog(inf), inf);
+    EXPECT_TRUE(std::isnan(fastLog(-1.)));
+    EXPECT_TRUE(std::isnan(fastLog(nan)));
+    EXPECT_EQ(fastLog(std::numeric_limits<double>::denorm_min()), std::log(std::numeric_limits<double>::denorm_min()));
+}
+
+TEST(FastMath, Batch)
+{
+    std::vector<double> x, out(1000);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        x.push_back(-50 + 0.1 * i);
+    }
+
+    fastExp(x.data(), out.data(), x.size());
+
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        EXPECT_EQ(out[i], fastExp(x[i]));
+        x[i] = out[i];
+    }
+
+    fastLog(x.data(), out.data(), x.size());
+
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        EXPECT_EQ(out[i], fastLog(x[i]));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,15 +1,23 @@
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <map>
 // #include <string>
 // #include <cmath>
 
 #include "gtest/gtest.h"
 
 #include "PROPOSAL/Constants.h"
+#include "PROPOSAL/geometry/BoundingVolumeHierarchy.h"
 #include "PROPOSAL/geometry/Box.h"
 #include "PROPOSAL/geometry/Cylinder.h"
 #include "PROPOSAL/geometry/Geometry.h"
+#include "PROPOSAL/geometry/Mesh.h"
 #include "PROPOSAL/geometry/Sphere.h"
+#include "PROPOSAL/geometry/TraversalPlan.h"
 #include "PROPOSAL/math/RandomGenerator.h"
 
 using namespace PROPOSAL;
@@ -1265,6 +1273,528 @@ TEST(DistanceTo, Box)
     }
 }
 
+TEST(BoundingBox, Geometries)
+{
+    // the constructors take meters, the boxes are in cm
+    Vector3D position(1, -2, 3);
+
+    std::pair<Vector3D, Vector3D> bounds = Sphere(position, 5, 2).GetBoundingBox();
+    EXPECT_EQ(bounds.first, Vector3D(-400, -700, -200));
+    EXPECT_EQ(bounds.second, Vector3D(600, 300, 800));
+
+    bounds = Box(position, 2, 4, 6).GetBoundingBox();
+    EXPECT_EQ(bounds.first, Vector3D(0, -400, 0));
+    EXPECT_EQ(bounds.second, Vector3D(200, 0, 600));
+
+    bounds = Cylinder(position, 3, 1, 4).GetBoundingBox();
+    EXPECT_EQ(bounds.first, Vector3D(-200, -500, 100));
+    EXPECT_EQ(bounds.second, Vector3D(400, 100, 500));
+}
+
+TEST(BoundingVolumeHierarchy, Candidates)
+{
+    RandomGenerator::Get().SetSeed(1234);
+
+    std::vector<std::shared_ptr<const Geometry>> geometries;
+
+    // nested shells with a common centre
+    for (int i = 0; i < 10; ++i) {
+        geometries.push_back(Sphere(Vector3D(), 10 * (i + 1), 10 * i).create());
+    }
+
+    // scattered geometries
+    for (int i = 0; i < 50; ++i) {
+        Vector3D position(200 * RandomGenerator::Get().RandomDouble() - 100,
+            200 * RandomGenerator::Get().RandomDouble() - 100,
+            200 * RandomGenerator::Get().RandomDouble() - 100);
+        double size = 1 + 10 * RandomGenerator::Get().RandomDouble();
+
+        switch (i % 3) {
+            case 0:
+                geometries.push_back(Sphere(position, size, 0).create());
+                break;
+            case 1:
+                geometries.push_back(Box(position, size, 2 * size, 0.5 * size).create());
+                break;
+            default:
+                geometries.push_back(Cylinder(position, size, 0.5 * size, 2 * size).create());
+                break;
+        }
+    }
+
+    BoundingVolumeHierarchy hierarchy(geometries);
+    EXPECT_LT(hierarchy.GetNumberOfNodes(), 2 * geometries.size());
+
+    std::vector<unsigned int> candidates;
+
+    for (int i = 0; i < 1000; ++i) {
+        Vector3D position(24000 * RandomGenerator::Get().RandomDouble() - 12000,
+            24000 * RandomGenerator::Get().RandomDouble() - 12000,
+            24000 * RandomGenerator::Get().RandomDouble() - 12000);
+        Vector3D direction;
+        direction.SetSphericalCoordinates(1,
+            2 * PI * RandomGenerator::Get().RandomDouble(),
+            std::acos(2 * RandomGenerator::Get().RandomDouble() - 1));
+        direction.CalculateCartesianFromSpherical();
+
+        // every geometry containing the point has to be a candidate
+        hierarchy.FindCandidates(position, candidates);
+        EXPECT_TRUE(std::is_sorted(candidates.begin(), candidates.end()));
+
+        for (unsigned int k = 0; k < geometries.size(); ++k) {
+            if (geometries[k]->IsInside(position, direction)) {
+                EXPECT_TRUE(std::binary_search(candidates.begin(), candidates.end(), k));
+            }
+        }
+
+        // every border closer than max_distance has to be a candidate
+        double max_distance = 30000 * RandomGenerator::Get().RandomDouble();
+        hierarchy.FindCandidates(position, direction, max_distance, candidates);
+        EXPECT_TRUE(std::is_sorted(candidates.begin(), candidates.end()));
+
+        for (unsigned int k = 0; k < geometries.size(); ++k) {
+            double distance = geometries[k]->DistanceToBorder(position, direction).first;
+            if (distance > 0 && distance < max_distance) {
+                EXPECT_TRUE(std::binary_search(candidates.begin(), candidates.end(), k));
+            }
+        }
+    }
+
+    // the shells are separated, a point in the innermost one only finds the
+    // smallest spheres and the scattered geometries around it
+    hierarchy.FindCandidates(Vector3D(0, 0, 0), candidates);
+    EXPECT_LT(candidates.size(), geometries.size());
+
+    BoundingVolumeHierarchy empty;
+    empty.FindCandidates(Vector3D(), candidates);
+    EXPECT_TRUE(candidates.empty());
+}
+
+TEST(TraversalPlan, AlongTrack)
+{
+    RandomGenerator::Get().SetSeed(4321);
+
+    std::vector<std::shared_ptr<const Geometry>> geometries;
+
+    for (int i = 0; i < 5; ++i) {
+        geometries.push_back(Sphere(Vector3D(), 20 * (i + 1), 20 * i).create());
+    }
+    geometries.push_back(Box(Vector3D(10, 0, 0), 30, 40, 50).create());
+    geometries.push_back(Cylinder(Vector3D(0, -20, 5), 25, 10, 60).create());
+
+    TraversalPlan plan(geometries);
+    unsigned int crossed = 0;
+
+    for (int i = 0; i < 100; ++i) {
+        // aim at the geometries (the constructors take meters)
+        Vector3D position(20000 * RandomGenerator::Get().RandomDouble() - 10000,
+            20000 * RandomGenerator::Get().RandomDouble() - 10000,
+            20000 * RandomGenerator::Get().RandomDouble() - 10000);
+        Vector3D target(6000 * RandomGenerator::Get().RandomDouble() - 3000,
+            6000 * RandomGenerator::Get().RandomDouble() - 3000,
+            6000 * RandomGenerator::Get().RandomDouble() - 3000);
+        Vector3D direction = target - position;
+        direction.normalise();
+
+        unsigned int casts = plan.GetNumberOfCasts();
+
+        // step to the borders, to closest approaches and to random points
+        for (int step = 0; step < 20; ++step) {
+            plan.Update(position, direction);
+            EXPECT_EQ(plan.GetNumberOfCasts(), casts + 1);
+
+            const std::vector<unsigned int>& upcoming = plan.GetUpcomingBorders();
+
+            for (unsigned int k = 0; k < geometries.size(); ++k) {
+                std::pair<double, double> expected = geometries[k]->DistanceToBorder(position, direction);
+                std::pair<double, double> dist    = plan.DistanceToBorder(k);
+
+                EXPECT_NEAR(dist.first, expected.first, 1e-6);
+                EXPECT_NEAR(dist.second, expected.second, 1e-6);
+                EXPECT_EQ(plan.IsInside(k), geometries[k]->IsInside(position, direction));
+                EXPECT_EQ(plan.GetLocation(k), geometries[k]->GetLocation(position, direction));
+                EXPECT_NEAR(plan.DistanceToClosestApproach(k),
+                    geometries[k]->DistanceToClosestApproach(position, direction),
+                    1e-6);
+                EXPECT_EQ(std::find(upcoming.begin(), upcoming.end(), k) != upcoming.end(), expected.first > 0);
+            }
+
+            for (unsigned int k = 1; k < upcoming.size(); ++k) {
+                EXPECT_LE(plan.DistanceToBorder(upcoming[k - 1]).first, plan.DistanceToBorder(upcoming[k]).first);
+            }
+
+            if (upcoming.empty())
+                break;
+
+            double distance = plan.DistanceToBorder(upcoming.front()).first;
+            if (step % 3 == 1)
+                distance *= RandomGenerator::Get().RandomDouble();
+
+            position = position + distance * direction;
+            ++crossed;
+        }
+    }
+    EXPECT_GT(crossed, 200u);
+
+    // a deflection casts the ray again
+    unsigned int casts = plan.GetNumberOfCasts();
+    plan.Update(Vector3D(0, 0, -1000), Vector3D(0, 0, 1));
+    plan.Update(Vector3D(0, 0, -500), Vector3D(0, 0, 1));
+    EXPECT_EQ(plan.GetNumberOfCasts(), casts + 1);
+    EXPECT_NEAR(plan.DistanceToClosestApproach(0), 500, 1e-9);
+
+    plan.Update(Vector3D(0, 0, -500), Vector3D(0, std::sin(1e-3), std::cos(1e-3)));
+    EXPECT_EQ(plan.GetNumberOfCasts(), casts + 2);
+
+    // so does moving backwards
+    plan.Update(Vector3D(0, 0, -1000), Vector3D(0, std::sin(1e-3), std::cos(1e-3)));
+    EXPECT_EQ(plan.GetNumberOfCasts(), casts + 3);
+}
+
+TEST(DistanceTo, Batch)
+{
+    RandomGenerator::Get().SetSeed(2468);
+
+    std::vector<std::shared_ptr<const Geometry>> geometries;
+    geometries.push_back(Sphere(Vector3D(1, 2, 3), 10, 0).create());
+    geometries.push_back(Sphere(Vector3D(1, 2, 3), 10, 5).create());
+    geometries.push_back(Box(Vector3D(-1, 0, 2), 10, 15, 20).create());
+    geometries.push_back(Cylinder(Vector3D(0, 1, -2), 10, 0, 20).create());
+    geometries.push_back(Cylinder(Vector3D(0, 1, -2), 10, 5, 20).create());
+
+    // aim at the geometries from inside and outside, including the
+    // directions parallel to the axes
+    const size_t n = 10000;
+    std::vector<double> x(n), y(n), z(n), dir_x(n), dir_y(n), dir_z(n), first(n), second(n);
+
+    for (size_t i = 0; i < n; ++i) {
+        Vector3D position(4000 * RandomGenerator::Get().RandomDouble() - 2000,
+            4000 * RandomGenerator::Get().RandomDouble() - 2000,
+            4000 * RandomGenerator::Get().RandomDouble() - 2000);
+        Vector3D target(2000 * RandomGenerator::Get().RandomDouble() - 1000,
+            2000 * RandomGenerator::Get().RandomDouble() - 1000,
+            2000 * RandomGenerator::Get().RandomDouble() - 1000);
+        Vector3D direction = target - position;
+
+        if (i % 10 == 0)
+            direction = Vector3D(0, 0, position.GetZ() > 0 ? -1 : 1);
+        else if (i % 10 == 1)
+            direction = Vector3D(position.GetX() > 0 ? -1 : 1, 0, 0);
+        direction.normalise();
+
+        x[i]     = position.GetX();
+        y[i]     = position.GetY();
+        z[i]     = position.GetZ();
+        dir_x[i] = direction.GetX();
+        dir_y[i] = direction.GetY();
+        dir_z[i] = direction.GetZ();
+    }
+
+    for (auto geometry : geometries) {
+        geometry->BatchDistanceToBorder(
+            x.data(), y.data(), z.data(), dir_x.data(), dir_y.data(), dir_z.data(), first.data(), second.data(), n);
+
+        unsigned int hits = 0;
+
+        for (size_t i = 0; i < n; ++i) {
+            std::pair<double, double> distance = geometry->DistanceToBorder(
+                Vector3D(x[i], y[i], z[i]), Vector3D(dir_x[i], dir_y[i], dir_z[i]));
+
+            EXPECT_NEAR(first[i], distance.first, 1e-9 * std::abs(distance.first));
+            EXPECT_NEAR(second[i], distance.second, 1e-9 * std::abs(distance.second));
+
+            if (distance.first > 0)
+                ++hits;
+        }
+
+        EXPECT_GT(hits, n / 10);
+    }
+}
+
+// cube with edge length 2 m around the origin
+void CubeMesh(std::vector<Vector3D>& vertices, std::vector<std::array<unsigned int, 3>>& triangles, Vector3D offset)
+{
+    unsigned int first = vertices.size();
+
+    for (int i = 0; i < 8; ++i) {
+        vertices.push_back(offset + Vector3D(i & 1 ? 1 : -1, i & 2 ? 1 : -1, i & 4 ? 1 : -1));
+    }
+
+    const unsigned int faces[6][4] = { { 0, 2, 3, 1 }, { 4, 5, 7, 6 }, { 0, 1, 5, 4 }, { 2, 6, 7, 3 }, { 0, 4, 6, 2 }, { 1, 3, 7, 5 } };
+
+    for (auto face : faces) {
+        triangles.push_back({ { first + face[0], first + face[1], first + face[2] } });
+        triangles.push_back({ { first + face[0], first + face[2], first + face[3] } });
+    }
+}
+
+TEST(Mesh, Cube)
+{
+    RandomGenerator::Get().SetSeed(1357);
+
+    std::vector<Vector3D> vertices;
+    std::vector<std::array<unsigned int, 3>> triangles;
+    CubeMesh(vertices, triangles, Vector3D());
+
+    Vector3D position(1, 2, 3);
+    Mesh mesh(position, vertices, triangles);
+    Box box(position, 2, 2, 2);
+
+    EXPECT_EQ(mesh.GetNumberOfTriangles(), 12u);
+    EXPECT_EQ(mesh.GetBoundingBox(), box.GetBoundingBox());
+
+    // write the cube as OBJ (quadrangles), ASCII STL and binary STL
+    {
+        std::ofstream obj("Mesh_TEST.obj");
+        obj << "# cube\n";
+        for (auto vertex : vertices)
+            obj << "v " << vertex.GetX() << " " << vertex.GetY() << " " << vertex.GetZ() << "\n";
+        const int faces[6][4] = { { 1, 3, 4, 2 }, { 5, 6, 8, 7 }, { 1, 2, 6, 5 }, { 3, 7, 8, 4 }, { 1, 5, 7, 3 }, { 2, 4, 8, 6 } };
+        for (auto face : faces)
+            obj << "f " << face[0] << "/1 " << face[1] << "/2 " << face[2] << "//3 " << face[3] - 9 << "\n";
+
+        std::ofstream stl("Mesh_TEST.stl");
+        stl << "solid cube\n";
+        for (auto triangle : triangles) {
+            stl << "facet normal 0 0 0\nouter loop\n";
+            for (auto index : triangle)
+                stl << "vertex " << vertices[index].GetX() << " " << vertices[index].GetY() << " " << vertices[index].GetZ() << "\n";
+            stl << "endloop\nendfacet\n";
+        }
+        stl << "endsolid cube\n";
+
+        std::ofstream binary("Mesh_TEST_binary.stl", std::ios::binary);
+        char header[80] = "solid but binary";
+        uint32_t number = triangles.size();
+        binary.write(header, 80);
+        binary.write(reinterpret_cast<const char*>(&number), sizeof(number));
+        for (auto triangle : triangles) {
+            float facet[12] = { 0 };
+            for (int k = 0; k < 3; ++k) {
+                facet[3 + 3 * k] = vertices[triangle[k]].GetX();
+                facet[4 + 3 * k] = vertices[triangle[k]].GetY();
+                facet[5 + 3 * k] = vertices[triangle[k]].GetZ();
+            }
+            uint16_t attribute = 0;
+            binary.write(reinterpret_cast<const char*>(facet), sizeof(facet));
+            binary.write(reinterpret_cast<const char*>(&attribute), sizeof(attribute));
+        }
+    }
+
+    nlohmann::json config = { { "shape", "mesh" }, { "origin", { 1, 2, 3 } }, { "file", "Mesh_TEST.obj" } };
+
+    std::vector<std::shared_ptr<const Geometry>> meshes;
+    meshes.push_back(mesh.create());
+    meshes.push_back(std::make_shared<const Mesh>(position, "Mesh_TEST.stl"));
+    meshes.push_back(std::make_shared<const Mesh>(position, "Mesh_TEST_binary.stl"));
+
+    // the json constructor names the geometry after the lower case shape
+    Mesh from_config(config);
+    EXPECT_EQ(from_config.GetName(), "mesh");
+    EXPECT_EQ(from_config.GetNumberOfTriangles(), 12u);
+
+    nlohmann::json box_config = { { "shape", "box" }, { "origin", { 1, 2, 3 } }, { "length", 2 }, { "width", 2 }, { "height", 2 } };
+    EXPECT_EQ(from_config.GetPosition(), Box(box_config).GetPosition());
+    EXPECT_EQ(from_config.GetBoundingBox(), Box(box_config).GetBoundingBox());
+
+    std::remove("Mesh_TEST.obj");
+    std::remove("Mesh_TEST.stl");
+    std::remove("Mesh_TEST_binary.stl");
+
+    for (auto geometry : meshes) {
+        EXPECT_EQ(*geometry, mesh);
+    }
+
+    EXPECT_THROW(Mesh(position, "Mesh_TEST.ply"), std::invalid_argument);
+    EXPECT_THROW(Mesh(position, "Mesh_TEST_missing.obj"), std::invalid_argument);
+
+    // same borders as the box, from inside and outside
+    for (int i = 0; i < 10000; ++i) {
+        Vector3D start(600 * RandomGenerator::Get().RandomDouble() - 200,
+            600 * RandomGenerator::Get().RandomDouble() - 100,
+            600 * RandomGenerator::Get().RandomDouble());
+        Vector3D target(200 * RandomGenerator::Get().RandomDouble(),
+            200 * RandomGenerator::Get().RandomDouble() + 100,
+            200 * RandomGenerator::Get().RandomDouble() + 200);
+        Vector3D direction = target - start;
+        direction.normalise();
+
+        std::pair<double, double> expected = box.DistanceToBorder(start, direction);
+        std::pair<double, double> distance = mesh.DistanceToBorder(start, direction);
+
+        EXPECT_NEAR(distance.first, expected.first, 1e-9);
+        EXPECT_NEAR(distance.second, expected.second, 1e-9);
+        EXPECT_EQ(mesh.IsInside(start, direction), box.IsInside(start, direction));
+    }
+
+    // through an edge and a vertex of the cube
+    std::pair<double, double> distance = mesh.DistanceToBorder(Vector3D(-100, 0, 300), (1 / std::sqrt(2.)) * Vector3D(1, 1, 0));
+    EXPECT_NEAR(distance.first, 100 * std::sqrt(2.), 1e-9);
+    EXPECT_NEAR(distance.second, 300 * std::sqrt(2.), 1e-9);
+
+    distance = mesh.DistanceToBorder(Vector3D(-100, 0, 100), (1 / std::sqrt(3.)) * Vector3D(1, 1, 1));
+    EXPECT_NEAR(distance.first, 100 * std::sqrt(3.), 1e-9);
+    EXPECT_NEAR(distance.second, 300 * std::sqrt(3.), 1e-9);
+}
+
+TEST(Mesh, NotConvex)
+{
+    // two cubes, the trajectory passes the gap between them
+    std::vector<Vector3D> vertices;
+    std::vector<std::array<unsigned int, 3>> triangles;
+    CubeMesh(vertices, triangles, Vector3D(-2, 0, 0));
+    CubeMesh(vertices, triangles, Vector3D(2, 0, 0));
+
+    Mesh mesh(Vector3D(), vertices, triangles);
+    Vector3D direction(1, 0, 0);
+
+    std::pair<double, double> distance = mesh.DistanceToBorder(Vector3D(-500, 10, 20), direction);
+    EXPECT_NEAR(distance.first, 200, 1e-9);
+    EXPECT_NEAR(distance.second, 400, 1e-9);
+
+    distance = mesh.DistanceToBorder(Vector3D(-200, 10, 20), direction);
+    EXPECT_NEAR(distance.first, 100, 1e-9);
+    EXPECT_EQ(distance.second, -1);
+
+    distance = mesh.DistanceToBorder(Vector3D(-100, 10, 20), direction);
+    EXPECT_NEAR(distance.first, 200, 1e-9);
+    EXPECT_NEAR(distance.second, 400, 1e-9);
+    EXPECT_EQ(mesh.GetLocation(Vector3D(-100, 10, 20), direction), Geometry::ParticleLocation::InfrontGeometry);
+
+    distance = mesh.DistanceToBorder(Vector3D(300, 10, 20), direction);
+    EXPECT_EQ(distance.first, -1);
+    EXPECT_EQ(distance.second, -1);
+}
+
+TEST(Mesh, Edge)
+{
+    std::vector<Vector3D> vertices;
+    std::vector<std::array<unsigned int, 3>> triangles;
+    CubeMesh(vertices, triangles, Vector3D());
+
+    // the orientation of the triangles must not matter
+    for (unsigned int i = 0; i < triangles.size(); i += 3)
+        std::swap(triangles[i][1], triangles[i][2]);
+
+    Mesh mesh(Vector3D(), vertices, triangles);
+
+    // through an edge into the cube and out through the opposite edge
+    Vector3D position(-200, -200, 0);
+    Vector3D direction(1, 1, 0);
+    direction.normalise();
+
+    std::pair<double, double> distance = mesh.DistanceToBorder(position, direction);
+    EXPECT_NEAR(distance.first, 100 * std::sqrt(2.), 1e-9);
+    EXPECT_NEAR(distance.second, 300 * std::sqrt(2.), 1e-9);
+
+    // from inside through an edge
+    distance = mesh.DistanceToBorder(Vector3D(), direction);
+    EXPECT_NEAR(distance.first, 100 * std::sqrt(2.), 1e-9);
+    EXPECT_EQ(distance.second, -1);
+    EXPECT_EQ(mesh.GetLocation(Vector3D(), direction), Geometry::ParticleLocation::InsideGeometry);
+
+    // through the diagonals between the two triangles of a face
+    distance = mesh.DistanceToBorder(Vector3D(50, 50, -200), Vector3D(0, 0, 1));
+    EXPECT_NEAR(distance.first, 100, 1e-9);
+    EXPECT_NEAR(distance.second, 300, 1e-9);
+
+    // through a vertex into the cube and out through the opposite vertex
+    Vector3D diagonal(1, 1, 1);
+    diagonal.normalise();
+
+    distance = mesh.DistanceToBorder(Vector3D(-200, -200, -200), diagonal);
+    EXPECT_NEAR(distance.first, 100 * std::sqrt(3.), 1e-9);
+    EXPECT_NEAR(distance.second, 300 * std::sqrt(3.), 1e-9);
+
+    // grazing a silhouette edge does not cross the surface
+    position = Vector3D(-200, 0, 0);
+    distance = mesh.DistanceToBorder(position, direction);
+    EXPECT_EQ(distance.first, -1);
+    EXPECT_EQ(distance.second, -1);
+    EXPECT_FALSE(mesh.IsInside(position, direction));
+
+    // grazing a vertex
+    distance = mesh.DistanceToBorder(Vector3D(-200, 0, 100), direction);
+    EXPECT_EQ(distance.first, -1);
+    EXPECT_EQ(distance.second, -1);
+}
+
+TEST(Mesh, Sphere)
+{
+    RandomGenerator::Get().SetSeed(97531);
+
+    // icosphere with 81920 triangles and a radius of 10 m
+    const double t = (1. + std::sqrt(5.)) / 2.;
+    std::vector<Vector3D> vertices = { Vector3D(-1, t, 0), Vector3D(1, t, 0), Vector3D(-1, -t, 0), Vector3D(1, -t, 0),
+        Vector3D(0, -1, t), Vector3D(0, 1, t), Vector3D(0, -1, -t), Vector3D(0, 1, -t), Vector3D(t, 0, -1),
+        Vector3D(t, 0, 1), Vector3D(-t, 0, -1), Vector3D(-t, 0, 1) };
+    std::vector<std::array<unsigned int, 3>> triangles = { { { 0, 11, 5 } }, { { 0, 5, 1 } }, { { 0, 1, 7 } },
+        { { 0, 7, 10 } }, { { 0, 10, 11 } }, { { 1, 5, 9 } }, { { 5, 11, 4 } }, { { 11, 10, 2 } }, { { 10, 7, 6 } },
+        { { 7, 1, 8 } }, { { 3, 9, 4 } }, { { 3, 4, 2 } }, { { 3, 2, 6 } }, { { 3, 6, 8 } }, { { 3, 8, 9 } },
+        { { 4, 9, 5 } }, { { 2, 4, 11 } }, { { 6, 2, 10 } }, { { 8, 6, 7 } }, { { 9, 8, 1 } } };
+
+    for (auto& vertex : vertices) {
+        vertex = 10 / vertex.magnitude() * vertex;
+    }
+
+    for (int level = 0; level < 6; ++level) {
+        std::map<std::pair<unsigned int, unsigned int>, unsigned int> midpoints;
+        auto midpoint = [&](unsigned int a, unsigned int b) {
+            auto key  = std::make_pair(std::min(a, b), std::max(a, b));
+            auto iter = midpoints.find(key);
+            if (iter != midpoints.end())
+                return iter->second;
+            Vector3D vertex = vertices[a] + vertices[b];
+            vertices.push_back(10 / vertex.magnitude() * vertex);
+            midpoints[key] = vertices.size() - 1;
+            return static_cast<unsigned int>(vertices.size() - 1);
+        };
+
+        std::vector<std::array<unsigned int, 3>> refined;
+        for (auto triangle : triangles) {
+            unsigned int ab = midpoint(triangle[0], triangle[1]);
+            unsigned int bc = midpoint(triangle[1], triangle[2]);
+            unsigned int ca = midpoint(triangle[2], triangle[0]);
+            refined.push_back({ { triangle[0], ab, ca } });
+            refined.push_back({ { triangle[1], bc, ab } });
+            refined.push_back({ { triangle[2], ca, bc } });
+            refined.push_back({ { ab, bc, ca } });
+        }
+        triangles.swap(refined);
+    }
+
+    Mesh mesh(Vector3D(), vertices, triangles);
+    Sphere sphere(Vector3D(), 10, 0);
+    EXPECT_EQ(mesh.GetNumberOfTriangles(), 81920u);
+
+    // the facets deviate from the sphere by less than 0.5 cm
+    for (int i = 0; i < 10000; ++i) {
+        Vector3D position(4000 * RandomGenerator::Get().RandomDouble() - 2000,
+            4000 * RandomGenerator::Get().RandomDouble() - 2000,
+            4000 * RandomGenerator::Get().RandomDouble() - 2000);
+        Vector3D direction;
+        direction.SetSphericalCoordinates(1,
+            2 * PI * RandomGenerator::Get().RandomDouble(),
+            std::acos(2 * RandomGenerator::Get().RandomDouble() - 1));
+        direction.CalculateCartesianFromSpherical();
+
+        if (std::abs(position.magnitude() - 1000) < 1)
+            continue;
+
+        EXPECT_EQ(mesh.IsInside(position, direction), sphere.IsInside(position, direction));
+
+        std::pair<double, double> expected = sphere.DistanceToBorder(position, direction);
+        std::pair<double, double> distance = mesh.DistanceToBorder(position, direction);
+
+        // grazing trajectories may miss the facets
+        if (expected.second > 0 && expected.second - expected.first < 50)
+            continue;
+
+        EXPECT_NEAR(distance.first, expected.first, 5);
+        EXPECT_NEAR(distance.second, expected.second, 5);
+    }
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
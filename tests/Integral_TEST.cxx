@@ -1,10 +1,17 @@
 
 #include "cmath"
+#include <functional>
 #include "gtest/gtest.h"
+#include "PROPOSAL/Constants.h"
+#include "PROPOSAL/math/Cubature.h"
 #include "PROPOSAL/math/Integral.h"
 #include "PROPOSAL/medium/Medium.h"
+#include "PROPOSAL/crossection/EpairIntegral.h"
 #include "PROPOSAL/crossection/IonizIntegral.h"
+#include "PROPOSAL/crossection/PhotoIntegral.h"
+#include "PROPOSAL/crossection/parametrization/EpairProduction.h"
 #include "PROPOSAL/crossection/parametrization/Ionization.h"
+#include "PROPOSAL/crossection/parametrization/PhotoQ2Integration.h"
 #include "PROPOSAL/particle/ParticleDef.h"
 #include "PROPOSAL/EnergyCutSettings.h"
 
@@ -209,6 +216,65 @@ TEST(IntegralValue, IntegrateWithLogSubstitution)
     }
 }
 
+TEST(IntegralValue, Callables)
+{
+    double xmin = 0, xmax = 3;
+    double ExactIntegral = 2. * (std::exp(xmax) - std::exp(xmin));
+    double scale         = 2.;
+    int evaluations      = 0;
+
+    auto lambda = [scale, &evaluations](double x) {
+        ++evaluations;
+        return scale * std::exp(x);
+    };
+    std::function<double(double)> function = lambda;
+    auto bound = std::bind([](double s, double x) { return s * std::exp(x); }, scale, std::placeholders::_1);
+
+    for (int method = 1; method <= 4; ++method)
+    {
+        Integral Int(IROMB, IMAXS, IPREC);
+
+        evaluations = 0;
+        double CalcIntegral = Int.Integrate(xmin + 1, xmax, lambda, method, 2.);
+        EXPECT_GT(evaluations, 0);
+        EXPECT_DOUBLE_EQ(CalcIntegral, Int.Integrate(xmin + 1, xmax, function, method, 2.));
+        EXPECT_DOUBLE_EQ(CalcIntegral, Int.Integrate(xmin + 1, xmax, bound, method, 2.));
+    }
+
+    Integral Int(IROMB, IMAXS, IPREC);
+    ASSERT_NEAR(Int.Integrate(xmin, xmax, lambda, 1), ExactIntegral, ExactIntegral * IPREC);
+    ASSERT_NEAR(Int.Integrate(xmin, xmax, Testexp, 1), ExactIntegral / scale, ExactIntegral * IPREC);
+}
+
+TEST(IntegralValue, BatchIntegrand)
+{
+    double xmin = 2, xmax = 4;
+    size_t max_batch = 0;
+
+    auto batch = [&max_batch](const double* x, double* out, size_t n) {
+        max_batch = std::max(max_batch, n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] = Testexp(x[i]);
+        }
+    };
+
+    for (Integral::Quadrature quadrature : {Integral::Romberg, Integral::GaussKronrod})
+    {
+        for (int method = 1; method <= 5; ++method)
+        {
+            Integral Int(IROMB, IMAXS, 1e-10);
+            Int.SetQuadrature(quadrature);
+
+            // the points are summed in the same order, so the results are equal
+            EXPECT_EQ(Int.IntegrateBatch(xmin, xmax, batch, method, 2.), Int.Integrate(xmin, xmax, Testexp, method, 2.));
+        }
+    }
+
+    EXPECT_GT(max_batch, 1);
+    EXPECT_LE(max_batch, Integral::batch_size);
+}
+
 TEST(QUADPACK, RombergIntegrationFailure)
 {
     double precision = 1e-4;
@@ -237,6 +303,200 @@ TEST(QUADPACK, RombergIntegrationFailure)
     ASSERT_NEAR(dEdx, result, result * precision);
 }
 
+TEST(GaussKronrod, IntegrationMethods)
+{
+    double xmin = 2, xmax = 4;
+    double ExactIntegral = std::exp(xmax) - std::exp(xmin);
+    double CalcIntegral  = 0;
+
+    for (double precision = 1E-5; precision > 1E-11; precision /= 10)
+    {
+        Integral Int(5, 20, precision);
+        Int.SetQuadrature(Integral::GaussKronrod);
+
+        CalcIntegral = Int.Integrate(xmin, xmax, Testexp, 1);
+        ASSERT_NEAR(CalcIntegral, ExactIntegral, ExactIntegral * precision);
+        CalcIntegral = Int.Integrate(xmin, xmax, Testexp, 2);
+        ASSERT_NEAR(CalcIntegral, ExactIntegral, ExactIntegral * precision);
+        CalcIntegral = Int.Integrate(xmin, xmax, Testexp, 3, 2.);
+        ASSERT_NEAR(CalcIntegral, ExactIntegral, ExactIntegral * precision);
+        CalcIntegral = Int.Integrate(xmin, xmax, Testexp, 4);
+        ASSERT_NEAR(CalcIntegral, ExactIntegral, ExactIntegral * precision);
+        CalcIntegral = Int.Integrate(xmin, xmax, Testexp, 5, 2.);
+        ASSERT_NEAR(CalcIntegral, ExactIntegral, ExactIntegral * precision);
+
+        // swapped borders
+        CalcIntegral = Int.Integrate(xmax, xmin, Testexp, 4);
+        ASSERT_NEAR(CalcIntegral, -ExactIntegral, ExactIntegral * precision);
+    }
+}
+
+TEST(GaussKronrod, PeakedIntegrand)
+{
+    // 1/(x^2 + a^2) has a sharp peak at 0, the integral is 2/a atan(1/a)
+    double a = 1e-3;
+    double ExactIntegral = 2. / a * std::atan(1. / a);
+
+    Integral Int(IROMB, IMAXS, IPREC);
+    Int.SetQuadrature(Integral::GaussKronrod);
+
+    double CalcIntegral = Int.Integrate(-1, 1, [a](double x) { return 1. / (x * x + a * a); }, 1);
+    ASSERT_NEAR(CalcIntegral, ExactIntegral, ExactIntegral * IPREC);
+
+    // the workspace is reused for the next integration
+    CalcIntegral = Int.Integrate(-1, 1, [a](double x) { return 1. / (x * x + a * a); }, 1);
+    ASSERT_NEAR(CalcIntegral, ExactIntegral, ExactIntegral * IPREC);
+}
+
+TEST(GaussKronrod, Comparison)
+{
+    Integral A(IROMB, IMAXS, IPREC);
+    Integral B(IROMB, IMAXS, IPREC);
+    B.SetQuadrature(Integral::GaussKronrod);
+    EXPECT_TRUE(A != B);
+
+    Integral C(B);
+    EXPECT_TRUE(B == C);
+    EXPECT_EQ(C.GetQuadrature(), Integral::GaussKronrod);
+
+    EXPECT_EQ(Integral::GetQuadratureFromString("GaussKronrod"), Integral::GaussKronrod);
+    EXPECT_EQ(Integral::GetQuadratureFromString("romberg"), Integral::Romberg);
+}
+
+TEST(GaussKronrod, CrossSections)
+{
+    auto medium = std::make_shared<const StandardRock>();
+    EnergyCutSettings cuts(500, 0.05);
+
+    IonizBetheBlochRossi ioniz_romberg(MuMinusDef::Get(), medium, cuts, 1.0);
+    IonizBetheBlochRossi ioniz_gk(ioniz_romberg);
+    ioniz_gk.SetQuadrature(Integral::GaussKronrod);
+
+    EXPECT_TRUE(ioniz_romberg != ioniz_gk);
+    EXPECT_NE(ioniz_romberg.GetHash(), ioniz_gk.GetHash());
+
+    IonizIntegral ioniz_int_gk(ioniz_gk);
+
+    // reference with a much higher precision
+    Integral integral(IROMB, IMAXS, 1e-12);
+
+    for (double energy = 1e3; energy < 1e10; energy *= 10)
+    {
+        Parametrization::IntegralLimits limits = ioniz_romberg.GetIntegralLimits(energy);
+        double dNdx                            = integral.Integrate(
+            limits.vUp,
+            limits.vMax,
+            [&ioniz_romberg, energy](double v) { return ioniz_romberg.FunctionToDNdxIntegral(energy, v); },
+            4);
+
+        ASSERT_NEAR(ioniz_int_gk.CalculatedNdx(energy), dNdx, dNdx * 1e-4);
+    }
+
+    // the rho integration of the epair production is done with the chosen quadrature as well
+    EpairKelnerKokoulinPetrukhin epair_romberg(MuMinusDef::Get(), medium, cuts, 1.0, true);
+    EpairKelnerKokoulinPetrukhin epair_gk(epair_romberg);
+    epair_gk.SetQuadrature(Integral::GaussKronrod);
+
+    EpairIntegral epair_int_romberg(epair_romberg);
+    EpairIntegral epair_int_gk(epair_gk);
+
+    for (double energy = 1e3; energy < 1e10; energy *= 10)
+    {
+        double dEdx = epair_int_romberg.CalculatedEdx(energy);
+        ASSERT_NEAR(epair_int_gk.CalculatedEdx(energy), dEdx, dEdx * 1e-3);
+
+        double dNdx = epair_int_romberg.CalculatedNdx(energy);
+        ASSERT_NEAR(epair_int_gk.CalculatedNdx(energy), dNdx, dNdx * 1e-3);
+    }
+}
+
+TEST(Cubature, Polynomial)
+{
+    // the Genz-Malik rule is exact up to degree 7
+    Cubature cubature;
+    double CalcIntegral = cubature.Integrate(0, 2, -1, 1, [](double x, const double* y, double* out, size_t n) {
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] = x * x * x * y[i] * y[i] * y[i] * y[i] + x * y[i] * y[i];
+        }
+    });
+    double ExactIntegral = 4. * 2. / 5. + 2. * 2. / 3.;
+    ASSERT_NEAR(CalcIntegral, ExactIntegral, ExactIntegral * 1e-14);
+
+    // swapped borders
+    CalcIntegral = cubature.Integrate(2, 0, -1, 1, [](double x, const double* y, double* out, size_t n) {
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] = x * x * x * y[i] * y[i] * y[i] * y[i] + x * y[i] * y[i];
+        }
+    });
+    ASSERT_NEAR(CalcIntegral, -ExactIntegral, ExactIntegral * 1e-14);
+}
+
+TEST(Cubature, PeakedIntegrand)
+{
+    // exp(-(x^2 + y^2) / (2 s^2)) over [-1, 1]^2 is 2 pi s^2 for small s
+    double s = 0.05;
+    double ExactIntegral = 2 * PI * s * s;
+
+    Cubature cubature(IPREC, 1000);
+    double CalcIntegral = cubature.Integrate(-1, 1, -1, 1, [s](double x, const double* y, double* out, size_t n) {
+        for (size_t i = 0; i < n; ++i)
+        {
+            out[i] = std::exp(-(x * x + y[i] * y[i]) / (2 * s * s));
+        }
+    });
+    ASSERT_NEAR(CalcIntegral, ExactIntegral, ExactIntegral * 1e-5);
+}
+
+TEST(Cubature, CrossSections)
+{
+    auto medium = std::make_shared<const StandardRock>();
+    EnergyCutSettings cuts(500, 0.05);
+
+    // v and rho integrated at once against the nested Gauss-Kronrod integrals,
+    // both have a relative precision of 1e-6
+    EpairKelnerKokoulinPetrukhin epair_gk(MuMinusDef::Get(), medium, cuts, 1.0, true);
+    EpairKelnerKokoulinPetrukhin epair_cubature(epair_gk);
+    epair_gk.SetQuadrature(Integral::GaussKronrod);
+    epair_cubature.SetQuadrature(Integral::Cubature);
+
+    EpairIntegral epair_int_gk(epair_gk);
+    EpairIntegral epair_int_cubature(epair_cubature);
+
+    for (double energy = 1e3; energy < 1e12; energy *= 10)
+    {
+        double dEdx = epair_int_gk.CalculatedEdx(energy);
+        ASSERT_NEAR(epair_int_cubature.CalculatedEdx(energy), dEdx, dEdx * 2e-6);
+
+        double dNdx = epair_int_gk.CalculatedNdx(energy);
+        ASSERT_NEAR(epair_int_cubature.CalculatedNdx(energy), dNdx, dNdx * 2e-6);
+
+        double dE2dx = epair_int_gk.CalculatedE2dx(energy);
+        ASSERT_NEAR(epair_int_cubature.CalculatedE2dx(energy), dE2dx, dE2dx * 2e-6);
+    }
+
+    // v and Q2, several of these integrals stop at the subdivision limit
+    // before reaching 1e-6 and agree only to 6e-5
+    ShadowButkevichMikhailov shadow;
+    PhotoAbramowiczLevinLevyMaor97 photo_gk(MuMinusDef::Get(), medium, cuts, 1.0, shadow);
+    PhotoAbramowiczLevinLevyMaor97 photo_cubature(photo_gk);
+    photo_gk.SetQuadrature(Integral::GaussKronrod);
+    photo_cubature.SetQuadrature(Integral::Cubature);
+
+    PhotoIntegral photo_int_gk(photo_gk);
+    PhotoIntegral photo_int_cubature(photo_cubature);
+
+    for (double energy = 1e3; energy < 1e12; energy *= 10)
+    {
+        double dEdx = photo_int_gk.CalculatedEdx(energy);
+        ASSERT_NEAR(photo_int_cubature.CalculatedEdx(energy), dEdx, dEdx * 1e-4);
+
+        double dNdx = photo_int_gk.CalculatedNdx(energy);
+        ASSERT_NEAR(photo_int_cubature.CalculatedNdx(energy), dNdx, dNdx * 1e-4);
+    }
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -2,6 +2,7 @@
 #include <cmath>
 #include "gtest/gtest.h"
 #include "PROPOSAL/math/Interpolant.h"
+#include "PROPOSAL/math/InterpolantBuilder.h"
 
 using namespace PROPOSAL;
 
@@ -15,6 +16,12 @@ double X_YY(double x, double y)
     return x + y * y * std::exp(x);
 }
 
+// smoothed step at x = 10 on top of exp(x)
+double Step(double x)
+{
+    return std::exp(x) * (1 + 1 / (1 + std::exp(-20 * (x - 10))));
+}
+
 int max        = 100;
 double xmin    = 3;
 double xmax    = 20;
@@ -36,6 +43,21 @@ bool isLog2    = false;
 
 std::string File1DTest = "Interpol1D_Save.txt";
 std::string File2DTest = "Interpol2D_Save.txt";
+std::string File1DAdaptiveTest = "Interpol1D_Adaptive_Save.txt";
+
+// largest relative error of the interpolant on a fine grid
+double MaxRelativeError(Interpolant* Pol1, double (*function)(double))
+{
+    double error = 0;
+
+    for (double SearchX = xmin; SearchX <= xmax; SearchX += 1e-3 * (xmax - xmin))
+    {
+        double RealValue = function(SearchX);
+        error            = std::max(error, std::abs(Pol1->Interpolate(SearchX) - RealValue) / RealValue);
+    }
+
+    return error;
+}
 
 TEST(Comparison, Comparison_equal)
 {
@@ -403,6 +425,162 @@ TEST(_1D_Interpol, All_On)
     delete Pol1;
 }
 
+TEST(_1D_Interpol, Extension)
+{
+    Interpolant1DBuilder builder;
+    builder.SetMax(max)
+        .SetXMin(xmin)
+        .SetXMax(xmax)
+        .SetRomberg(romberg)
+        .SetIsLog(true)
+        .SetRombergY(rombergY)
+        .SetLogSubst(true)
+        .SetFunction1D(X2);
+
+    EXPECT_EQ(builder.CreateExtensionBuilder(2 * xmax, 4 * xmax), nullptr);
+    EXPECT_EQ(builder.CreateExtensionBuilder(xmax, xmax), nullptr);
+
+    InterpolantBuilder* extension_builder = builder.CreateExtensionBuilder(xmax, 2 * xmax);
+    ASSERT_NE(extension_builder, nullptr);
+
+    Interpolant* Pol1      = builder.build();
+    Interpolant* extension = extension_builder->build();
+    Pol1->Append(*extension);
+
+    // the extended grid equals the one built at once
+    int nodes = std::ceil(std::log(2) / (std::log(xmax / xmin) / max) - 1e-6);
+    Interpolant* Pol2 = builder.SetMax(max + nodes).SetXMax(xmax * std::pow(xmax / xmin, (double)nodes / max)).build();
+
+    double precision = 1E-5;
+
+    for (double SearchX = xmin; SearchX < 2 * xmax; SearchX *= 1.1)
+    {
+        double RealValue = X2(SearchX);
+        ASSERT_NEAR(Pol1->Interpolate(SearchX), RealValue, RealValue * precision);
+        ASSERT_NEAR(Pol1->Interpolate(SearchX), Pol2->Interpolate(SearchX), RealValue * 1E-10);
+    }
+
+    delete Pol1;
+    delete Pol2;
+    delete extension;
+    delete extension_builder;
+}
+
+TEST(_1D_Interpol, Adaptive)
+{
+    Interpolant1DBuilder builder;
+    builder.SetMax(max)
+        .SetXMin(xmin)
+        .SetXMax(xmax)
+        .SetRomberg(romberg)
+        .SetRombergY(rombergY)
+        .SetLogSubst(true)
+        .SetFunction1D(Step);
+
+    Interpolant* Pol1 = builder.build();
+    Interpolant* Pol2 = builder.SetPrecision(1e-6).build();
+
+    EXPECT_TRUE(Pol1->IsUniform());
+    EXPECT_FALSE(Pol2->IsUniform());
+
+    // the nodes are concentrated at the step, so less of them give a
+    // smaller error
+    EXPECT_LT(Pol2->GetMax(), max);
+    EXPECT_LT(MaxRelativeError(Pol2, Step), 1e-5);
+    EXPECT_LT(MaxRelativeError(Pol2, Step), MaxRelativeError(Pol1, Step));
+
+    for (double SearchX = xmin + 0.5; SearchX < xmax; SearchX += 0.5)
+    {
+        ASSERT_NEAR(Pol2->FindLimit(Step(SearchX)), SearchX, SearchX * 1e-5);
+    }
+
+    // the non-uniform grid survives saving and loading
+    ASSERT_TRUE(Pol2->Save(File1DAdaptiveTest));
+    Interpolant* Pol3 = new Interpolant();
+    ASSERT_TRUE(Pol3->Load(File1DAdaptiveTest));
+    EXPECT_FALSE(Pol3->IsUniform());
+
+    for (double SearchX = xmin; SearchX < xmax; SearchX += 0.1)
+    {
+        ASSERT_NEAR(Pol3->Interpolate(SearchX), Pol2->Interpolate(SearchX), Step(SearchX) * 1e-10);
+    }
+
+    delete Pol1;
+    delete Pol2;
+    delete Pol3;
+}
+
+TEST(_1D_Interpol, AdaptiveExtension)
+{
+    Interpolant1DBuilder builder;
+    builder.SetMax(max)
+        .SetXMin(xmin)
+        .SetXMax(xmax)
+        .SetRomberg(romberg)
+        .SetIsLog(true)
+        .SetRombergY(rombergY)
+        .SetLogSubst(true)
+        .SetPrecision(1e-7)
+        .SetFunction1D(X2);
+
+    InterpolantBuilder* extension_builder = builder.CreateExtensionBuilder(xmax, 2 * xmax);
+    ASSERT_NE(extension_builder, nullptr);
+
+    Interpolant* Pol1      = builder.build();
+    Interpolant* extension = extension_builder->build();
+    int nodes              = Pol1->GetMax() + extension->GetMax();
+
+    // the common boundary node is only kept once
+    Pol1->Append(*extension);
+    EXPECT_EQ(Pol1->GetMax(), nodes - 1);
+
+    for (double SearchX = xmin; SearchX < 2 * xmax; SearchX *= 1.1)
+    {
+        double RealValue = X2(SearchX);
+        ASSERT_NEAR(Pol1->Interpolate(SearchX), RealValue, RealValue * 1e-6);
+    }
+
+    delete Pol1;
+    delete extension;
+    delete extension_builder;
+}
+
+TEST(_1D_Interpol, Orders)
+{
+    // the orders 3 to 5 have their own kernels, the others the generic one
+    for (int rational_on = 0; rational_on < 2; rational_on++)
+    {
+        double last_error = 1;
+
+        for (int order = 3; order <= 7; order++)
+        {
+            Interpolant1DBuilder builder;
+            builder.SetMax(max)
+                .SetXMin(xmin)
+                .SetXMax(xmax)
+                .SetRomberg(order)
+                .SetRational(rational_on)
+                .SetRombergY(order)
+                .SetRationalY(rational_on)
+                .SetLogSubst(true)
+                .SetFunction1D(X2);
+
+            Interpolant* Pol1 = builder.build();
+
+            double error = MaxRelativeError(Pol1, X2);
+            EXPECT_LT(error, last_error) << "order " << order << ", rational " << rational_on;
+            last_error = error;
+
+            for (double SearchX = xmin; SearchX < xmax; SearchX += 0.37)
+            {
+                ASSERT_NEAR(Pol1->FindLimit(X2(SearchX)), SearchX, SearchX * 1e-3) << "order " << order << ", rational " << rational_on;
+            }
+
+            delete Pol1;
+        }
+    }
+}
+
 TEST(_2D_Interpol, Simple_Test_of_X_YY_EXPX)
 {
     Interpolant* Pol2 = new Interpolant(max,
@@ -805,6 +983,149 @@ TEST(_2D_Interpol, All_On)
     delete Pol2;
 }
 
+TEST(_2D_Interpol, Extension)
+{
+    Interpolant2DBuilder builder;
+    builder.SetMax1(max)
+        .SetX1Min(xmin)
+        .SetX1Max(xmax)
+        .SetMax2(max2)
+        .SetX2Min(x2min)
+        .SetX2Max(x2max)
+        .SetRomberg1(romberg)
+        .SetIsLog1(true)
+        .SetRomberg2(romberg2)
+        .SetRombergY(rombergY)
+        .SetLogSubst(true)
+        .SetFunction2D(X_YY);
+
+    InterpolantBuilder* extension_builder = builder.CreateExtensionBuilder(xmax, 2 * xmax);
+    ASSERT_NE(extension_builder, nullptr);
+
+    Interpolant* Pol2      = builder.build();
+    Interpolant* extension = extension_builder->build();
+    Pol2->Append(*extension);
+
+    double precision = 1E-5;
+    double SearchY   = 11;
+
+    for (double SearchX = xmin; SearchX < 2 * xmax; SearchX *= 1.1)
+    {
+        double RealValue = X_YY(SearchX, SearchY);
+        ASSERT_NEAR(Pol2->Interpolate(SearchX, SearchY), RealValue, RealValue * precision);
+        ASSERT_NEAR(Pol2->FindLimit(SearchX, RealValue), SearchY, SearchY * precision);
+    }
+
+    delete Pol2;
+    delete extension;
+    delete extension_builder;
+}
+
+TEST(_2D_Interpol, Adaptive)
+{
+    Interpolant2DBuilder builder;
+    builder.SetMax1(max)
+        .SetX1Min(xmin)
+        .SetX1Max(xmax)
+        .SetMax2(max2)
+        .SetX2Min(x2min)
+        .SetX2Max(x2max)
+        .SetRomberg1(romberg)
+        .SetRomberg2(romberg2)
+        .SetRombergY(rombergY)
+        .SetLogSubst(true)
+        .SetPrecision(1e-7)
+        .SetFunction2D(X_YY);
+
+    EXPECT_EQ(builder.CreateExtensionBuilder(xmax, 2 * xmax), nullptr);
+
+    Interpolant* Pol2 = builder.build();
+
+    EXPECT_FALSE(Pol2->IsUniform());
+    EXPECT_LT(Pol2->GetMax(), max2);
+
+    for (double SearchX = xmin; SearchX < xmax; SearchX += 0.7)
+    {
+        for (double SearchY = x2min; SearchY < x2max; SearchY += 0.9)
+        {
+            double RealValue = X_YY(SearchX, SearchY);
+            ASSERT_NEAR(Pol2->Interpolate(SearchX, SearchY), RealValue, RealValue * 1e-6);
+            ASSERT_NEAR(Pol2->FindLimit(SearchX, RealValue), SearchY, SearchY * 1e-5);
+        }
+    }
+
+    delete Pol2;
+}
+
+TEST(_2D_Interpol, Compact)
+{
+    Interpolant2DBuilder builder;
+    builder.SetMax1(max)
+        .SetX1Min(xmin)
+        .SetX1Max(xmax)
+        .SetMax2(max2)
+        .SetX2Min(x2min)
+        .SetX2Max(x2max)
+        .SetRomberg1(romberg)
+        .SetRomberg2(romberg2)
+        .SetRombergY(rombergY)
+        .SetLogSubst(true)
+        .SetFunction2D(X_YY);
+
+    Interpolant* Pol2    = builder.build();
+    Interpolant* Compact = new Interpolant(*Pol2);
+
+    ASSERT_TRUE(Compact->Compact(1e-6));
+    EXPECT_TRUE(Compact->IsCompact());
+    EXPECT_TRUE(Compact->IsSinglePrecision());
+    EXPECT_FALSE(Compact->Compact(1e-6));
+
+    // the rounding of the stored values is amplified by the interpolation
+    for (double SearchX = xmin; SearchX < xmax; SearchX += 0.7)
+    {
+        for (double SearchY = x2min; SearchY < x2max; SearchY += 0.9)
+        {
+            double PolValue = Pol2->Interpolate(SearchX, SearchY);
+            ASSERT_NEAR(Compact->Interpolate(SearchX, SearchY), PolValue, PolValue * 1e-5);
+            ASSERT_NEAR(Compact->FindLimit(SearchX, PolValue), SearchY, SearchY * 1e-5);
+        }
+    }
+
+    // the copy and a saved and loaded table give the same values
+    Interpolant Copy(*Compact);
+    EXPECT_TRUE(Copy == *Compact);
+    ASSERT_TRUE(Compact->Save(File2DTest));
+    Interpolant Loaded;
+    ASSERT_TRUE(Loaded.Load(File2DTest));
+    EXPECT_EQ(Copy.Interpolate(7., 11.), Compact->Interpolate(7., 11.));
+    EXPECT_NEAR(Loaded.Interpolate(7., 11.), Compact->Interpolate(7., 11.), 1e-12 * Compact->Interpolate(7., 11.));
+
+    // scaling keeps the values within the error budget
+    Pol2->Scale(2.);
+    Compact->Scale(2.);
+    EXPECT_NEAR(Compact->Interpolate(7., 11.), Pol2->Interpolate(7., 11.), 1e-5 * Pol2->Interpolate(7., 11.));
+
+    // without a sufficient budget the values stay in double precision
+    Interpolant* Exact = builder.build();
+    ASSERT_TRUE(Exact->Compact(1e-12));
+    EXPECT_FALSE(Exact->IsSinglePrecision());
+    Interpolant* Reference = builder.build();
+    EXPECT_EQ(Exact->Interpolate(7., 11.), Reference->Interpolate(7., 11.));
+    EXPECT_EQ(Exact->FindLimit(7., 200.), Reference->FindLimit(7., 200.));
+
+    // adapted rows do not share their grid
+    builder.SetPrecision(1e-7);
+    Interpolant* Adaptive = builder.build();
+    EXPECT_FALSE(Adaptive->Compact(1e-6));
+    EXPECT_FALSE(Adaptive->IsCompact());
+
+    delete Pol2;
+    delete Compact;
+    delete Exact;
+    delete Reference;
+    delete Adaptive;
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -813,5 +1134,6 @@ int main(int argc, char** argv)
     // Clean the mess
     // std::remove (File1DTest.c_str());
     // std::remove (File2DTest.c_str());
+    // std::remove (File1DAdaptiveTest.c_str());
     return ret;
 }
@@ -481,6 +481,79 @@ TEST(Ionization, Test_of_e_interpol)
     }
 }
 
+TEST(Ionization, Test_of_cut_independent_dNdx)
+{
+    ParticleDef particle_def             = MuMinusDef::Get();
+    std::shared_ptr<const Medium> medium = CreateMedium("ice");
+
+    IonizationFactory::Definition ioniz_def;
+
+    InterpolationDef InterpolDef;
+    InterpolDef.do_cut_independent_dndx = true;
+
+    std::vector<EnergyCutSettings> cuts{EnergyCutSettings(500, 0.05), EnergyCutSettings(10, 0.001),
+                                        EnergyCutSettings(-1, 0.01)};
+
+    for (const auto& ecuts : cuts)
+    {
+        CrossSection* ioniz_integral =
+            IonizationFactory::Get().CreateIonization(particle_def, medium, ecuts, ioniz_def);
+        CrossSection* ioniz_interpol =
+            IonizationFactory::Get().CreateIonization(particle_def, medium, ecuts, ioniz_def, InterpolDef);
+
+        for (double energy = 1e3; energy < 1e12; energy *= 10)
+        {
+            double dNdx = ioniz_integral->CalculatedNdx(energy);
+            EXPECT_NEAR(ioniz_interpol->CalculatedNdx(energy), dNdx, 5e-3 * dNdx);
+
+            // the sampled losses follow the cumulative cross section of the cut
+            for (double rnd : {0.1, 0.5, 0.9})
+            {
+                double loss = ioniz_interpol->CalculateStochasticLoss(energy, 0.5, rnd);
+                double cumulative = ioniz_integral->CalculateCumulativeCrossSection(energy, 0, loss / energy);
+                EXPECT_NEAR(cumulative, rnd * dNdx, 1e-2 * dNdx);
+            }
+        }
+
+        delete ioniz_integral;
+        delete ioniz_interpol;
+    }
+}
+
+TEST(Ionization, Test_of_batch_differential_crosssection)
+{
+    ParticleDef particle_def             = MuMinusDef::Get();
+    std::shared_ptr<const Medium> medium = CreateMedium("ice");
+    EnergyCutSettings ecuts(500, 0.05);
+
+    IonizBetheBlochRossi ioniz(particle_def, medium, ecuts, 1.0);
+    Parametrization& param = ioniz;
+
+    const size_t n = 20;
+    double v[n], out[n];
+
+    for (double energy = 1e3; energy < 1e12; energy *= 10)
+    {
+        Parametrization::IntegralLimits limits = ioniz.GetIntegralLimits(energy);
+        for (size_t i = 0; i < n; ++i)
+        {
+            v[i] = limits.vMin * std::pow(limits.vMax / limits.vMin, (i + 0.5) / n);
+        }
+
+        param.DifferentialCrossSection(energy, v, out, n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            EXPECT_DOUBLE_EQ(out[i], ioniz.DifferentialCrossSection(energy, v[i]));
+        }
+
+        param.FunctionToDEdxIntegral(energy, v, out, n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            EXPECT_DOUBLE_EQ(out[i], ioniz.FunctionToDEdxIntegral(energy, v[i]));
+        }
+    }
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
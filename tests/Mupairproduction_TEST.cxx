@@ -576,6 +576,50 @@ delete mupair;
 }
 }
 
+TEST(Mupairproduction, Test_of_rho_interpol)
+{
+    ParticleDef particle_def = MuMinusDef::Get();
+    std::shared_ptr<const Medium> medium = CreateMedium("StandardRock");
+    EnergyCutSettings ecuts(500, 0.05);
+    InterpolationDef InterpolDef;
+
+    MupairKelnerKokoulinPetrukhin param(particle_def, medium, ecuts, 1.0, true);
+    MupairInterpolant mupair(param, InterpolDef);
+
+    Vector3D direction(0, 0, 1);
+    int seed = 0;
+
+    for (double energy = 1e4; energy < 1e12; energy *= 10)
+    {
+        for (double v = 0.003; v < 0.95; v *= 3)
+        {
+            double rho_max = 1 - 2 * MMU / (v * energy);
+            if (rho_max <= 0)
+            {
+                continue;
+            }
+
+            for (int i = 0; i < 20; ++i, ++seed)
+            {
+                RandomGenerator::Get().SetSeed(seed);
+                double rnd1 = RandomGenerator::Get().RandomDouble();
+                double rnd2 = RandomGenerator::Get().RandomDouble();
+                double rho_direct = param.Calculaterho(energy, v, rnd1, rnd2);
+
+                // same random numbers are drawn for the tabulated rho
+                RandomGenerator::Get().SetSeed(seed);
+                std::pair<std::vector<DynamicData>, bool> products =
+                    mupair.CalculateProducedParticles(energy, v * energy, direction);
+
+                ASSERT_EQ(products.first.size(), 2u);
+                double rho_tab = 2 * products.first[0].GetEnergy() / (v * energy) - 1;
+
+                ASSERT_NEAR(rho_tab, rho_direct, 5e-3 * rho_max);
+            }
+        }
+    }
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
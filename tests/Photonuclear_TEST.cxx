@@ -954,6 +954,47 @@ TEST(PhotoQ2Integration, Test_of_e_Interpolant)
     }
 }
 
+TEST(PhotoQ2Integration, Test_of_batch_Q2_integrand)
+{
+    ParticleDef particle_def             = MuMinusDef::Get();
+    std::shared_ptr<const Medium> medium = CreateMedium("standardrock");
+    EnergyCutSettings ecuts(500, 0.05);
+    ShadowButkevichMikhailov shadow;
+
+    PhotoAbramowiczLevinLevyMaor97 photo(particle_def, medium, ecuts, 1.0, shadow);
+    PhotoQ2Integral& param = photo;
+
+    const size_t n = 20;
+    double Q2[n], out[n];
+
+    for (double energy = 1e3; energy < 1e12; energy *= 10)
+    {
+        Parametrization::IntegralLimits limits = photo.GetIntegralLimits(energy);
+
+        for (double v = limits.vUp; v < limits.vMax; v *= 2)
+        {
+            double q2_min = particle_def.mass * v;
+            q2_min *= q2_min / (1 - v);
+            double q2_max = 2 * medium->GetComponents().front().GetAverageNucleonWeight() * energy * (v - limits.vMin);
+            if (q2_min >= q2_max)
+            {
+                continue;
+            }
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                Q2[i] = q2_min * std::pow(q2_max / q2_min, (i + 0.5) / n);
+            }
+
+            param.FunctionToQ2Integral(energy, v, Q2, out, n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                EXPECT_DOUBLE_EQ(out[i], photo.FunctionToQ2Integral(energy, v, Q2[i]));
+            }
+        }
+    }
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -173,6 +173,86 @@ TEST(Propagation, Test_nan)
     }
 }
 
+TEST(Propagation, RangeCulling)
+{
+    ParticleDef mu_def = MuMinusDef::Get();
+
+    InterpolationDef inter_def;
+    inter_def.path_to_tables = "resources/tables";
+    inter_def.path_to_tables_readonly = "resources/tables";
+
+    for (bool cont_rand : { false, true }) {
+        std::vector<Sector::Definition> sec_defs;
+        for (auto location : { Sector::ParticleLocation::InfrontDetector,
+                 Sector::ParticleLocation::InsideDetector,
+                 Sector::ParticleLocation::BehindDetector }) {
+            Sector::Definition sector_def;
+            sector_def.location = location;
+            sector_def.SetMedium(std::make_shared<const StandardRock>());
+            sector_def.SetGeometry(std::make_shared<const Sphere>(Vector3D(), 1e5, 0));
+            sector_def.cut_settings = EnergyCutSettings(500, 0.05);
+            sector_def.do_continuous_randomization = cont_rand;
+            sec_defs.push_back(sector_def);
+        }
+
+        Propagator prop(mu_def, sec_defs, std::make_shared<const Sphere>(Vector3D(), 100, 0), inter_def);
+        Propagator prop_culling(prop);
+        prop_culling.SetRangeCulling(true);
+        EXPECT_FALSE(prop.GetRangeCulling());
+        EXPECT_TRUE(prop_culling.GetRangeCulling());
+
+        // muons starting 2 km in front of the detector, the culled ones must
+        // never arrive without culling either
+        int ranged_out = 0;
+        int reached = 0;
+        int reached_culling = 0;
+        for (int i = 0; i < 200; ++i) {
+            DynamicData mu(mu_def.particle_type);
+            mu.SetEnergy(std::pow(10, 4 + 3 * (i + 0.5) / 200.));
+            mu.SetPosition(Vector3D(0, 0, -2e5));
+            mu.SetDirection(Vector3D(0, 0, 1));
+
+            RandomGenerator::Get().SetSeed(i);
+            Secondaries secondaries_culling = prop_culling.Propagate(mu);
+            RandomGenerator::Get().SetSeed(i);
+            Secondaries secondaries = prop.Propagate(mu);
+            EXPECT_FALSE(secondaries.IsRangedOut());
+
+            if (secondaries_culling.IsRangedOut()) {
+                ++ranged_out;
+                for (auto position : secondaries.GetPosition()) {
+                    EXPECT_LT(position.GetZ(), -1e4);
+                }
+                EXPECT_LE(secondaries_culling.GetNumberOfParticles(), secondaries.GetNumberOfParticles());
+            } else {
+                EXPECT_EQ(secondaries_culling.GetNumberOfParticles(), secondaries.GetNumberOfParticles());
+            }
+
+            for (auto position : secondaries.GetPosition()) {
+                if (position.GetZ() > -1e4) {
+                    ++reached;
+                    break;
+                }
+            }
+            for (auto position : secondaries_culling.GetPosition()) {
+                if (position.GetZ() > -1e4) {
+                    ++reached_culling;
+                    break;
+                }
+            }
+        }
+
+        // randomized continuous losses can exceed the mean range, so these
+        // sectors are not culled
+        if (cont_rand)
+            EXPECT_EQ(ranged_out, 0);
+        else
+            EXPECT_GT(ranged_out, 0);
+        EXPECT_GT(reached, 0);
+        EXPECT_EQ(reached_culling, reached);
+    }
+}
+
 TEST(Propagation, particle_type)
 {
     std::string filename = "bin/TestFiles/Propagator_propagation.txt";
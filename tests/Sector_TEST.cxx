@@ -367,6 +367,89 @@ TEST(Sector, Propagate)
     }
 }
 
+TEST(Sector, AsyncTableBuild)
+{
+    ParticleDef mu = MuMinusDef::Get();
+    Sector::Definition sector_def;
+    sector_def.cut_settings = EnergyCutSettings(500, 0.05);
+    sector_def.utility_def.brems_def.parametrization = BremsstrahlungFactory::None;
+    sector_def.utility_def.photo_def.parametrization = PhotonuclearFactory::None;
+    sector_def.utility_def.epair_def.parametrization = EpairProductionFactory::None;
+
+    InterpolationDef inter_def;
+    inter_def.path_to_tables = PATH_TO_TABLES;
+    inter_def.path_to_tables_readonly = PATH_TO_TABLES;
+
+    InterpolationDef async_def = inter_def;
+    async_def.do_async_build = true;
+    Sector async_sector(mu, sector_def, async_def);
+
+    // the sector is usable before its tables are ready
+    DynamicData p_condition;
+    p_condition.SetDirection(Vector3D(0, 0, -1));
+    p_condition.SetPosition(Vector3D(0, 0, 0));
+    p_condition.SetEnergy(1e5);
+    Secondaries secondaries = async_sector.Propagate(p_condition, 100, 0);
+    EXPECT_GT(secondaries.GetNumberOfParticles(), 0);
+
+    Sector sector(mu, sector_def, inter_def);
+
+    async_sector.WaitForTables();
+    EXPECT_TRUE(async_sector.TablesReady());
+    for (double energy : {1e3, 1e5, 1e7}) {
+        EXPECT_DOUBLE_EQ(async_sector.EnergyDistance(energy, 100),
+            sector.EnergyDistance(energy, 100));
+        EXPECT_DOUBLE_EQ(async_sector.EnergyInteraction(energy, 0.5),
+            sector.EnergyInteraction(energy, 0.5));
+    }
+
+    Sector sector_copy(async_sector);
+    EXPECT_TRUE(sector_copy.TablesReady());
+}
+
+TEST(Sector, HomogeneousDensity)
+{
+    // the fast path of homogeneous media has to agree with a constant
+    // density, which takes the general path through the distribution
+    ParticleDef mu = MuMinusDef::Get();
+    Sector::Definition sector_def;
+    sector_def.cut_settings = EnergyCutSettings(500, 0.05);
+    sector_def.scattering_model = ScatteringFactory::NoScattering;
+    sector_def.utility_def.brems_def.parametrization = BremsstrahlungFactory::None;
+    sector_def.utility_def.photo_def.parametrization = PhotonuclearFactory::None;
+    sector_def.utility_def.epair_def.parametrization = EpairProductionFactory::None;
+
+    Sector::Definition constant_def = sector_def;
+    sector_def.SetMedium(CreateMedium("ice", 0.9));
+    std::shared_ptr<Medium> medium = CreateMedium("ice", 1.0);
+    Density_polynomial density(CartesianAxis(Vector3D(0, 0, 1), Vector3D()), Polynom({ 0.9 }));
+    medium->SetDensityDistribution(density);
+    constant_def.SetMedium(medium);
+
+    InterpolationDef inter_def;
+    inter_def.path_to_tables = PATH_TO_TABLES;
+    inter_def.path_to_tables_readonly = PATH_TO_TABLES;
+
+    Sector sector(mu, sector_def, inter_def);
+    Sector constant_sector(mu, constant_def, inter_def);
+
+    for (double energy : { 1e3, 1e5, 1e7 }) {
+        DynamicData p_condition;
+        p_condition.SetDirection(Vector3D(0, 0, -1));
+        p_condition.SetPosition(Vector3D(0, 0, 0));
+        p_condition.SetEnergy(energy);
+
+        RandomGenerator::Get().SetSeed(1234);
+        DynamicData final = sector.Propagate(p_condition, 1e5, 0).GetSecondaries().back();
+        RandomGenerator::Get().SetSeed(1234);
+        DynamicData constant_final = constant_sector.Propagate(p_condition, 1e5, 0).GetSecondaries().back();
+
+        EXPECT_NEAR(final.GetEnergy(), constant_final.GetEnergy(), 1e-6 * energy);
+        EXPECT_NEAR(final.GetPropagatedDistance(), constant_final.GetPropagatedDistance(), 1e-3);
+        EXPECT_NEAR(final.GetTime(), constant_final.GetTime(), 1e-6 * final.GetTime());
+    }
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
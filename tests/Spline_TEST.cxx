@@ -1,6 +1,8 @@
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <numeric>
+#include <random>
 
 #include "gtest/gtest.h"
 
@@ -49,6 +51,72 @@ TEST(Cubic_Spline, Comparison_equal) {
     }
 }
 
+TEST(Spline, Lookup) {
+    // nodes with growing distance, like a density profile refined near the
+    // surface, and a uniform grid
+    std::vector<double> x_log(2000);
+    std::vector<double> x_uniform(2000);
+    for (unsigned int i = 0; i < x_log.size(); ++i) {
+        x_log[i] = std::exp(i * 0.01) - 5;
+        x_uniform[i] = -3 + 0.5 * i;
+    }
+
+    for (auto x : {x_log, x_uniform}) {
+        std::vector<double> f_x(x.size());
+        for (unsigned int i = 0; i < x.size(); ++i)
+            f_x[i] = std::sin(0.1 * x[i]) + 0.01 * i;
+
+        Linear_Spline sp(x, f_x);
+        Cubic_Spline cubic_sp(x, f_x);
+
+        std::vector<Polynom> polynoms = sp.GetFunctions();
+        std::mt19937 generator(1234);
+        std::uniform_real_distribution<double> distribution(x.front() - 10, x.back() + 10);
+
+        std::vector<double> positions(10000);
+        for (auto& position : positions)
+            position = distribution(generator);
+        positions.insert(positions.end(), x.begin(), x.end());
+
+        for (auto position : positions) {
+            // the first subintervall whose upper node is not below position
+            unsigned int i = 0;
+            while (i + 1 < polynoms.size() && x[i + 1] < position)
+                ++i;
+            ASSERT_EQ(sp.evaluate(position), polynoms[i].evaluate(position));
+        }
+
+        std::sort(positions.begin(), positions.end());
+        std::vector<double> result(positions.size());
+        cubic_sp.BatchEvaluate(positions.data(), result.data(), positions.size());
+        for (unsigned int k = 0; k < positions.size(); ++k)
+            ASSERT_EQ(result[k], cubic_sp.evaluate(positions[k]));
+
+        Linear_Spline copy(sp);
+        Linear_Spline from_polynoms(polynoms, x);
+        for (unsigned int k = 0; k < positions.size(); k += 7) {
+            ASSERT_EQ(copy.evaluate(positions[k]), sp.evaluate(positions[k]));
+            ASSERT_EQ(from_polynoms.evaluate(positions[k]), sp.evaluate(positions[k]));
+        }
+    }
+}
+
+TEST(Spline, Derivative) {
+    std::vector<double> x(10);
+    std::vector<double> f_x(10);
+    std::iota(std::begin(x), std::end(x), 0);
+
+    for (unsigned int i = 0; i < x.size(); ++i) {
+        f_x[i] = cubic(x[i]);
+    }
+
+    Linear_Spline sp(x, f_x);
+    sp.Derivative();
+    for (unsigned int i = 0; i + 1 < x.size(); ++i) {
+        ASSERT_NEAR(sp.evaluate(x[i] + 0.5), f_x[i + 1] - f_x[i], COMPUTER_PRECISION * f_x[i + 1]);
+    }
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
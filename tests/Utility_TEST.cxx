@@ -1,8 +1,11 @@
 
 #include "gtest/gtest.h"
 
+#include "PROPOSAL/crossection/CrossSection.h"
 #include "PROPOSAL/medium/Medium.h"
 #include "PROPOSAL/propagation_utility/PropagationUtility.h"
+#include "PROPOSAL/propagation_utility/PropagationUtilityIntegral.h"
+#include "PROPOSAL/propagation_utility/PropagationUtilityInterpolant.h"
 
 using namespace PROPOSAL;
 
@@ -68,6 +71,146 @@ TEST(Copyconstructor, Copyconstructor2) {
     EXPECT_TRUE(C == D);
 }
 
+TEST(Multiplier, Common_multiplier_rescales_tables) {
+    ParticleDef pDef(MuMinusDef::Get());
+    auto ice = std::make_shared<Ice>();
+    EnergyCutSettings ecuts(500, 0.05);
+    InterpolationDef interpolation_def;
+
+    Utility::Definition scaled_defs;
+    scaled_defs.brems_def.multiplier = 2;
+    scaled_defs.photo_def.multiplier = 2;
+    scaled_defs.epair_def.multiplier = 2;
+    scaled_defs.ioniz_def.multiplier = 2;
+    scaled_defs.mupair_def.multiplier = 2;
+    scaled_defs.weak_def.multiplier = 2;
+
+    Utility nominal(pDef, ice, ecuts, Utility::Definition(), interpolation_def);
+    Utility scaled(pDef, ice, ecuts, scaled_defs, interpolation_def);
+    Utility scaled_integral(pDef, ice, ecuts, scaled_defs);
+
+    UtilityInterpolantDisplacement nominal_disp(nominal, interpolation_def);
+    UtilityInterpolantDisplacement scaled_disp(scaled, interpolation_def);
+    UtilityIntegralDisplacement scaled_disp_integral(scaled_integral);
+
+    UtilityInterpolantInteraction nominal_int(nominal, interpolation_def);
+    UtilityInterpolantInteraction scaled_int(scaled, interpolation_def);
+
+    for (double energy = 1e4; energy < 1e12; energy *= 10) {
+        double ef = energy / 2;
+
+        double displacement = scaled_disp_integral.Calculate(energy, ef, 0);
+        EXPECT_NEAR(scaled_disp.Calculate(energy, ef, 0), displacement, 1e-3 * displacement);
+        EXPECT_NEAR(scaled_disp.Calculate(energy, ef, 0), nominal_disp.Calculate(energy, ef, 0) / 2,
+                    1e-10 * displacement);
+
+        // the interaction integral does not change with a common multiplier
+        double interaction = nominal_int.Calculate(energy, ef, 0);
+        EXPECT_NEAR(scaled_int.Calculate(energy, ef, 0), interaction, 1e-10 * interaction);
+    }
+}
+
+TEST(Extension, Extended_tables_cover_high_energies) {
+    ParticleDef pDef(MuMinusDef::Get());
+    auto ice = std::make_shared<Ice>();
+    EnergyCutSettings ecuts(-1, 0.05);
+
+    InterpolationDef interpolation_def;
+    interpolation_def.max_node_energy = 1e8;
+    interpolation_def.extended_max_node_energy = 1e12;
+
+    Utility utility(pDef, ice, ecuts, Utility::Definition(), interpolation_def);
+    Utility utility_integral(pDef, ice, ecuts, Utility::Definition());
+
+    UtilityInterpolantDisplacement disp(utility, interpolation_def);
+    UtilityIntegralDisplacement disp_integral(utility_integral);
+
+    UtilityInterpolantInteraction interaction(utility, interpolation_def);
+    UtilityIntegralInteraction interaction_integral(utility_integral);
+
+    for (double energy = 1e4; energy < 1e12; energy *= 10) {
+        double ef = energy / 2;
+
+        double displacement = disp_integral.Calculate(energy, ef, 0);
+        EXPECT_NEAR(disp.Calculate(energy, ef, 0), displacement, 1e-3 * displacement);
+
+        // the interpolant returns the integral down to the lowest energy
+        double interaction_value = std::abs(interaction_integral.Calculate(energy, ef, 0));
+        EXPECT_NEAR(std::abs(interaction.Calculate(energy, ef, 0) - interaction.Calculate(ef, ef, 0)),
+                    interaction_value, 1e-3 * interaction_value);
+    }
+}
+
+TEST(IntegralCache, Lru_eviction_and_tolerance) {
+    EnergyCache<double> cache(2, 1e-3);
+
+    cache.Insert(1e3, 1.);
+    cache.Insert(2e3, 2.);
+    ASSERT_NE(cache.Find(1e3), nullptr);
+
+    // 2e3 is the least recently used entry and gets dropped
+    cache.Insert(3e3, 3.);
+    EXPECT_EQ(cache.GetSize(), 2u);
+    EXPECT_EQ(cache.Find(2e3), nullptr);
+    EXPECT_EQ(*cache.Find(3e3), 3.);
+
+    EXPECT_EQ(*cache.Find(1e3 * (1 + 5e-4)), 1.);
+    EXPECT_EQ(cache.Find(1e3 * (1 + 2e-3)), nullptr);
+
+    EnergyCache<double> disabled;
+    disabled.Insert(1e3, 1.);
+    EXPECT_EQ(disabled.Find(1e3), nullptr);
+}
+
+TEST(IntegralCache, Cached_integrals_are_unchanged) {
+    ParticleDef pDef(MuMinusDef::Get());
+    auto ice = std::make_shared<Ice>();
+    EnergyCutSettings ecuts(500, 0.05);
+
+    Utility::Definition cached_defs;
+    cached_defs.integral_cache_size = 100;
+
+    Utility utility(pDef, ice, ecuts, Utility::Definition());
+    Utility utility_cached(pDef, ice, ecuts, cached_defs);
+
+    UtilityIntegralDisplacement disp(utility);
+    UtilityIntegralDisplacement disp_cached(utility_cached);
+    UtilityIntegralInteraction interaction(utility);
+    UtilityIntegralInteraction interaction_cached(utility_cached);
+
+    // every energy is used twice, the second time from the cache
+    for (int i = 0; i < 2; ++i) {
+        for (double energy = 1e4; energy < 1e10; energy *= 100) {
+            double displacement = disp.Calculate(energy, pDef.low, 0);
+            EXPECT_EQ(disp_cached.Calculate(energy, pDef.low, 0), displacement);
+
+            double rate = interaction.Calculate(energy, pDef.low, 0);
+            EXPECT_EQ(interaction_cached.Calculate(energy, pDef.low, 0), rate);
+        }
+    }
+
+    for (unsigned int i = 0; i < utility.GetCrosssections().size(); ++i) {
+        CrossSection* crosssection = utility.GetCrosssections()[i];
+        CrossSection* crosssection_cached = utility_cached.GetCrosssections()[i];
+
+        for (int j = 0; j < 2; ++j) {
+            EXPECT_EQ(crosssection_cached->CalculatedEdx(1e5), crosssection->CalculatedEdx(1e5));
+            EXPECT_EQ(crosssection_cached->CalculatedNdx(1e5), crosssection->CalculatedNdx(1e5));
+            double rnd1 = 0.3 + 0.2 * j;
+            EXPECT_EQ(crosssection_cached->CalculateStochasticLoss(1e5, rnd1, 0.7),
+                      crosssection->CalculateStochasticLoss(1e5, rnd1, 0.7));
+        }
+    }
+}
+
+TEST(IntegralCache, Negative_size_is_rejected) {
+    nlohmann::json config = {{"photo_shadow", "ShadowDuttaRenoSarcevicSeckel"}, {"integral_cache_size", -1}};
+    EXPECT_EXIT(Utility::Definition{config}, ::testing::ExitedWithCode(1), "");
+
+    config["integral_cache_size"] = 100;
+    EXPECT_EQ(Utility::Definition(config).integral_cache_size, 100u);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();